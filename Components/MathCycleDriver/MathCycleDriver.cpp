@@ -0,0 +1,165 @@
+// ======================================================================
+// \title  MathCycleDriver.cpp
+// \brief  cpp file for MathCycleDriver component implementation class
+// ======================================================================
+
+
+#include <Components/MathCycleDriver/MathCycleDriver.hpp>
+#include <FpConfig.hpp>
+#include <Os/RawTime.hpp>
+#include <cerrno>
+
+namespace MathModule {
+
+  // ----------------------------------------------------------------------
+  // Construction, initialization, and destruction
+  // ----------------------------------------------------------------------
+
+  MathCycleDriver ::
+    MathCycleDriver(
+        const char *const compName
+    ) : MathCycleDriverComponentBase(compName),
+        m_stopRequested(false),
+        m_periodUs(0),
+        m_ticks(0),
+        m_slips(0)
+  {
+
+  }
+
+  MathCycleDriver ::
+    ~MathCycleDriver()
+  {
+
+  }
+
+  void MathCycleDriver ::
+    run(U32 periodUs)
+  {
+    // A period that does not divide the base cycle would make it drift off 1 Hz
+    FW_ASSERT((periodUs > 0) && ((BASE_CYCLE_US % periodUs) == 0), periodUs);
+    // The base cycle fires on the first tick and then once per BASE_CYCLE_US, counting skipped ticks
+    const U64 ticksPerCycle = BASE_CYCLE_US / periodUs;
+    this->m_lock.lock();
+    this->m_periodUs = periodUs;
+    this->m_lock.unLock();
+    this->log_ACTIVITY_HI_CYCLE_STARTED(periodUs, static_cast<U32>(ticksPerCycle));
+
+    struct timespec deadline;
+    (void) clock_gettime(CLOCK_MONOTONIC, &deadline);
+    U64 tick = 0;
+    while (!this->m_stopRequested.load()) {
+        this->sleepUntil(deadline);
+        if (this->m_stopRequested.load()) {
+            break;
+        }
+        struct timespec now;
+        (void) clock_gettime(CLOCK_MONOTONIC, &now);
+        const U64 lateUs = diffUs(deadline, now);
+        // Deadlines that passed while this one was late are skipped, not delivered back to back
+        const U64 missed = lateUs / periodUs;
+
+        this->m_lock.lock();
+        this->m_ticks++;
+        this->m_slips += static_cast<U32>(missed);
+        this->m_jitter.record(static_cast<U32>(FW_MIN(lateUs, static_cast<U64>(0xFFFFFFFF))));
+        this->m_lock.unLock();
+
+        const U64 next = tick + 1 + missed;
+        const bool base = (tick == 0) || (((next - 1) / ticksPerCycle) != ((tick - 1) / ticksPerCycle));
+        tick = next;
+        addUs(deadline, (missed + 1) * periodUs);
+
+        Os::RawTime cycleStart;
+        (void) cycleStart.now();
+        if (this->isConnected_fastCycleOut_OutputPort(0)) {
+            this->fastCycleOut_out(0, cycleStart);
+        }
+        if (base && this->isConnected_CycleOut_OutputPort(0)) {
+            this->CycleOut_out(0, cycleStart);
+        }
+    }
+  }
+
+  void MathCycleDriver ::
+    stop()
+  {
+    this->m_stopRequested = true;
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for user-defined typed input ports
+  // ----------------------------------------------------------------------
+
+  void MathCycleDriver ::
+    schedIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        NATIVE_UINT_TYPE context
+    )
+  {
+    this->m_lock.lock();
+    const U32 periodUs = this->m_periodUs;
+    const U32 ticks = this->m_ticks;
+    const U32 slips = this->m_slips;
+    const LatencySummary jitter(
+        this->m_jitter.getCount(), this->m_jitter.percentile(50),
+        this->m_jitter.percentile(99), this->m_jitter.getMax()
+    );
+    this->m_jitter.reset();
+    this->m_lock.unLock();
+
+    this->tlmWrite_CYCLE_PERIOD_US(periodUs);
+    this->tlmWrite_CYCLE_TICKS(ticks);
+    this->tlmWrite_CYCLE_SLIPS(slips);
+    this->tlmWrite_CYCLE_JITTER(jitter);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  void MathCycleDriver ::
+    sleepUntil(const struct timespec& deadline)
+  {
+#if defined(TIMER_ABSTIME)
+    // A signal, such as the one that stops the cycle, interrupts the sleep
+    while ((clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR) &&
+           !this->m_stopRequested.load()) {
+    }
+#else
+    // Without an absolute sleep (macOS) sleep for what remains; the deadlines stay absolute
+    struct timespec now;
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+    const U64 remainingUs = diffUs(now, deadline);
+    if (remainingUs > 0) {
+        struct timespec remaining;
+        remaining.tv_sec = static_cast<time_t>(remainingUs / 1000000U);
+        remaining.tv_nsec = static_cast<long>((remainingUs % 1000000U) * 1000U);
+        (void) nanosleep(&remaining, nullptr);
+    }
+#endif
+  }
+
+  void MathCycleDriver ::
+    addUs(
+        struct timespec& time,
+        U64 us
+    )
+  {
+    const U64 nsec = static_cast<U64>(time.tv_nsec) + (us % 1000000U) * 1000U;
+    time.tv_sec += static_cast<time_t>(us / 1000000U + nsec / 1000000000U);
+    time.tv_nsec = static_cast<long>(nsec % 1000000000U);
+  }
+
+  U64 MathCycleDriver ::
+    diffUs(
+        const struct timespec& start,
+        const struct timespec& end
+    )
+  {
+    const I64 ns = (static_cast<I64>(end.tv_sec) - static_cast<I64>(start.tv_sec)) * 1000000000LL +
+                   (static_cast<I64>(end.tv_nsec) - static_cast<I64>(start.tv_nsec));
+    return (ns > 0) ? static_cast<U64>(ns / 1000) : 0;
+  }
+
+} // end namespace MathModule
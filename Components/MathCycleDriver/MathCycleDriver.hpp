@@ -0,0 +1,126 @@
+// ======================================================================
+// \title  MathCycleDriver.hpp
+// \brief  hpp file for MathCycleDriver component implementation class
+// ======================================================================
+
+#ifndef MathCycleDriver_HPP
+#define MathCycleDriver_HPP
+
+#include "Components/MathCycleDriver/MathCycleDriverComponentAc.hpp"
+#include <Components/MathUtils/LatencyHistogram.hpp>
+#include <Os/Mutex.hpp>
+#include <atomic>
+#include <time.h>
+
+namespace MathModule {
+
+  class MathCycleDriver :
+    public MathCycleDriverComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction, initialization, and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object MathCycleDriver
+      //!
+      MathCycleDriver(
+          const char *const compName /*!< The component name*/
+      );
+
+      //! Destroy object MathCycleDriver
+      //!
+      ~MathCycleDriver();
+
+      //! Deliver ticks on the calling thread until stop is called
+      //!
+      //! Tick n is due n periods after the first, so the time spent on one
+      //! tick does not push the later ones back. A tick whose deadline has
+      //! passed by a whole period is skipped and counted as a slip. Returns
+      //! at once if stop has already been called. The period must divide one
+      //! second, so that a whole number of ticks makes up the base cycle.
+      void run(
+          U32 periodUs /*!< The tick period, in microseconds*/
+      );
+
+      //! Make run return; safe to call from a signal handler
+      void stop();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      enum {
+        //! Period of the base cycle, in microseconds
+        BASE_CYCLE_US = 1000000
+      };
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for user-defined typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for schedIn
+      //!
+      void schedIn_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          NATIVE_UINT_TYPE context /*!< The call order*/
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Sleep until an absolute time of the monotonic clock, or until stop is called
+      void sleepUntil(
+          const struct timespec& deadline /*!< When to wake*/
+      );
+
+      //! Add microseconds to a time
+      static void addUs(
+          struct timespec& time, /*!< The time to move*/
+          U64 us /*!< The microseconds to add*/
+      );
+
+      //! Microseconds from one time to a later one, or 0 if it is not later
+      static U64 diffUs(
+          const struct timespec& start, /*!< The earlier time*/
+          const struct timespec& end /*!< The later time*/
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! Set by stop to end run
+      std::atomic<bool> m_stopRequested;
+
+      //! Guards the members below; never held across a port call
+      Os::Mutex m_lock;
+
+      //! The tick period, in microseconds
+      U32 m_periodUs;
+
+      //! Ticks delivered
+      U32 m_ticks;
+
+      //! Ticks skipped
+      U32 m_slips;
+
+      //! Wake-up lateness since the last schedIn call
+      LatencyHistogram m_jitter;
+
+    };
+
+} // end namespace MathModule
+
+#endif
@@ -0,0 +1,32 @@
+// ----------------------------------------------------------------------
+// TestMain.cpp
+// ----------------------------------------------------------------------
+
+#include "MathCycleDriverTester.hpp"
+#include "STest/Random/Random.hpp"
+
+TEST(Nominal, Ticks) {
+    MathModule::MathCycleDriverTester tester;
+    tester.testTicks();
+}
+
+TEST(Nominal, Slips) {
+    MathModule::MathCycleDriverTester tester;
+    tester.testSlips();
+}
+
+TEST(Nominal, BaseCycle) {
+    MathModule::MathCycleDriverTester tester;
+    tester.testBaseCycle();
+}
+
+TEST(Nominal, StopFirst) {
+    MathModule::MathCycleDriverTester tester;
+    tester.testStopFirst();
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    STest::Random::seed();
+    return RUN_ALL_TESTS();
+}
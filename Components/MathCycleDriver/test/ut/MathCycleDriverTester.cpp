@@ -0,0 +1,127 @@
+// ======================================================================
+// \title  MathCycleDriver.hpp
+// \brief  cpp file for MathCycleDriver test harness implementation class
+// ======================================================================
+
+#include "MathCycleDriverTester.hpp"
+#include "STest/Pick/Pick.hpp"
+#include <Os/Task.hpp>
+
+namespace MathModule {
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  MathCycleDriverTester ::
+    MathCycleDriverTester() :
+      MathCycleDriverGTestBase("Tester", MathCycleDriverTester::MAX_HISTORY_SIZE),
+      component("MathCycleDriver"),
+      m_stopAfter(0),
+      m_stallTick(0),
+      m_stallUs(0)
+  {
+    this->initComponents();
+    this->connectPorts();
+  }
+
+  MathCycleDriverTester ::
+    ~MathCycleDriverTester()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void MathCycleDriverTester ::
+    testTicks()
+  {
+    // Twenty ticks a millisecond apart; the base cycle fires on the first
+    this->m_stopAfter = 20;
+    this->component.run(1000);
+    ASSERT_from_fastCycleOut_SIZE(20);
+    ASSERT_from_CycleOut_SIZE(1);
+    ASSERT_EVENTS_CYCLE_STARTED_SIZE(1);
+    ASSERT_EVENTS_CYCLE_STARTED(0, 1000, 1000);
+
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_CYCLE_PERIOD_US(0, 1000);
+    ASSERT_TLM_CYCLE_TICKS(0, 20);
+    ASSERT_TLM_CYCLE_JITTER_SIZE(1);
+    ASSERT_EQ(this->tlmHistory_CYCLE_JITTER->at(0).arg.getcount(), 20U);
+
+    // Jitter covers one schedIn period at a time
+    this->clearHistory();
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_CYCLE_TICKS(0, 20);
+    ASSERT_TLM_CYCLE_JITTER(0, LatencySummary(0, 0, 0, 0));
+  }
+
+  void MathCycleDriverTester ::
+    testSlips()
+  {
+    // A tick that takes three and a half periods pushes the next one past two deadlines
+    this->m_stopAfter = 10;
+    this->m_stallTick = 5;
+    this->m_stallUs = 3500;
+    this->component.run(1000);
+    ASSERT_from_fastCycleOut_SIZE(10);
+
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_CYCLE_TICKS(0, 10);
+    ASSERT_TLM_CYCLE_SLIPS_SIZE(1);
+    ASSERT_GE(this->tlmHistory_CYCLE_SLIPS->at(0).arg, 2U);
+    ASSERT_GE(this->tlmHistory_CYCLE_JITTER->at(0).arg.getmax(), 2500U);
+  }
+
+  void MathCycleDriverTester ::
+    testBaseCycle()
+  {
+    // Four quarter-second ticks make up the base cycle, so the fifth tick starts the next one
+    this->m_stopAfter = 5;
+    this->component.run(250000);
+    ASSERT_from_fastCycleOut_SIZE(5);
+    ASSERT_from_CycleOut_SIZE(2);
+    ASSERT_EVENTS_CYCLE_STARTED(0, 250000, 4);
+  }
+
+  void MathCycleDriverTester ::
+    testStopFirst()
+  {
+    this->component.stop();
+    this->component.run(1000);
+    ASSERT_from_fastCycleOut_SIZE(0);
+    ASSERT_from_CycleOut_SIZE(0);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  void MathCycleDriverTester ::
+    from_CycleOut_handler(
+        const NATIVE_INT_TYPE portNum,
+        Os::RawTime& cycleStart
+    )
+  {
+    this->pushFromPortEntry_CycleOut(cycleStart);
+  }
+
+  void MathCycleDriverTester ::
+    from_fastCycleOut_handler(
+        const NATIVE_INT_TYPE portNum,
+        Os::RawTime& cycleStart
+    )
+  {
+    this->pushFromPortEntry_fastCycleOut(cycleStart);
+    const U32 ticks = this->fromPortHistory_fastCycleOut->size();
+    if (ticks == this->m_stallTick) {
+        (void) Os::Task::delay(Fw::TimeInterval(0, this->m_stallUs));
+    }
+    if (ticks >= this->m_stopAfter) {
+        this->component.stop();
+    }
+  }
+
+} // end namespace MathModule
@@ -0,0 +1,107 @@
+// ======================================================================
+// \title  MathCycleDriver/test/ut/Tester.hpp
+// \brief  hpp file for MathCycleDriver test harness implementation class
+// ======================================================================
+
+#ifndef TESTER_HPP
+#define TESTER_HPP
+
+#include "MathCycleDriverGTestBase.hpp"
+#include "Components/MathCycleDriver/MathCycleDriver.hpp"
+
+namespace MathModule {
+
+  class MathCycleDriverTester :
+    public MathCycleDriverGTestBase
+  {
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+    public:
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const NATIVE_INT_TYPE MAX_HISTORY_SIZE = 32;
+      // Instance ID supplied to the component instance under test
+      static const NATIVE_INT_TYPE TEST_INSTANCE_ID = 0;
+
+      //! Construct object MathCycleDriverTester
+      //!
+      MathCycleDriverTester();
+
+      //! Destroy object MathCycleDriverTester
+      //!
+      ~MathCycleDriverTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      void testTicks();
+
+      void testSlips();
+
+      void testBaseCycle();
+
+      void testStopFirst();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Handlers for typed from ports
+      // ----------------------------------------------------------------------
+
+      //! Handler for from_CycleOut
+      //!
+      void from_CycleOut_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          Os::RawTime& cycleStart /*!< Cycle start timestamp*/
+      );
+
+      //! Handler for from_fastCycleOut
+      //! Stops the driver after m_stopAfter ticks, and stalls tick m_stallTick
+      void from_fastCycleOut_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          Os::RawTime& cycleStart /*!< Cycle start timestamp*/
+      );
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper methods
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      //!
+      void connectPorts();
+
+      //! Initialize components
+      //!
+      void initComponents();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      //!
+      MathCycleDriver component;
+
+      //! Ticks after which the driver is stopped
+      U32 m_stopAfter;
+
+      //! Tick that takes m_stallUs to handle, counting from 1, or 0 for none
+      U32 m_stallTick;
+
+      //! Microseconds tick m_stallTick takes
+      U32 m_stallUs;
+
+  };
+
+} // end namespace MathModule
+
+#endif
@@ -0,0 +1,383 @@
+// ======================================================================
+// \title  MathLoadGen.cpp
+// \brief  cpp file for MathLoadGen component implementation class
+// ======================================================================
+
+
+#include <Components/MathLoadGen/MathLoadGen.hpp>
+#include <FpConfig.hpp>
+#include <Os/Task.hpp>
+
+namespace MathModule {
+
+  // ----------------------------------------------------------------------
+  // Construction, initialization, and destruction
+  // ----------------------------------------------------------------------
+
+  MathLoadGen ::
+    MathLoadGen(
+        const char *const compName
+    ) : MathLoadGenComponentBase(compName),
+        m_state(IDLE),
+        m_epoch(0),
+        m_rate(1),
+        m_burst(1),
+        m_mix(LoadOpMix::UNIFORM),
+        m_operands(LoadOperands::UNIFORM),
+        m_seed(0),
+        m_random(1),
+        m_durationUs(0),
+        m_bursts(0),
+        m_sent(0),
+        m_lost(0),
+        m_skipped(0),
+        m_lastSent(0),
+        m_lastCompleted(0),
+        m_tracker(LOAD_ID_TAG, LOAD_ID_MASK),
+        m_completed(0)
+  {
+
+  }
+
+  MathLoadGen ::
+    ~MathLoadGen()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for user-defined typed input ports
+  // ----------------------------------------------------------------------
+
+  void MathLoadGen ::
+    mathResultIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        F32 result
+    )
+  {
+    if (this->m_tracker.owns(requestId)) {
+        const Fw::Time now = this->getTime();
+        U32 latencyUs = 0;
+        this->m_lock.lock();
+        if (this->m_tracker.complete(requestId, now, latencyUs)) {
+            // A NaN result answers a request the receiver dropped, so it is lost without waiting for the timeout
+            if (result == result) {
+                this->m_completed++;
+                this->m_latency.record(latencyUs);
+            } else {
+                this->m_lost++;
+            }
+        }
+        this->m_lock.unLock();
+        // Late results of generated requests stop here too, so the client never sees them
+        return;
+    }
+    if (this->isConnected_clientResultOut_OutputPort(0)) {
+        this->clientResultOut_out(0, requestId, result);
+    }
+  }
+
+  void MathLoadGen ::
+    schedIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        NATIVE_UINT_TYPE context
+    )
+  {
+    this->publishTelemetry(this->getTime());
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for internal ports
+  // ----------------------------------------------------------------------
+
+  void MathLoadGen ::
+    generate_internalInterfaceHandler(U32 epoch)
+  {
+    // Messages posted by an earlier load are still queued after a stop
+    if ((epoch != this->m_epoch) || (this->m_state == IDLE)) {
+        return;
+    }
+    const Fw::Time now = this->getTime();
+    const U64 elapsed = offsetUs(this->m_startTime, now);
+    this->m_lock.lock();
+    this->m_lost += this->m_tracker.expire(now, LOST_TIMEOUT_US);
+    const U32 outstanding = this->m_tracker.getOutstanding();
+    this->m_lock.unLock();
+
+    if ((this->m_state == RUNNING) && (this->m_durationUs > 0) && (elapsed >= this->m_durationUs)) {
+        this->m_state = DRAINING;
+    }
+    if (this->m_state == DRAINING) {
+        if (outstanding == 0) {
+            this->finishLoad();
+            return;
+        }
+        (void) Os::Task::delay(Fw::TimeInterval(0, POLL_US));
+    } else {
+        const U64 burstUs = static_cast<U64>(this->m_burst) * 1000000U;
+        const U64 due = (this->m_bursts * burstUs) / this->m_rate;
+        if (elapsed >= due) {
+            if ((elapsed - due) > MAX_LAG_US) {
+                // Move the schedule up rather than flood the receivers to catch up
+                this->m_bursts = (elapsed * this->m_rate) / burstUs;
+            }
+            this->sendBurst(now);
+            this->m_bursts++;
+        } else {
+            // Sleep in slices so commands and schedIn wait at most one slice
+            const U64 wait = FW_MIN(due - elapsed, static_cast<U64>(SLEEP_SLICE_US));
+            (void) Os::Task::delay(Fw::TimeInterval(0, static_cast<U32>(wait)));
+        }
+    }
+    this->generate_internalInterfaceInvoke(this->m_epoch);
+  }
+
+  // ----------------------------------------------------------------------
+  // Command handler implementations
+  // ----------------------------------------------------------------------
+
+  void MathLoadGen ::
+    LOAD_START_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq,
+        U32 durationS
+    )
+  {
+    if (this->m_state != IDLE) {
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::BUSY);
+        return;
+    }
+    this->loadSettings();
+
+    const Fw::Time now = this->getTime();
+    this->m_lock.lock();
+    this->m_tracker.reset();
+    this->m_completed = 0;
+    this->m_latency.reset();
+    this->m_lock.unLock();
+    this->m_sent = 0;
+    this->m_lost = 0;
+    this->m_skipped = 0;
+    this->m_bursts = 0;
+    this->m_startTime = now;
+    this->m_lastTick = now;
+    this->m_lastSent = 0;
+    this->m_lastCompleted = 0;
+    this->m_durationUs = static_cast<U64>(durationS) * 1000000U;
+
+    this->m_epoch++;
+    this->m_state = RUNNING;
+    this->log_ACTIVITY_HI_LOAD_STARTED(this->m_rate, this->m_burst, this->m_mix, this->m_operands, this->m_seed);
+    this->generate_internalInterfaceInvoke(this->m_epoch);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  void MathLoadGen ::
+    LOAD_STOP_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq
+    )
+  {
+    if (this->m_state == IDLE) {
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+    this->finishLoad();
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  void MathLoadGen ::
+    loadSettings()
+  {
+    Fw::ParamValid valid;
+    const U32 rate = this->paramGet_LOAD_RATE(valid);
+    FW_ASSERT(
+        valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT,
+        valid.e
+    );
+    const U32 burst = this->paramGet_LOAD_BURST(valid);
+    FW_ASSERT(
+        valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT,
+        valid.e
+    );
+    this->m_mix = this->paramGet_LOAD_OP_MIX(valid);
+    FW_ASSERT(
+        valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT,
+        valid.e
+    );
+    this->m_operands = this->paramGet_LOAD_OPERANDS(valid);
+    FW_ASSERT(
+        valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT,
+        valid.e
+    );
+    this->m_seed = this->paramGet_LOAD_SEED(valid);
+    FW_ASSERT(
+        valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT,
+        valid.e
+    );
+
+    this->m_rate = FW_MAX(static_cast<U32>(1), FW_MIN(rate, static_cast<U32>(MAX_RATE)));
+    this->m_burst = FW_MAX(static_cast<U32>(1), FW_MIN(burst, static_cast<U32>(RequestTracker::CAPACITY)));
+    // Spread the seed over the word; xorshift never leaves zero
+    this->m_random = this->m_seed * 0x9E3779B1U;
+    if (this->m_random == 0) {
+        this->m_random = 1;
+    }
+  }
+
+  void MathLoadGen ::
+    sendBurst(const Fw::Time& now)
+  {
+    for (U32 i = 0; i < this->m_burst; i++) {
+        const MathOp op = this->pickOp();
+        F32 val1 = 0.0f;
+        F32 val2 = 0.0f;
+        this->pickOperands(val1, val2);
+
+        this->m_lock.lock();
+        const bool full = this->m_tracker.isFull();
+        const U32 requestId = full ? 0 : this->m_tracker.claim(now);
+        this->m_lock.unLock();
+        if (full) {
+            this->m_skipped++;
+            continue;
+        }
+        this->m_sent++;
+        // The result may come back before this call returns
+        this->mathOpOut_out(0, requestId, val1, op, val2);
+    }
+  }
+
+  U32 MathLoadGen ::
+    nextRandom()
+  {
+    U32 x = this->m_random;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    this->m_random = x;
+    return x;
+  }
+
+  MathOp MathLoadGen ::
+    pickOp()
+  {
+    switch (this->m_mix.e) {
+        case LoadOpMix::UNIFORM:
+            return static_cast<MathOp::T>(this->nextRandom() % MathOp::NUM_CONSTANTS);
+        case LoadOpMix::ADD_ONLY:
+            return MathOp::ADD;
+        case LoadOpMix::DIV_ONLY:
+            return MathOp::DIV;
+        case LoadOpMix::ADD_HEAVY: {
+            const U32 r = this->nextRandom();
+            if ((r & 7) != 0) {
+                return MathOp::ADD;
+            }
+            return static_cast<MathOp::T>(MathOp::SUB + ((r >> 3) % 3));
+        }
+        default:
+            FW_ASSERT(0, this->m_mix.e);
+            return MathOp::ADD;
+    }
+  }
+
+  void MathLoadGen ::
+    pickOperands(
+        F32& val1,
+        F32& val2
+    )
+  {
+    // 24 random bits scaled onto [-1000, 1000) are exact in an F32
+    const F32 scale = 2000.0f / 16777216.0f;
+    switch (this->m_operands.e) {
+        case LoadOperands::CONSTANT:
+            val1 = 3.0f;
+            val2 = 2.0f;
+            break;
+        case LoadOperands::UNIFORM:
+            val1 = static_cast<F32>(this->nextRandom() >> 8) * scale - 1000.0f;
+            val2 = static_cast<F32>(this->nextRandom() >> 8) * scale - 1000.0f;
+            break;
+        case LoadOperands::SMALL_INTEGERS:
+            val1 = static_cast<F32>(1 + (this->nextRandom() % 16));
+            val2 = static_cast<F32>(1 + (this->nextRandom() % 16));
+            break;
+        case LoadOperands::WITH_ZEROS:
+            val1 = static_cast<F32>(this->nextRandom() >> 8) * scale - 1000.0f;
+            val2 = static_cast<F32>(this->nextRandom() >> 8) * scale - 1000.0f;
+            if ((this->nextRandom() & 7) == 0) {
+                val2 = 0.0f;
+            }
+            break;
+        default:
+            FW_ASSERT(0, this->m_operands.e);
+            break;
+    }
+  }
+
+  void MathLoadGen ::
+    finishLoad()
+  {
+    FW_ASSERT(this->m_state != IDLE, this->m_state);
+    this->m_state = IDLE;
+
+    // Results still due will not be counted; late ones are dropped by mathResultIn
+    this->m_lock.lock();
+    this->m_lost += this->m_tracker.abandon();
+    const U32 completed = this->m_completed;
+    const LatencySummary latency(
+        this->m_latency.getCount(), this->m_latency.percentile(50),
+        this->m_latency.percentile(99), this->m_latency.getMax()
+    );
+    this->m_lock.unLock();
+    this->log_ACTIVITY_HI_LOAD_FINISHED(this->m_sent, completed, this->m_lost, this->m_skipped, latency);
+  }
+
+  void MathLoadGen ::
+    publishTelemetry(const Fw::Time& now)
+  {
+    this->m_lock.lock();
+    const U32 completed = this->m_completed;
+    const LatencySummary latency(
+        this->m_latency.getCount(), this->m_latency.percentile(50),
+        this->m_latency.percentile(99), this->m_latency.getMax()
+    );
+    this->m_lock.unLock();
+
+    // Rates over the whole tick period
+    const U32 tickUs = LatencyHistogram::elapsedUs(this->m_lastTick, now);
+    const U32 sentRate = (tickUs > 0) ?
+        static_cast<U32>((static_cast<U64>(this->m_sent - this->m_lastSent) * 1000000U) / tickUs) : 0;
+    const U32 resultRate = (tickUs > 0) ?
+        static_cast<U32>((static_cast<U64>(completed - this->m_lastCompleted) * 1000000U) / tickUs) : 0;
+    this->m_lastTick = now;
+    this->m_lastSent = this->m_sent;
+    this->m_lastCompleted = completed;
+
+    this->tlmWrite_LOAD_SENT(this->m_sent);
+    this->tlmWrite_LOAD_RESULTS(completed);
+    this->tlmWrite_LOAD_RATE_ACHIEVED(sentRate);
+    this->tlmWrite_LOAD_RESULT_RATE(resultRate);
+    this->tlmWrite_LOAD_LOST(this->m_lost);
+    this->tlmWrite_LOAD_SKIPPED(this->m_skipped);
+    this->tlmWrite_LOAD_LATENCY(latency);
+  }
+
+  U64 MathLoadGen ::
+    offsetUs(
+        const Fw::Time& start,
+        const Fw::Time& end
+    )
+  {
+    const U64 startUs = static_cast<U64>(start.getSeconds()) * 1000000U + start.getUSeconds();
+    const U64 endUs = static_cast<U64>(end.getSeconds()) * 1000000U + end.getUSeconds();
+    return (endUs > startUs) ? (endUs - startUs) : 0;
+  }
+
+} // end namespace MathModule
@@ -0,0 +1,233 @@
+// ======================================================================
+// \title  MathLoadGen.hpp
+// \brief  hpp file for MathLoadGen component implementation class
+// ======================================================================
+
+#ifndef MathLoadGen_HPP
+#define MathLoadGen_HPP
+
+#include "Components/MathLoadGen/MathLoadGenComponentAc.hpp"
+#include <Components/MathUtils/LatencyHistogram.hpp>
+#include <Components/MathUtils/RequestTracker.hpp>
+#include <Os/Mutex.hpp>
+
+namespace MathModule {
+
+  class MathLoadGen :
+    public MathLoadGenComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction, initialization, and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object MathLoadGen
+      //!
+      MathLoadGen(
+          const char *const compName /*!< The component name*/
+      );
+
+      //! Destroy object MathLoadGen
+      //!
+      ~MathLoadGen();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Constants and types
+      // ----------------------------------------------------------------------
+
+      enum {
+        //! Set in the identifier of every generated request
+        LOAD_ID_TAG = 0x40000000,
+        //! The identifier bits that hold the tag; clear of the MathReplay flag
+        LOAD_ID_MASK = 0xC0000000,
+        //! Highest LOAD_RATE honored, in requests per second
+        MAX_RATE = 1000000,
+        //! Microseconds without a result before a request counts as lost
+        LOST_TIMEOUT_US = 1000000,
+        //! Microseconds the schedule may fall behind before it is moved up instead of caught up
+        MAX_LAG_US = 100000,
+        //! Longest single sleep of a generate message, in microseconds, so other messages are seen promptly
+        SLEEP_SLICE_US = 10000,
+        //! Microseconds a generate message sleeps while the last results are collected
+        POLL_US = 1000
+      };
+
+      //! What the generator is doing
+      enum State {
+        IDLE, //!< No load is running
+        RUNNING, //!< Requests are being sent
+        DRAINING //!< The duration is over and the last results are being collected
+      };
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for user-defined typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for mathResultIn
+      //!
+      void mathResultIn_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< The identifier of the request*/
+          F32 result /*!< The result of the operation*/
+      );
+
+      //! Handler implementation for schedIn
+      //!
+      void schedIn_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          NATIVE_UINT_TYPE context /*!< The call order*/
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for internal ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for generate
+      //!
+      void generate_internalInterfaceHandler(
+          U32 epoch /*!< The run that posted the message*/
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Command handler implementations
+      // ----------------------------------------------------------------------
+
+      //! Implementation for LOAD_START command handler
+      //! Start generating load with the current parameters
+      void LOAD_START_cmdHandler(
+          const FwOpcodeType opCode, /*!< The opcode*/
+          const U32 cmdSeq, /*!< The command sequence number*/
+          U32 durationS /*!< Seconds to run for, or 0 to run until LOAD_STOP*/
+      );
+
+      //! Implementation for LOAD_STOP command handler
+      //! Stop generating load
+      void LOAD_STOP_cmdHandler(
+          const FwOpcodeType opCode, /*!< The opcode*/
+          const U32 cmdSeq /*!< The command sequence number*/
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Read the load parameters into the members below
+      void loadSettings();
+
+      //! Send one burst of requests
+      void sendBurst(
+          const Fw::Time& now /*!< The current time*/
+      );
+
+      //! Next value of the xorshift generator; never zero
+      U32 nextRandom();
+
+      //! Pick the operation of the next request
+      MathOp pickOp();
+
+      //! Pick the operands of the next request
+      void pickOperands(
+          F32& val1, /*!< Receives the first operand*/
+          F32& val2 /*!< Receives the second operand*/
+      );
+
+      //! End the load, counting requests still in flight as lost, and report it
+      void finishLoad();
+
+      //! Write the load telemetry
+      void publishTelemetry(
+          const Fw::Time& now /*!< The current time*/
+      );
+
+      //! Microseconds between two times, without the cap of LatencyHistogram::elapsedUs
+      static U64 offsetUs(
+          const Fw::Time& start, /*!< The earlier time*/
+          const Fw::Time& end /*!< The later time*/
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! What the generator is doing
+      State m_state;
+
+      //! Identifies the running load; generate messages of earlier loads are ignored
+      U32 m_epoch;
+
+      //! Requests per second of the running load
+      U32 m_rate;
+
+      //! Requests per burst of the running load
+      U32 m_burst;
+
+      //! Operations of the running load
+      LoadOpMix m_mix;
+
+      //! Operands of the running load
+      LoadOperands m_operands;
+
+      //! Seed of the running load
+      U32 m_seed;
+
+      //! State of the xorshift generator
+      U32 m_random;
+
+      //! How long the running load lasts, in microseconds, or 0 until stopped
+      U64 m_durationUs;
+
+      //! When the running load started
+      Fw::Time m_startTime;
+
+      //! Bursts scheduled so far; the next is due m_bursts burst intervals after m_startTime
+      U64 m_bursts;
+
+      //! Requests sent by the load
+      U32 m_sent;
+
+      //! Requests given up on without a result
+      U32 m_lost;
+
+      //! Requests not sent because the tracker was full
+      U32 m_skipped;
+
+      //! Time of the last schedIn call
+      Fw::Time m_lastTick;
+
+      //! Value of m_sent at the last schedIn call
+      U32 m_lastSent;
+
+      //! Value of m_completed at the last schedIn call
+      U32 m_lastCompleted;
+
+      //! Guards the members below, which mathResultIn updates; never held across a port call
+      Os::Mutex m_lock;
+
+      //! Generated requests waiting for results
+      RequestTracker m_tracker;
+
+      //! Results received for the load
+      U32 m_completed;
+
+      //! Round-trip times of the load
+      LatencyHistogram m_latency;
+
+    };
+
+} // end namespace MathModule
+
+#endif
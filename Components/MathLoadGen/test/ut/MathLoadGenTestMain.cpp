@@ -0,0 +1,32 @@
+// ----------------------------------------------------------------------
+// TestMain.cpp
+// ----------------------------------------------------------------------
+
+#include "MathLoadGenTester.hpp"
+#include "STest/Random/Random.hpp"
+
+TEST(Nominal, Rate) {
+    MathModule::MathLoadGenTester tester;
+    tester.testRate();
+}
+
+TEST(Nominal, Duration) {
+    MathModule::MathLoadGenTester tester;
+    tester.testDuration();
+}
+
+TEST(Nominal, Skipped) {
+    MathModule::MathLoadGenTester tester;
+    tester.testSkipped();
+}
+
+TEST(Nominal, Mixes) {
+    MathModule::MathLoadGenTester tester;
+    tester.testMixes();
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    STest::Random::seed();
+    return RUN_ALL_TESTS();
+}
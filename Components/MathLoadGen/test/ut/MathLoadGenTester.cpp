@@ -0,0 +1,274 @@
+// ======================================================================
+// \title  MathLoadGen.hpp
+// \brief  cpp file for MathLoadGen test harness implementation class
+// ======================================================================
+
+#include "MathLoadGenTester.hpp"
+#include "STest/Pick/Pick.hpp"
+#include <cmath>
+
+namespace MathModule {
+  #define CMD_SEQ 42
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  MathLoadGenTester ::
+    MathLoadGenTester() :
+      MathLoadGenGTestBase("Tester", MathLoadGenTester::MAX_HISTORY_SIZE),
+      component("MathLoadGen"),
+      m_answer(true)
+  {
+    this->initComponents();
+    this->connectPorts();
+    this->component.loadParameters();
+  }
+
+  MathLoadGenTester ::
+    ~MathLoadGenTester()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void MathLoadGenTester ::
+    setLoad(
+        U32 rate,
+        U32 burst,
+        LoadOpMix mix,
+        LoadOperands operands,
+        U32 seed
+    )
+  {
+    this->paramSet_LOAD_RATE(rate, Fw::ParamValid::VALID);
+    this->paramSend_LOAD_RATE(TEST_INSTANCE_ID, CMD_SEQ);
+    this->paramSet_LOAD_BURST(burst, Fw::ParamValid::VALID);
+    this->paramSend_LOAD_BURST(TEST_INSTANCE_ID, CMD_SEQ);
+    this->paramSet_LOAD_OP_MIX(mix, Fw::ParamValid::VALID);
+    this->paramSend_LOAD_OP_MIX(TEST_INSTANCE_ID, CMD_SEQ);
+    this->paramSet_LOAD_OPERANDS(operands, Fw::ParamValid::VALID);
+    this->paramSend_LOAD_OPERANDS(TEST_INSTANCE_ID, CMD_SEQ);
+    this->paramSet_LOAD_SEED(seed, Fw::ParamValid::VALID);
+    this->paramSend_LOAD_SEED(TEST_INSTANCE_ID, CMD_SEQ);
+  }
+
+  void MathLoadGenTester ::
+    startLoad(U32 durationS)
+  {
+    // The command only posts the first generate message
+    const U32 sent = this->fromPortHistory_mathOpOut->size();
+    this->sendCmd_LOAD_START(TEST_INSTANCE_ID, CMD_SEQ, durationS);
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE(this->cmdResponseHistory->size() - 1,
+                        MathLoadGenComponentBase::OPCODE_LOAD_START, CMD_SEQ, Fw::CmdResponse::OK);
+    ASSERT_from_mathOpOut_SIZE(sent);
+  }
+
+  void MathLoadGenTester ::
+    testRate()
+  {
+    this->setTestTime(Fw::Time(TB_NONE, 10, 0));
+    this->setLoad(1000, 2, LoadOpMix::ADD_ONLY, LoadOperands::CONSTANT, 1);
+    this->clearHistory();
+    this->startLoad(0);
+    ASSERT_EVENTS_LOAD_STARTED_SIZE(1);
+    ASSERT_EVENTS_LOAD_STARTED(0, 1000, 2, LoadOpMix::ADD_ONLY, LoadOperands::CONSTANT, 1);
+
+    // The first burst is due at once and the next two milliseconds later
+    this->component.doDispatch();
+    ASSERT_from_mathOpOut_SIZE(2);
+    ASSERT_from_mathOpOut(0, 0x40000000, 3.0f, MathOp::ADD, 2.0f);
+    ASSERT_from_mathOpOut(1, 0x40000001, 3.0f, MathOp::ADD, 2.0f);
+    this->component.doDispatch();
+    ASSERT_from_mathOpOut_SIZE(2);
+    this->setTestTime(Fw::Time(TB_NONE, 10, 2000));
+    this->component.doDispatch();
+    ASSERT_from_mathOpOut_SIZE(4);
+    ASSERT_from_clientResultOut_SIZE(0);
+
+    // The stop overtakes the next burst, whose message then does nothing
+    this->sendCmd_LOAD_STOP(TEST_INSTANCE_ID, CMD_SEQ);
+    this->component.doDispatch();
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE_SIZE(2);
+    ASSERT_CMD_RESPONSE(1, MathLoadGenComponentBase::OPCODE_LOAD_STOP, CMD_SEQ, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_LOAD_FINISHED_SIZE(1);
+    ASSERT_EVENTS_LOAD_FINISHED(0, 4, 4, 0, 0, LatencySummary(4, 0, 0, 0));
+    this->component.doDispatch();
+    ASSERT_from_mathOpOut_SIZE(4);
+
+    // Rates cover the whole tick since the start
+    this->setTestTime(Fw::Time(TB_NONE, 11, 0));
+    this->invoke_to_schedIn(0, 0);
+    this->component.doDispatch();
+    ASSERT_TLM_LOAD_SENT(0, 4);
+    ASSERT_TLM_LOAD_RESULTS(0, 4);
+    ASSERT_TLM_LOAD_RATE_ACHIEVED(0, 4);
+    ASSERT_TLM_LOAD_RESULT_RATE(0, 4);
+    ASSERT_TLM_LOAD_LOST(0, 0);
+    ASSERT_TLM_LOAD_SKIPPED(0, 0);
+
+    // Other results pass through; late generated ones do not
+    this->clearHistory();
+    this->invoke_to_mathResultIn(0, 5, 1.0f);
+    this->invoke_to_mathResultIn(0, 0x40000001, 5.0f);
+    ASSERT_from_clientResultOut_SIZE(1);
+    ASSERT_from_clientResultOut(0, 5, 1.0f);
+  }
+
+  void MathLoadGenTester ::
+    testDuration()
+  {
+    this->setTestTime(Fw::Time(TB_NONE, 10, 0));
+    this->setLoad(2, 1, LoadOpMix::UNIFORM, LoadOperands::UNIFORM, 1);
+    this->m_answer = false;
+    this->clearHistory();
+    this->startLoad(1);
+    this->component.doDispatch();
+    this->setTestTime(Fw::Time(TB_NONE, 10, 500000));
+    this->component.doDispatch();
+    ASSERT_from_mathOpOut_SIZE(2);
+
+    // The duration is over; the first request is lost and the second still due
+    this->setTestTime(Fw::Time(TB_NONE, 11, 0));
+    this->component.doDispatch();
+    ASSERT_from_mathOpOut_SIZE(2);
+    ASSERT_EVENTS_LOAD_FINISHED_SIZE(0);
+    this->setTestTime(Fw::Time(TB_NONE, 11, 500000));
+    this->component.doDispatch();
+    ASSERT_EVENTS_LOAD_FINISHED_SIZE(1);
+    ASSERT_EVENTS_LOAD_FINISHED(0, 2, 0, 2, 0, LatencySummary(0, 0, 0, 0));
+
+    // Nothing to stop now
+    this->sendCmd_LOAD_STOP(TEST_INSTANCE_ID, CMD_SEQ);
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE(1, MathLoadGenComponentBase::OPCODE_LOAD_STOP, CMD_SEQ,
+                        Fw::CmdResponse::EXECUTION_ERROR);
+  }
+
+  void MathLoadGenTester ::
+    testSkipped()
+  {
+    // Unanswered, two bursts of 1000 overfill the tracker
+    this->setTestTime(Fw::Time(TB_NONE, 10, 0));
+    this->setLoad(2000, 1000, LoadOpMix::ADD_ONLY, LoadOperands::CONSTANT, 1);
+    this->m_answer = false;
+    this->clearHistory();
+    this->startLoad(0);
+    this->component.doDispatch();
+    ASSERT_from_mathOpOut_SIZE(1000);
+    this->setTestTime(Fw::Time(TB_NONE, 10, 500000));
+    this->component.doDispatch();
+    ASSERT_from_mathOpOut_SIZE(RequestTracker::CAPACITY);
+    ASSERT_from_mathOpOut(RequestTracker::CAPACITY - 1, 0x40000000 + RequestTracker::CAPACITY - 1,
+                          3.0f, MathOp::ADD, 2.0f);
+
+    // Only one load at a time
+    this->sendCmd_LOAD_START(TEST_INSTANCE_ID, CMD_SEQ + 1, 0);
+    this->component.doDispatch();
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE(1, MathLoadGenComponentBase::OPCODE_LOAD_START, CMD_SEQ + 1, Fw::CmdResponse::BUSY);
+
+    this->sendCmd_LOAD_STOP(TEST_INSTANCE_ID, CMD_SEQ);
+    this->component.doDispatch();
+    this->component.doDispatch();
+    ASSERT_EVENTS_LOAD_FINISHED_SIZE(1);
+    ASSERT_EVENTS_LOAD_FINISHED(0, RequestTracker::CAPACITY, 0, RequestTracker::CAPACITY,
+                                2000 - RequestTracker::CAPACITY, LatencySummary(0, 0, 0, 0));
+  }
+
+  void MathLoadGenTester ::
+    testMixes()
+  {
+    const U32 burst = 64;
+    this->setTestTime(Fw::Time(TB_NONE, 10, 0));
+    this->setLoad(1000, burst, LoadOpMix::UNIFORM, LoadOperands::WITH_ZEROS, 7);
+    this->clearHistory();
+    this->startLoad(0);
+    this->component.doDispatch();
+    ASSERT_from_mathOpOut_SIZE(burst);
+    U32 ops[MathOp::NUM_CONSTANTS] = {};
+    U32 zeros = 0;
+    for (U32 i = 0; i < burst; i++) {
+        const FromPortEntry_mathOpOut& entry = this->fromPortHistory_mathOpOut->at(i);
+        ops[entry.op.e]++;
+        zeros += (entry.val2 == 0.0f) ? 1 : 0;
+        ASSERT_GE(entry.val1, -1000.0f);
+        ASSERT_LT(entry.val1, 1000.0f);
+    }
+    for (U32 op = 0; op < MathOp::NUM_CONSTANTS; op++) {
+        ASSERT_GT(ops[op], 0U);
+    }
+    ASSERT_GT(zeros, 0U);
+
+    // The same seed gives the same requests
+    this->sendCmd_LOAD_STOP(TEST_INSTANCE_ID, CMD_SEQ);
+    this->component.doDispatch();
+    this->component.doDispatch();
+    this->component.doDispatch();
+    this->startLoad(0);
+    this->component.doDispatch();
+    ASSERT_from_mathOpOut_SIZE(2 * burst);
+    for (U32 i = 0; i < burst; i++) {
+        const FromPortEntry_mathOpOut& first = this->fromPortHistory_mathOpOut->at(i);
+        ASSERT_from_mathOpOut(burst + i, first.requestId, first.val1, first.op, first.val2);
+    }
+
+    // Divisions by small integers only
+    this->sendCmd_LOAD_STOP(TEST_INSTANCE_ID, CMD_SEQ);
+    this->component.doDispatch();
+    this->component.doDispatch();
+    this->component.doDispatch();
+    this->setLoad(1000, burst, LoadOpMix::DIV_ONLY, LoadOperands::SMALL_INTEGERS, 7);
+    this->clearHistory();
+    this->startLoad(0);
+    this->component.doDispatch();
+    ASSERT_from_mathOpOut_SIZE(burst);
+    for (U32 i = 0; i < burst; i++) {
+        const FromPortEntry_mathOpOut& entry = this->fromPortHistory_mathOpOut->at(i);
+        ASSERT_EQ(entry.op.e, MathOp::DIV);
+        ASSERT_EQ(entry.val1, std::floor(entry.val1));
+        ASSERT_GE(entry.val1, 1.0f);
+        ASSERT_LE(entry.val1, 16.0f);
+        ASSERT_GE(entry.val2, 1.0f);
+        ASSERT_LE(entry.val2, 16.0f);
+    }
+    this->sendCmd_LOAD_STOP(TEST_INSTANCE_ID, CMD_SEQ);
+    this->component.doDispatch();
+    this->component.doDispatch();
+    this->component.doDispatch();
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  void MathLoadGenTester ::
+    from_mathOpOut_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        F32 val1,
+        const MathModule::MathOp &op,
+        F32 val2
+    )
+  {
+    this->pushFromPortEntry_mathOpOut(requestId, val1, op, val2);
+    if (this->m_answer) {
+        this->invoke_to_mathResultIn(0, requestId, val1 + val2);
+    }
+  }
+
+  void MathLoadGenTester ::
+    from_clientResultOut_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        F32 result
+    )
+  {
+    this->pushFromPortEntry_clientResultOut(requestId, result);
+  }
+
+} // end namespace MathModule
@@ -0,0 +1,113 @@
+// ======================================================================
+// \title  MathLoadGen/test/ut/Tester.hpp
+// \brief  hpp file for MathLoadGen test harness implementation class
+// ======================================================================
+
+#ifndef TESTER_HPP
+#define TESTER_HPP
+
+#include "MathLoadGenGTestBase.hpp"
+#include "Components/MathLoadGen/MathLoadGen.hpp"
+
+namespace MathModule {
+
+  class MathLoadGenTester :
+    public MathLoadGenGTestBase
+  {
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+    public:
+      // Maximum size of histories storing events, telemetry, and port outputs; room for a full tracker
+      static const NATIVE_INT_TYPE MAX_HISTORY_SIZE = 1100;
+      // Instance ID supplied to the component instance under test
+      static const NATIVE_INT_TYPE TEST_INSTANCE_ID = 0;
+      // Queue depth supplied to component instance under test
+      static const NATIVE_INT_TYPE TEST_INSTANCE_QUEUE_DEPTH = 10;
+
+      //! Construct object MathLoadGenTester
+      //!
+      MathLoadGenTester();
+
+      //! Destroy object MathLoadGenTester
+      //!
+      ~MathLoadGenTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      //! Set the load parameters
+      void setLoad(U32 rate, U32 burst, LoadOpMix mix, LoadOperands operands, U32 seed);
+
+      //! Send LOAD_START and dispatch it, which sends nothing yet
+      void startLoad(U32 durationS);
+
+      void testRate();
+
+      void testDuration();
+
+      void testSkipped();
+
+      void testMixes();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Handlers for typed from ports
+      // ----------------------------------------------------------------------
+
+      //! Handler for from_mathOpOut
+      //!
+      void from_mathOpOut_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< Identifies the request in the matching result*/
+          F32 val1, /*!< The first operand*/
+          const MathModule::MathOp &op, /*!< The operation*/
+          F32 val2 /*!< The second operand*/
+      );
+
+      //! Handler for from_clientResultOut
+      //!
+      void from_clientResultOut_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< The identifier of the request*/
+          F32 result /*!< The result of the operation*/
+      );
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper methods
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      //!
+      void connectPorts();
+
+      //! Initialize components
+      //!
+      void initComponents();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      //!
+      MathLoadGen component;
+
+      //! Whether mathOpOut requests are answered at once with the sum of their operands
+      bool m_answer;
+
+  };
+
+} // end namespace MathModule
+
+#endif
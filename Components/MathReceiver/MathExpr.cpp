@@ -0,0 +1,359 @@
+// ======================================================================
+// \title  MathExpr.cpp
+// \brief  cpp file for the expression compiler and bytecode cache used by MathReceiver
+// ======================================================================
+
+#include <Components/MathReceiver/MathExpr.hpp>
+#include <Fw/Types/Assert.hpp>
+#include <cstdlib>
+#include <cstring>
+
+namespace MathModule {
+
+  namespace MathExpr {
+
+    namespace {
+
+      //! Apply a binary opcode to two values
+      F32 apply(Opcode opcode, F32 a, F32 b) {
+          switch (opcode) {
+              case ADD:
+                  return a + b;
+              case SUB:
+                  return a - b;
+              case MUL:
+                  return a * b;
+              case DIV:
+                  return a / b;
+              default:
+                  FW_ASSERT(0, opcode);
+                  return 0;
+          }
+      }
+
+      //! Recursive descent compiler for one expression
+      class Compiler {
+
+        public:
+
+          Compiler(const char* text, Program& program) :
+            m_next(text),
+            m_program(program),
+            m_depth(0),
+            m_status(ExprStatus::OK)
+          {
+            this->m_program.length = 0;
+            this->m_program.numConstants = 0;
+          }
+
+          ExprStatus run() {
+            this->expression();
+            this->skipSpace();
+            if ((this->m_status == ExprStatus::OK) && (*this->m_next != '\0')) {
+                this->m_status = ExprStatus::SYNTAX_ERROR;
+            }
+            return this->m_status;
+          }
+
+        private:
+
+          // expression := term (('+' | '-') term)*
+          void expression() {
+              this->term();
+              while (this->m_status == ExprStatus::OK) {
+                  const char c = this->peek();
+                  if ((c != '+') && (c != '-')) {
+                      break;
+                  }
+                  this->m_next++;
+                  this->term();
+                  this->binary((c == '+') ? ADD : SUB);
+              }
+          }
+
+          // term := unary (('*' | '/') unary)*
+          void term() {
+              this->unary();
+              while (this->m_status == ExprStatus::OK) {
+                  const char c = this->peek();
+                  if ((c != '*') && (c != '/')) {
+                      break;
+                  }
+                  this->m_next++;
+                  this->unary();
+                  this->binary((c == '*') ? MUL : DIV);
+              }
+          }
+
+          // unary := '-' unary | primary
+          void unary() {
+              if (this->peek() == '-') {
+                  this->m_next++;
+                  this->unary();
+                  this->negate();
+                  return;
+              }
+              this->primary();
+          }
+
+          // primary := number | variable | '(' expression ')'
+          void primary() {
+              const char c = this->peek();
+              if (c == '(') {
+                  this->m_next++;
+                  this->expression();
+                  if (this->m_status != ExprStatus::OK) {
+                      return;
+                  }
+                  if (this->peek() != ')') {
+                      this->m_status = ExprStatus::SYNTAX_ERROR;
+                      return;
+                  }
+                  this->m_next++;
+              } else if ((c >= 'a') && (c < ('a' + NUM_VARIABLES))) {
+                  this->m_next++;
+                  this->push(PUSH_VARIABLE, static_cast<U8>(c - 'a'));
+              } else if (((c >= '0') && (c <= '9')) || (c == '.')) {
+                  char* end = nullptr;
+                  const F32 value = static_cast<F32>(strtod(this->m_next, &end));
+                  if (end == this->m_next) {
+                      this->m_status = ExprStatus::SYNTAX_ERROR;
+                      return;
+                  }
+                  this->m_next = end;
+                  this->constant(value);
+              } else {
+                  this->m_status = ExprStatus::SYNTAX_ERROR;
+              }
+          }
+
+          char peek() {
+              this->skipSpace();
+              return *this->m_next;
+          }
+
+          void skipSpace() {
+              while ((*this->m_next == ' ') || (*this->m_next == '\t')) {
+                  this->m_next++;
+              }
+          }
+
+          // ----------------------------------------------------------------------
+          // Code generation
+          // ----------------------------------------------------------------------
+
+          void emit(U8 opcode, U8 operand) {
+              if (this->m_status != ExprStatus::OK) {
+                  return;
+              }
+              if (this->m_program.length >= MAX_INSTRUCTIONS) {
+                  this->m_status = ExprStatus::TOO_COMPLEX;
+                  return;
+              }
+              Instruction& instruction = this->m_program.code[this->m_program.length++];
+              instruction.opcode = opcode;
+              instruction.operand = operand;
+          }
+
+          void push(U8 opcode, U8 operand) {
+              if (this->m_depth >= MAX_STACK) {
+                  this->m_status = ExprStatus::TOO_COMPLEX;
+                  return;
+              }
+              this->m_depth++;
+              this->emit(opcode, operand);
+          }
+
+          void constant(F32 value) {
+              if (this->m_program.numConstants >= MAX_CONSTANTS) {
+                  this->m_status = ExprStatus::TOO_COMPLEX;
+                  return;
+              }
+              this->m_program.constants[this->m_program.numConstants] = value;
+              this->push(PUSH_CONSTANT, static_cast<U8>(this->m_program.numConstants));
+              this->m_program.numConstants++;
+          }
+
+          //! Whether the instruction back from the end pushes a constant
+          bool pushesConstant(U32 back) {
+              return (this->m_program.length > back) &&
+                     (this->m_program.code[this->m_program.length - 1 - back].opcode == PUSH_CONSTANT);
+          }
+
+          void binary(Opcode opcode) {
+              if (this->m_status != ExprStatus::OK) {
+                  return;
+              }
+              FW_ASSERT(this->m_depth >= 2, this->m_depth);
+              this->m_depth--;
+              // Fold two literals; each literal push owns the constant it added last
+              if (this->pushesConstant(0) && this->pushesConstant(1)) {
+                  F32* const constants = &this->m_program.constants[this->m_program.numConstants - 2];
+                  // A zero denominator is left to evaluate so it is reported
+                  if ((opcode != DIV) || (constants[1] != 0)) {
+                      constants[0] = apply(opcode, constants[0], constants[1]);
+                      this->m_program.numConstants--;
+                      this->m_program.length--;
+                      return;
+                  }
+              }
+              this->emit(static_cast<U8>(opcode), 0);
+          }
+
+          void negate() {
+              if (this->m_status != ExprStatus::OK) {
+                  return;
+              }
+              if (this->pushesConstant(0)) {
+                  F32& value = this->m_program.constants[this->m_program.numConstants - 1];
+                  value = -value;
+                  return;
+              }
+              this->emit(NEGATE, 0);
+          }
+
+        private:
+
+          const char* m_next; //!< The next character to parse
+          Program& m_program; //!< The program being generated
+          U32 m_depth; //!< Stack depth after the generated code runs
+          ExprStatus::T m_status; //!< The first error found
+
+      };
+
+      //! FNV-1a hash of the expression text
+      U32 hashText(const char* text) {
+          U32 hash = 2166136261U;
+          for (; *text != '\0'; text++) {
+              hash = (hash ^ static_cast<U8>(*text)) * 16777619U;
+          }
+          return hash;
+      }
+
+    }
+
+    ExprStatus compile(
+        const char* text,
+        Program& program
+    ) {
+        FW_ASSERT(text != nullptr);
+        if (strlen(text) > MAX_LENGTH) {
+            return ExprStatus::TOO_COMPLEX;
+        }
+        Compiler compiler(text, program);
+        return compiler.run();
+    }
+
+    F32 evaluate(
+        const Program& program,
+        const F32* vars,
+        U32& zeros
+    ) {
+        F32 stack[MAX_STACK];
+        U32 top = 0;
+        for (U32 i = 0; i < program.length; i++) {
+            const Instruction& instruction = program.code[i];
+            switch (instruction.opcode) {
+                case PUSH_CONSTANT:
+                    stack[top++] = program.constants[instruction.operand];
+                    break;
+                case PUSH_VARIABLE:
+                    stack[top++] = vars[instruction.operand];
+                    break;
+                case NEGATE:
+                    stack[top - 1] = -stack[top - 1];
+                    break;
+                case DIV:
+                    top--;
+                    if (stack[top] == 0) {
+                        zeros++;
+                        stack[top - 1] = 0;
+                        break;
+                    }
+                    stack[top - 1] = apply(DIV, stack[top - 1], stack[top]);
+                    break;
+                default:
+                    top--;
+                    stack[top - 1] = apply(
+                        static_cast<Opcode>(instruction.opcode), stack[top - 1], stack[top]
+                    );
+                    break;
+            }
+        }
+        // The compiler only emits programs that leave one value
+        FW_ASSERT(top == 1, top);
+        return stack[0];
+    }
+
+    // ----------------------------------------------------------------------
+    // Cache
+    // ----------------------------------------------------------------------
+
+    Cache ::
+      Cache() :
+        m_lookups(0),
+        m_hits(0),
+        m_misses(0)
+    {
+        for (U32 i = 0; i < NUM_ENTRIES; i++) {
+            this->m_entries[i].valid = false;
+        }
+    }
+
+    ExprStatus Cache ::
+      lookup(
+          const char* text,
+          const Program*& program
+      )
+    {
+        FW_ASSERT(text != nullptr);
+        const U32 hash = hashText(text);
+        this->m_lookups++;
+        Entry* victim = &this->m_entries[0];
+        for (U32 i = 0; i < NUM_ENTRIES; i++) {
+            Entry& entry = this->m_entries[i];
+            if (entry.valid && (entry.hash == hash) && (strcmp(entry.text, text) == 0)) {
+                entry.lastUsed = this->m_lookups;
+                this->m_hits++;
+                program = &entry.program;
+                return ExprStatus::OK;
+            }
+            // Prefer an empty entry, then the least recently used one
+            if (victim->valid && (!entry.valid || (entry.lastUsed < victim->lastUsed))) {
+                victim = &entry;
+            }
+        }
+
+        // Compile aside so a bad expression does not evict a good program
+        this->m_misses++;
+        Program compiled;
+        const ExprStatus status = compile(text, compiled);
+        if (status != ExprStatus::OK) {
+            return status;
+        }
+        victim->program = compiled;
+        victim->valid = true;
+        victim->hash = hash;
+        victim->lastUsed = this->m_lookups;
+        // compile rejected anything longer than MAX_LENGTH
+        (void) strncpy(victim->text, text, MAX_LENGTH);
+        victim->text[MAX_LENGTH] = '\0';
+        program = &victim->program;
+        return ExprStatus::OK;
+    }
+
+    U32 Cache ::
+      getHits() const
+    {
+        return this->m_hits;
+    }
+
+    U32 Cache ::
+      getMisses() const
+    {
+        return this->m_misses;
+    }
+
+  }
+
+} // end namespace MathModule
@@ -0,0 +1,136 @@
+// ======================================================================
+// \title  MathExpr.hpp
+// \brief  hpp file for the expression compiler and bytecode cache used by MathReceiver
+// ======================================================================
+
+#ifndef MathExpr_HPP
+#define MathExpr_HPP
+
+#include <FpConfig.hpp>
+#include "Types/ExprStatusEnumAc.hpp"
+
+namespace MathModule {
+
+  namespace MathExpr {
+
+    enum {
+      //! Longest expression text accepted, matching MATH_EXPR_LENGTH
+      MAX_LENGTH = 80,
+      //! Number of variables, a through d
+      NUM_VARIABLES = 4,
+      //! Instructions in one program
+      MAX_INSTRUCTIONS = 48,
+      //! Constants in one program
+      MAX_CONSTANTS = 16,
+      //! Evaluation stack depth
+      MAX_STACK = 16
+    };
+
+    //! Bytecode instructions of the evaluation stack machine
+    enum Opcode {
+      PUSH_CONSTANT, //!< Push constants[operand]
+      PUSH_VARIABLE, //!< Push vars[operand]
+      ADD, //!< Pop b and a, push a + b
+      SUB, //!< Pop b and a, push a - b
+      MUL, //!< Pop b and a, push a * b
+      DIV, //!< Pop b and a, push a / b, or 0 if b is 0
+      NEGATE //!< Pop a, push -a
+    };
+
+    //! One instruction
+    struct Instruction {
+      U8 opcode; //!< The Opcode
+      U8 operand; //!< Constant or variable index for the push instructions
+    };
+
+    //! A compiled expression
+    struct Program {
+      Instruction code[MAX_INSTRUCTIONS]; //!< The instructions, in execution order
+      U32 length; //!< The number of instructions
+      F32 constants[MAX_CONSTANTS]; //!< The literal values
+      U32 numConstants; //!< The number of literal values
+    };
+
+    //! Compile an expression to bytecode
+    //!
+    //! The grammar is the usual one for + - * /, unary minus and parentheses
+    //! over decimal literals and the variables a, b, c and d. Whitespace is
+    //! ignored. Literal-only subexpressions are folded at compile time.
+    //!
+    //! \return OK, or why the expression was rejected
+    ExprStatus compile(
+        const char* text, /*!< The expression, null-terminated*/
+        Program& program /*!< Receives the bytecode*/
+    );
+
+    //! Evaluate a compiled expression
+    //!
+    //! A division by zero yields zero for that step, matching the mathOpIn path.
+    //!
+    //! \return the value of the expression
+    F32 evaluate(
+        const Program& program, /*!< The bytecode*/
+        const F32* vars, /*!< The NUM_VARIABLES variable values*/
+        U32& zeros /*!< Incremented once per division by zero*/
+    );
+
+    //! Compiled programs of recently used expressions, keyed by their text
+    //!
+    //! A lookup that misses compiles the expression and replaces the least
+    //! recently used entry. Expressions that fail to compile are not cached.
+    class Cache {
+
+      public:
+
+        enum {
+          //! Number of programs kept
+          NUM_ENTRIES = 8
+        };
+
+        //! Construct an empty cache
+        Cache();
+
+        //! Find the program for an expression, compiling it on a miss
+        //!
+        //! \return OK with program set, or why the expression was rejected
+        ExprStatus lookup(
+            const char* text, /*!< The expression, null-terminated*/
+            const Program*& program /*!< Receives the cached program*/
+        );
+
+        //! Lookups answered from the cache
+        U32 getHits() const;
+
+        //! Lookups that compiled the expression
+        U32 getMisses() const;
+
+      private:
+
+        //! One cached program
+        struct Entry {
+          bool valid; //!< Whether the entry holds a program
+          U32 hash; //!< Hash of the expression text
+          U32 lastUsed; //!< Lookup count when the entry was last used
+          char text[MAX_LENGTH + 1]; //!< The expression text
+          Program program; //!< The compiled expression
+        };
+
+        //! The entries
+        Entry m_entries[NUM_ENTRIES];
+
+        //! Number of lookups, used to age the entries
+        U32 m_lookups;
+
+        //! Lookups answered from the cache
+        U32 m_hits;
+
+        //! Lookups that compiled the expression
+        U32 m_misses;
+
+    };
+
+  }
+
+} // end namespace MathModule
+
+#endif
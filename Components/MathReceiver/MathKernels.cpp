@@ -0,0 +1,299 @@
+// ======================================================================
+// \title  MathKernels.cpp
+// \brief  cpp file for the vectorized math kernels used by MathReceiver
+// ======================================================================
+
+#include <Components/MathReceiver/MathKernels.hpp>
+#include <Fw/Types/Assert.hpp>
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace MathModule {
+
+  namespace MathKernels {
+
+    namespace {
+
+#if defined(__AVX__) || defined(__SSE2__)
+      //! Number of set bits in a lane mask
+      U32 countLanes(int mask) {
+          U32 lanes = 0;
+          for (; mask != 0; mask &= (mask - 1)) {
+              lanes++;
+          }
+          return lanes;
+      }
+#endif
+
+#if defined(__AVX__) || defined(__SSE2__)
+      // ----------------------------------------------------------------------
+      // Vector unit traits: one register type and instruction set per element type
+      // ----------------------------------------------------------------------
+
+      template <typename T>
+      struct Lanes;
+
+#if defined(__AVX__)
+      template <>
+      struct Lanes<F32> {
+          typedef __m256 Reg;
+          static const U32 WIDTH = 8;
+          static Reg load(const F32* p) { return _mm256_loadu_ps(p); }
+          static void store(F32* p, Reg r) { _mm256_storeu_ps(p, r); }
+          static Reg set1(F32 v) { return _mm256_set1_ps(v); }
+          static Reg add(Reg a, Reg b) { return _mm256_add_ps(a, b); }
+          static Reg sub(Reg a, Reg b) { return _mm256_sub_ps(a, b); }
+          static Reg mul(Reg a, Reg b) { return _mm256_mul_ps(a, b); }
+          static Reg div(Reg a, Reg b) { return _mm256_div_ps(a, b); }
+          static Reg isZero(Reg a) { return _mm256_cmp_ps(a, _mm256_setzero_ps(), _CMP_EQ_OQ); }
+          static Reg clear(Reg mask, Reg a) { return _mm256_andnot_ps(mask, a); }
+          static int bits(Reg mask) { return _mm256_movemask_ps(mask); }
+      };
+
+      template <>
+      struct Lanes<F64> {
+          typedef __m256d Reg;
+          static const U32 WIDTH = 4;
+          static Reg load(const F64* p) { return _mm256_loadu_pd(p); }
+          static void store(F64* p, Reg r) { _mm256_storeu_pd(p, r); }
+          static Reg set1(F64 v) { return _mm256_set1_pd(v); }
+          static Reg add(Reg a, Reg b) { return _mm256_add_pd(a, b); }
+          static Reg sub(Reg a, Reg b) { return _mm256_sub_pd(a, b); }
+          static Reg mul(Reg a, Reg b) { return _mm256_mul_pd(a, b); }
+          static Reg div(Reg a, Reg b) { return _mm256_div_pd(a, b); }
+          static Reg isZero(Reg a) { return _mm256_cmp_pd(a, _mm256_setzero_pd(), _CMP_EQ_OQ); }
+          static Reg clear(Reg mask, Reg a) { return _mm256_andnot_pd(mask, a); }
+          static int bits(Reg mask) { return _mm256_movemask_pd(mask); }
+      };
+#else
+      template <>
+      struct Lanes<F32> {
+          typedef __m128 Reg;
+          static const U32 WIDTH = 4;
+          static Reg load(const F32* p) { return _mm_loadu_ps(p); }
+          static void store(F32* p, Reg r) { _mm_storeu_ps(p, r); }
+          static Reg set1(F32 v) { return _mm_set1_ps(v); }
+          static Reg add(Reg a, Reg b) { return _mm_add_ps(a, b); }
+          static Reg sub(Reg a, Reg b) { return _mm_sub_ps(a, b); }
+          static Reg mul(Reg a, Reg b) { return _mm_mul_ps(a, b); }
+          static Reg div(Reg a, Reg b) { return _mm_div_ps(a, b); }
+          static Reg isZero(Reg a) { return _mm_cmpeq_ps(a, _mm_setzero_ps()); }
+          static Reg clear(Reg mask, Reg a) { return _mm_andnot_ps(mask, a); }
+          static int bits(Reg mask) { return _mm_movemask_ps(mask); }
+      };
+
+      template <>
+      struct Lanes<F64> {
+          typedef __m128d Reg;
+          static const U32 WIDTH = 2;
+          static Reg load(const F64* p) { return _mm_loadu_pd(p); }
+          static void store(F64* p, Reg r) { _mm_storeu_pd(p, r); }
+          static Reg set1(F64 v) { return _mm_set1_pd(v); }
+          static Reg add(Reg a, Reg b) { return _mm_add_pd(a, b); }
+          static Reg sub(Reg a, Reg b) { return _mm_sub_pd(a, b); }
+          static Reg mul(Reg a, Reg b) { return _mm_mul_pd(a, b); }
+          static Reg div(Reg a, Reg b) { return _mm_div_pd(a, b); }
+          static Reg isZero(Reg a) { return _mm_cmpeq_pd(a, _mm_setzero_pd()); }
+          static Reg clear(Reg mask, Reg a) { return _mm_andnot_pd(mask, a); }
+          static int bits(Reg mask) { return _mm_movemask_pd(mask); }
+      };
+#endif
+#endif
+
+      // ----------------------------------------------------------------------
+      // Operation traits: one scalar and one vector form per operation
+      // ----------------------------------------------------------------------
+
+      struct Add {
+          static const bool CHECKS_ZERO = false;
+          template <typename T>
+          static T scalar(T a, T b) { return a + b; }
+#if defined(__AVX__) || defined(__SSE2__)
+          template <typename L>
+          static typename L::Reg vector(typename L::Reg a, typename L::Reg b) { return L::add(a, b); }
+#endif
+      };
+
+      struct Sub {
+          static const bool CHECKS_ZERO = false;
+          template <typename T>
+          static T scalar(T a, T b) { return a - b; }
+#if defined(__AVX__) || defined(__SSE2__)
+          template <typename L>
+          static typename L::Reg vector(typename L::Reg a, typename L::Reg b) { return L::sub(a, b); }
+#endif
+      };
+
+      struct Mul {
+          static const bool CHECKS_ZERO = false;
+          template <typename T>
+          static T scalar(T a, T b) { return a * b; }
+#if defined(__AVX__) || defined(__SSE2__)
+          template <typename L>
+          static typename L::Reg vector(typename L::Reg a, typename L::Reg b) { return L::mul(a, b); }
+#endif
+      };
+
+      struct Div {
+          static const bool CHECKS_ZERO = true;
+          template <typename T>
+          static T scalar(T a, T b) { return a / b; }
+#if defined(__AVX__) || defined(__SSE2__)
+          template <typename L>
+          static typename L::Reg vector(typename L::Reg a, typename L::Reg b) { return L::div(a, b); }
+#endif
+      };
+
+      // ----------------------------------------------------------------------
+      // Operand traits: an array read element by element or a broadcast scalar
+      // ----------------------------------------------------------------------
+
+      template <typename T>
+      struct Array {
+          const T* data;
+          explicit Array(const T* d) : data(d) { FW_ASSERT(d != nullptr); }
+          T at(U32 i) const { return this->data[i]; }
+#if defined(__AVX__) || defined(__SSE2__)
+          typename Lanes<T>::Reg lanes(U32 i) const { return Lanes<T>::load(this->data + i); }
+#endif
+      };
+
+      template <typename T>
+      struct Scalar {
+          T value;
+#if defined(__AVX__) || defined(__SSE2__)
+          typename Lanes<T>::Reg reg;
+          explicit Scalar(T v) : value(v), reg(Lanes<T>::set1(v)) {}
+          typename Lanes<T>::Reg lanes(U32) const { return this->reg; }
+#else
+          explicit Scalar(T v) : value(v) {}
+#endif
+          T at(U32) const { return this->value; }
+      };
+
+      // ----------------------------------------------------------------------
+      // Kernel body shared by all operations, element types and operand shapes
+      // ----------------------------------------------------------------------
+
+      template <typename Op, typename T, typename A, typename B>
+      U32 evaluateOp(
+          const A& val1,
+          const B& val2,
+          T* result,
+          U32 count,
+          T factor
+      ) {
+          U32 zeros = 0;
+          U32 i = 0;
+#if defined(__AVX__) || defined(__SSE2__)
+          typedef Lanes<T> L;
+          const typename L::Reg vFactor = L::set1(factor);
+          for (; i + L::WIDTH <= count; i += L::WIDTH) {
+              const typename L::Reg a = val1.lanes(i);
+              const typename L::Reg b = val2.lanes(i);
+              typename L::Reg r = L::mul(Op::template vector<L>(a, b), vFactor);
+              if (Op::CHECKS_ZERO) {
+                  // Lanes with a zero divisor produce zero instead of inf/nan
+                  const typename L::Reg isZero = L::isZero(b);
+                  r = L::clear(isZero, r);
+                  zeros += countLanes(L::bits(isZero));
+              }
+              L::store(result + i, r);
+          }
+#endif
+          // Remainder, or everything when no vector unit is enabled
+          for (; i < count; i++) {
+              if (Op::CHECKS_ZERO && (val2.at(i) == 0)) {
+                  result[i] = 0;
+                  zeros++;
+              }
+              else {
+                  result[i] = Op::scalar(val1.at(i), val2.at(i)) * factor;
+              }
+          }
+          return zeros;
+      }
+
+      //! Pick the kernel for an operation; element type and operand shapes are fixed at compile time
+      template <typename T, typename A, typename B>
+      U32 evaluateAll(
+          MathOp::T op,
+          const A& val1,
+          const B& val2,
+          T* result,
+          U32 count,
+          T factor
+      ) {
+          FW_ASSERT(result != nullptr);
+          U32 zeros = 0;
+          switch (op) {
+              case MathOp::ADD:
+                  zeros = evaluateOp<Add>(val1, val2, result, count, factor);
+                  break;
+              case MathOp::SUB:
+                  zeros = evaluateOp<Sub>(val1, val2, result, count, factor);
+                  break;
+              case MathOp::MUL:
+                  zeros = evaluateOp<Mul>(val1, val2, result, count, factor);
+                  break;
+              case MathOp::DIV:
+                  zeros = evaluateOp<Div>(val1, val2, result, count, factor);
+                  break;
+              default:
+                  FW_ASSERT(0, op);
+                  break;
+          }
+          return zeros;
+      }
+
+    }
+
+    U32 evaluate(
+        MathOp::T op,
+        const F32* val1,
+        const F32* val2,
+        F32* result,
+        U32 count,
+        F32 factor
+    ) {
+        return evaluateAll(op, Array<F32>(val1), Array<F32>(val2), result, count, factor);
+    }
+
+    U32 evaluate(
+        MathOp::T op,
+        const F32* val1,
+        F32 val2,
+        F32* result,
+        U32 count,
+        F32 factor
+    ) {
+        return evaluateAll(op, Array<F32>(val1), Scalar<F32>(val2), result, count, factor);
+    }
+
+    U32 evaluate(
+        MathOp::T op,
+        F32 val1,
+        const F32* val2,
+        F32* result,
+        U32 count,
+        F32 factor
+    ) {
+        return evaluateAll(op, Scalar<F32>(val1), Array<F32>(val2), result, count, factor);
+    }
+
+    U32 evaluate(
+        MathOp::T op,
+        const F64* val1,
+        const F64* val2,
+        F64* result,
+        U32 count,
+        F64 factor
+    ) {
+        return evaluateAll(op, Array<F64>(val1), Array<F64>(val2), result, count, factor);
+    }
+
+  }
+
+} // end namespace MathModule
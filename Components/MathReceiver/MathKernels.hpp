@@ -0,0 +1,83 @@
+// ======================================================================
+// \title  MathKernels.hpp
+// \brief  hpp file for the vectorized math kernels used by MathReceiver
+// ======================================================================
+
+#ifndef MathKernels_HPP
+#define MathKernels_HPP
+
+#include <FpConfig.hpp>
+#include "Types/MathOpEnumAc.hpp"
+
+namespace MathModule {
+
+  namespace MathKernels {
+
+    //! Apply an operation elementwise and scale by a factor
+    //!
+    //! Computes result[i] = (val1[i] op val2[i]) * factor for i < count. A
+    //! division by zero yields zero for that element, matching the scalar
+    //! mathOpIn path. Uses AVX or SSE when the build enables them and a scalar
+    //! loop otherwise. The arrays need not be aligned and result may alias
+    //! either input.
+    //!
+    //! \return the number of elements that divided by zero
+    U32 evaluate(
+        MathOp::T op, /*!< The operation*/
+        const F32* val1, /*!< The first operands*/
+        const F32* val2, /*!< The second operands*/
+        F32* result, /*!< The results*/
+        U32 count, /*!< The number of elements*/
+        F32 factor /*!< The multiplier applied to every result*/
+    );
+
+    //! Apply an operation between each element of an array and one value
+    //!
+    //! Computes result[i] = (val1[i] op val2) * factor for i < count, with the
+    //! same division by zero and aliasing rules as the elementwise form.
+    //!
+    //! \return the number of elements that divided by zero
+    U32 evaluate(
+        MathOp::T op, /*!< The operation*/
+        const F32* val1, /*!< The first operands*/
+        F32 val2, /*!< The second operand of every element*/
+        F32* result, /*!< The results*/
+        U32 count, /*!< The number of elements*/
+        F32 factor /*!< The multiplier applied to every result*/
+    );
+
+    //! Apply an operation between one value and each element of an array
+    //!
+    //! Computes result[i] = (val1 op val2[i]) * factor for i < count, with the
+    //! same division by zero and aliasing rules as the elementwise form.
+    //!
+    //! \return the number of elements that divided by zero
+    U32 evaluate(
+        MathOp::T op, /*!< The operation*/
+        F32 val1, /*!< The first operand of every element*/
+        const F32* val2, /*!< The second operands*/
+        F32* result, /*!< The results*/
+        U32 count, /*!< The number of elements*/
+        F32 factor /*!< The multiplier applied to every result*/
+    );
+
+    //! Apply an operation elementwise and scale by a factor, in double precision
+    //!
+    //! Same as the F32 form, from the same kernel template with half as many
+    //! lanes per vector.
+    //!
+    //! \return the number of elements that divided by zero
+    U32 evaluate(
+        MathOp::T op, /*!< The operation*/
+        const F64* val1, /*!< The first operands*/
+        const F64* val2, /*!< The second operands*/
+        F64* result, /*!< The results*/
+        U32 count, /*!< The number of elements*/
+        F64 factor /*!< The multiplier applied to every result*/
+    );
+
+  }
+
+} // end namespace MathModule
+
+#endif
@@ -6,10 +6,18 @@
 
 
 #include <Components/MathReceiver/MathReceiver.hpp>
+#include <Components/MathReceiver/MathKernels.hpp>
 #include <FpConfig.hpp>
+#include <cstring>
+#include <limits>
 
 namespace MathModule {
 
+  static_assert(LatencyBuckets::SIZE == LatencyHistogram::NUM_BUCKETS,
+                "LatencyBuckets must hold every histogram bucket");
+  static_assert(OpLatency::SIZE == MathOp::NUM_CONSTANTS,
+                "OpLatency must hold one summary per operation");
+
   // ----------------------------------------------------------------------
   // Construction, initialization, and destruction
   // ----------------------------------------------------------------------
@@ -18,9 +26,66 @@ namespace MathModule {
     MathReceiver(
         const char *const compName
     ) : MathReceiverComponentBase(compName),
-        numMathOps(0) 
+        numMathOps(0),
+        m_dispatchTaskStarted(false),
+        m_draining(false),
+        m_factor(1.0f),
+        m_dispatchMode(DispatchMode::RATE_GROUP),
+        m_defaultDispatchMode(DispatchMode::RATE_GROUP),
+        m_eventMode(EventMode::AGGREGATED),
+        m_overflowPolicy(OverflowPolicy::DROP_NEWEST),
+        m_summaryTicks(0),
+        m_stagedCount(0),
+        m_latencyUpdated(false),
+        m_lastBacklog(0),
+        m_lastUrgentDepth(0),
+        m_lastBulkDepth(0),
+        m_tlmOperation(MathOp::ADD),
+        m_tlmOpsDirty(false),
+        m_tlmQueueWaitUs(0),
+        m_tlmQueueWaitDirty(false),
+        m_tlmExprDirty(false),
+        m_memoEntries(nullptr),
+        m_memoIdentifier(0),
+        m_memoGeneration(0),
+        m_memoClearedGeneration(0),
+        m_tlmMemoDirty(false),
+        m_creditsOutstanding(0),
+        m_creditDropsSeen(0),
+        m_queueDrops(0),
+        m_droppedCount(0),
+        m_queueCoalesced(0),
+        m_tlmQueueDrops(0),
+        m_tlmQueueCoalesced(0),
+        m_tlmRecorded(0),
+        m_tlmRecordDrops(0),
+        m_budgetOverruns(0),
+        m_urgentRun(0),
+        m_enqueueCount(0),
+        m_dequeueCount(0)
   {
+    for (U32 i = 0; i < MathOp::NUM_CONSTANTS; i++) {
+        this->m_stagedGroups[i].count = 0;
+        this->m_stagedGroupsF64[i].count = 0;
+        this->m_summaryCounts[i] = 0;
+    }
+    this->m_fileJob.active = false;
+    this->m_fileJob.opCode = 0;
+    this->m_fileJob.cmdSeq = 0;
+    this->m_fileJob.op = MathOp::ADD;
+    this->m_fileJob.total = 0;
+    this->m_fileJob.done = 0;
+    this->m_fileJob.zeros = 0;
+  }
 
+  void MathReceiver ::
+    init(
+        const NATIVE_INT_TYPE queueDepth,
+        const NATIVE_INT_TYPE instance
+    )
+  {
+    FW_ASSERT(queueDepth <= MAX_QUEUE_DEPTH, queueDepth);
+    MathReceiverComponentBase::init(queueDepth, instance);
   }
 
   MathReceiver ::
@@ -29,6 +94,82 @@ namespace MathModule {
 
   }
 
+  void MathReceiver ::
+    startDispatchTask(
+        FwSizeType priority,
+        FwSizeType stackSize
+    )
+  {
+    FW_ASSERT(!this->m_dispatchTaskStarted);
+    // Every worker runs its own task, so the names come from the instance
+    Os::QueueString queueName;
+    Os::TaskString taskName;
+#if FW_OBJECT_NAMES == 1
+    queueName.format("%sWake", this->getObjectName());
+    taskName.format("%sDisp", this->getObjectName());
+#else
+    queueName.format("MathRecvWake%d", this->getInstance());
+    taskName.format("MathRecvDisp%d", this->getInstance());
+#endif
+    // One pending token is enough to guarantee the task drains again
+    const Os::Queue::Status queueStatus = this->m_wakeQueue.create(queueName, 1, sizeof(U8));
+    FW_ASSERT(queueStatus == Os::Queue::OP_OK, queueStatus);
+
+    Os::Task::Arguments arguments(taskName, MathReceiver::dispatchTaskRoutine, this, priority, stackSize);
+    const Os::Task::Status taskStatus = this->m_dispatchTask.start(arguments);
+    FW_ASSERT(taskStatus == Os::Task::OP_OK, taskStatus);
+    this->m_dispatchTaskStarted = true;
+  }
+
+  void MathReceiver ::
+    stopDispatchTask()
+  {
+    if (!this->m_dispatchTaskStarted) {
+        return;
+    }
+    const U8 token = WAKE_STOP;
+    // Block so the stop token cannot be lost behind a pending wakeup
+    (void) this->m_wakeQueue.send(&token, sizeof(token), 0, Os::Queue::BLOCKING);
+    (void) this->m_dispatchTask.join();
+    this->m_dispatchTaskStarted = false;
+  }
+
+  void MathReceiver ::
+    setDefaultDispatchMode(DispatchMode mode)
+  {
+    this->m_defaultDispatchMode = mode;
+  }
+
+  void MathReceiver ::
+    allocateMemo(
+        NATIVE_UINT_TYPE identifier,
+        Fw::MemAllocator& allocator,
+        U32 entries
+    )
+  {
+    FW_ASSERT(this->m_memoEntries == nullptr);
+    FW_ASSERT(entries > 0);
+    NATIVE_UINT_TYPE bytes = entries * sizeof(MemoCache::Entry);
+    bool recoverable = false;
+    void* const memory = allocator.allocate(identifier, bytes, recoverable);
+    FW_ASSERT(memory != nullptr);
+    FW_ASSERT(bytes >= entries * sizeof(MemoCache::Entry), bytes, entries);
+    this->m_memoEntries = static_cast<MemoCache::Entry*>(memory);
+    this->m_memoIdentifier = identifier;
+    this->m_memo.setup(this->m_memoEntries, entries);
+  }
+
+  void MathReceiver ::
+    deallocateMemo(Fw::MemAllocator& allocator)
+  {
+    if (this->m_memoEntries == nullptr) {
+        return;
+    }
+    this->m_memo.setup(nullptr, 0);
+    allocator.deallocate(this->m_memoIdentifier, this->m_memoEntries);
+    this->m_memoEntries = nullptr;
+  }
+
   // ----------------------------------------------------------------------
   // Handler implementations for user-defined typed input ports
   // ----------------------------------------------------------------------
@@ -36,58 +177,384 @@ namespace MathModule {
   void MathReceiver ::
     mathOpIn_handler(
         const NATIVE_INT_TYPE portNum,
+        U32 requestId,
         F32 val1,
         const MathModule::MathOp &op,
         F32 val2
     )
   {
-      // Get the initial result
-    F32 res = 0.0;
-    switch (op.e) {
-        case MathOp::ADD:
-            res = val1 + val2;
-            break;
-        case MathOp::SUB:
-            res = val1 - val2;
+    // The message stands for the request at the front of the pending queue,
+    // which is not the one it carried if the overflow policy dropped requests
+    PendingQueue::Request request;
+    U32 followers = 0;
+    this->m_pendingLock.lock();
+    const bool popped = this->m_pending.pop(request);
+    while (popped && this->m_pending.popFollower(this->m_followerIds[followers])) {
+        followers++;
+    }
+    this->m_pendingLock.unLock();
+    FW_ASSERT(popped);
+    const MathOp pendingOp = static_cast<MathOp::T>(request.op);
+
+    const Fw::Time dequeued = this->recordQueueWait(pendingOp.e);
+    // The queue slot is free again; the credits go back with the next grant
+    this->m_creditsOutstanding -= static_cast<I32>(1 + followers);
+
+    // Stage the request; a drain evaluates all staged requests together
+    this->stageOperation(request.requestId, request.val1, pendingOp, request.val2, dequeued);
+    // Requests merged into it get the same result
+    for (U32 i = 0; i < followers; i++) {
+        this->stageOperation(this->m_followerIds[i], request.val1, pendingOp, request.val2, dequeued);
+    }
+    if (!this->m_draining) {
+        this->flushStaged();
+    }
+  }//end mathOpIn_handler
+
+  void MathReceiver ::
+    mathOpIn_preMsgHook(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        F32 val1,
+        const MathModule::MathOp &op,
+        F32 val2
+    )
+  {
+    const PendingQueue::Request request = {requestId, val1, val2, static_cast<U8>(op.e)};
+    this->m_pendingLock.lock();
+    const bool pushed = this->m_pending.push(request);
+    if (this->m_recorder.isRecording()) {
+        // Only a copy into the recorder's ring; its task does the writing
+        const Fw::Time now = this->getTime();
+        const RequestLog::Record record = {
+            now.getSeconds(), now.getUSeconds(), requestId, val1, val2, static_cast<U8>(op.e)
+        };
+        this->m_recorder.record(record);
+    }
+    this->m_pendingLock.unLock();
+    // init keeps the queue depth below the pending queue capacity
+    FW_ASSERT(pushed, requestId);
+    this->announceRequest();
+  }
+
+  void MathReceiver ::
+    mathOpIn_overflowHook(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        F32 val1,
+        const MathModule::MathOp &op,
+        F32 val2
+    )
+  {
+    // No message will take the stamp of the pre-message hook; retiring the
+    // oldest keeps the counts even, so waits are per queue slot from here on
+    this->m_waitLock.lock();
+    this->m_dequeueCount++;
+    this->m_waitLock.unLock();
+
+    // The request is at the back of the pending queue with one request too many
+    const OverflowPolicy policy = this->getOverflowPolicy();
+    PendingQueue::Request dropped;
+    bool removed = false;
+    this->m_pendingLock.lock();
+    switch (policy.e) {
+        case OverflowPolicy::DROP_NEWEST:
+            removed = this->m_pending.dropNewest(dropped);
             break;
-        case MathOp::MUL:
-            res = val1 * val2;
+        case OverflowPolicy::DROP_OLDEST:
+            removed = this->m_pending.dropOldest(dropped);
             break;
-        case MathOp::DIV:
-            if ( val2 == 0 ){
-              this->log_ACTIVITY_HI_DIVIDE_BY_ZERO(); 
-              break; 
+        case OverflowPolicy::COALESCE:
+            if (this->m_pending.mergeNewest()) {
+                this->m_queueCoalesced++;
+            } else {
+                removed = this->m_pending.dropNewest(dropped);
             }
-            res = val1 / val2;
             break;
         default:
-            FW_ASSERT(0, op.e);
+            FW_ASSERT(0, policy.e);
             break;
-    }//end switch 
+    }
+    if (removed) {
+        this->keepDropped(dropped.requestId);
+        U32 follower = 0;
+        while (this->m_pending.popFollower(follower)) {
+            this->keepDropped(follower);
+        }
+    }
+    this->m_pendingLock.unLock();
+    // The caller may hold a lock the result path takes, so the failure results go out from the next drain
+    if (removed && (this->getDispatchMode() == DispatchMode::EVENT_DRIVEN)) {
+        this->wakeDispatchTask();
+    }
+  }
 
-    // Get the factor value
-    Fw::ParamValid valid;
-    F32 factor = paramGet_FACTOR(valid);
-    FW_ASSERT(
-        valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT,
-        valid.e
+  void MathReceiver ::
+    mathOpF64In_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        F64 val1,
+        const MathModule::MathOp &op,
+        F64 val2
+    )
+  {
+    const Fw::Time dequeued = this->recordQueueWait(op.e);
+
+    // Double precision requests share the staging and arrival order of single ones
+    this->stageOperationF64(requestId, val1, op, val2, dequeued);
+    if (!this->m_draining) {
+        this->flushStaged();
+    }
+  }
+
+  void MathReceiver ::
+    mathOpF64In_preMsgHook(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        F64 val1,
+        const MathModule::MathOp &op,
+        F64 val2
+    )
+  {
+    this->announceRequest();
+  }
+
+  void MathReceiver ::
+    mathOpRingIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        F32 val1,
+        const MathModule::MathOp &op,
+        F32 val2
+    )
+  {
+    FW_ASSERT(op.isValid(), op.e);
+    RingRecord record;
+    record.requestId = requestId;
+    record.val1 = val1;
+    record.val2 = val2;
+    record.op = op.e;
+    record.enqueued = this->getTime();
+    if (!this->m_ring.push(record)) {
+        this->log_WARNING_HI_RING_FULL(requestId);
+        return;
+    }
+    if (this->getDispatchMode() == DispatchMode::EVENT_DRIVEN) {
+        this->wakeDispatchTask();
+    }
+  }
+
+  void MathReceiver ::
+    mathOpUrgentIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        F32 val1,
+        const MathModule::MathOp &op,
+        F32 val2
+    )
+  {
+    FW_ASSERT(op.isValid(), op.e);
+    RingRecord record;
+    record.requestId = requestId;
+    record.val1 = val1;
+    record.val2 = val2;
+    record.op = op.e;
+    record.enqueued = this->getTime();
+    // The port guard keeps callers from pushing concurrently
+    if (!this->m_urgentRing.push(record)) {
+        this->log_WARNING_HI_URGENT_LANE_FULL(requestId);
+        return;
+    }
+    if (this->getDispatchMode() == DispatchMode::EVENT_DRIVEN) {
+        this->wakeDispatchTask();
+    }
+  }
+
+  void MathReceiver ::
+    mathBatchIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        const MathModule::MathOp &op,
+        U32 count,
+        const MathModule::MathBatch &val1,
+        const MathModule::MathBatch &val2
+    )
+  {
+    FW_ASSERT(count <= MathBatch::SIZE, count);
+    const Fw::Time dequeued = this->recordQueueWait(op.e);
+    // Results of earlier single requests go out first
+    this->flushStaged();
+
+    // Evaluate the whole batch at once; the factor is applied per element
+    MathBatch results;
+    const U32 zeros = MathKernels::evaluate(
+        op.e, &val1[0], &val2[0], &results[0], count, this->getFactor()
     );
+    if (zeros > 0) {
+        this->log_ACTIVITY_HI_BATCH_DIVIDE_BY_ZERO(zeros);
+    }
 
-    // Multiply result by factor
-    res *= factor;
+    numMathOps += count;
 
-    // Increment number of math ops 
-    numMathOps++;  
+    // Emit telemetry and events once for the batch
+    if (this->getEventMode() == EventMode::PER_OP) {
+        this->log_ACTIVITY_LO_BATCH_PERFORMED(op, count);
+    } else {
+        this->m_summaryCounts[op.e] += count;
+    }
+    this->m_tlmOperation = op.e;
+    this->m_tlmOpsDirty = true;
 
-    // Emit telemetry and events
-    this->log_ACTIVITY_HI_OPERATION_PERFORMED(op);
-    this->tlmWrite_OPERATION(op);
-    this->tlmWrite_NUMBER_OF_OPS(numMathOps); 
+    // Emit results; the batch counts as one service sample
+    this->mathResultBatchOut_out(0, requestId, count, results);
+    this->m_serviceLatency[op.e].record(
+        LatencyHistogram::elapsedUs(dequeued, this->getTime())
+    );
+    this->m_latencyUpdated = true;
+  }
 
-    // Emit result
-    this->mathResultOut_out(0, res);
-  }//end mathOpIn_handler
+  void MathReceiver ::
+    mathBatchIn_preMsgHook(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        const MathModule::MathOp &op,
+        U32 count,
+        const MathModule::MathBatch &val1,
+        const MathModule::MathBatch &val2
+    )
+  {
+    this->announceRequest();
+  }
+
+
+  void MathReceiver ::
+    vectorIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        const MathModule::MathOp &op,
+        Fw::Buffer &val1,
+        Fw::Buffer &val2,
+        Fw::Buffer &result
+    )
+  {
+    FW_ASSERT(op.isValid(), op.e);
+    const Fw::Time dequeued = this->recordQueueWait(op.e);
+    // Results of earlier single requests go out first
+    this->flushStaged();
+
+    // The elements are used where they lie, so they must be whole and aligned
+    const U32 count1 = vectorElements(val1);
+    const U32 count2 = vectorElements(val2);
+    if ((count1 == 0) || (count2 == 0)) {
+        this->rejectVector(requestId, VectorStatus::BAD_BUFFER, result);
+        return;
+    }
+    // A single element is broadcast against the other array
+    const U32 count = FW_MAX(count1, count2);
+    if ((count1 != count2) && (count1 != 1) && (count2 != 1)) {
+        this->rejectVector(requestId, VectorStatus::SIZE_MISMATCH, result);
+        return;
+    }
+    // Without a result buffer the results overwrite the array operand
+    const bool inPlace = (result.getData() == nullptr);
+    Fw::Buffer& target = !inPlace ? result : ((count1 == count) ? val1 : val2);
+    if (!inPlace && (vectorElements(result) < count)) {
+        this->rejectVector(requestId, VectorStatus::SIZE_MISMATCH, result);
+        return;
+    }
+
+    const F32* const in1 = reinterpret_cast<const F32*>(val1.getData());
+    const F32* const in2 = reinterpret_cast<const F32*>(val2.getData());
+    F32* const out = reinterpret_cast<F32*>(target.getData());
+    const F32 factor = this->getFactor();
+    U32 zeros = 0;
+    if (count1 == count2) {
+        zeros = MathKernels::evaluate(op.e, in1, in2, out, count, factor);
+    } else if (count1 == 1) {
+        zeros = MathKernels::evaluate(op.e, in1[0], in2, out, count, factor);
+    } else {
+        zeros = MathKernels::evaluate(op.e, in1, in2[0], out, count, factor);
+    }
+    if (zeros > 0) {
+        this->log_ACTIVITY_HI_BATCH_DIVIDE_BY_ZERO(zeros);
+    }
+
+    numMathOps += count;
+
+    // Reported like a batch: one event, every element counted
+    if (this->getEventMode() == EventMode::PER_OP) {
+        this->log_ACTIVITY_LO_BATCH_PERFORMED(op, count);
+    } else {
+        this->m_summaryCounts[op.e] += count;
+    }
+    this->m_tlmOperation = op.e;
+    this->m_tlmOpsDirty = true;
+
+    // Hand back the buffer holding the results; the request counts as one service sample
+    this->vectorResultOut_out(0, requestId, VectorStatus::OK, count, target);
+    this->m_serviceLatency[op.e].record(
+        LatencyHistogram::elapsedUs(dequeued, this->getTime())
+    );
+    this->m_latencyUpdated = true;
+  }
+
+  void MathReceiver ::
+    vectorIn_preMsgHook(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        const MathModule::MathOp &op,
+        Fw::Buffer &val1,
+        Fw::Buffer &val2,
+        Fw::Buffer &result
+    )
+  {
+    this->announceRequest();
+  }
+
+  void MathReceiver ::
+    exprIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        const Fw::StringBase &expr,
+        const MathModule::ExprVars &vars
+    )
+  {
+    // Results of earlier single requests go out first
+    this->flushStaged();
 
+    // Compile once per distinct expression; later requests reuse the bytecode
+    const MathExpr::Program* program = nullptr;
+    const ExprStatus status = this->m_exprCache.lookup(expr.toChar(), program);
+    this->m_tlmExprDirty = true;
+    if (status != ExprStatus::OK) {
+        this->log_WARNING_LO_EXPR_INVALID(requestId, status);
+        this->exprResultOut_out(0, requestId, status, 0);
+        return;
+    }
+
+    U32 zeros = 0;
+    const F32 result = MathExpr::evaluate(*program, &vars[0], zeros) * this->getFactor();
+    if (zeros > 0) {
+        this->log_ACTIVITY_HI_DIVIDE_BY_ZERO();
+    }
+    numMathOps++;
+    this->m_tlmOpsDirty = true;
+    this->exprResultOut_out(0, requestId, status, result);
+  }
+
+  void MathReceiver ::
+    exprIn_preMsgHook(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        const Fw::StringBase &expr,
+        const MathModule::ExprVars &vars
+    )
+  {
+    // Expressions have no MathOp, so their queue wait is not tracked
+    if (this->getDispatchMode() == DispatchMode::EVENT_DRIVEN) {
+        this->wakeDispatchTask();
+    }
+  }
 
   void MathReceiver ::
     schedIn_handler(
@@ -95,9 +562,81 @@ namespace MathModule {
         NATIVE_UINT_TYPE context
     )
   {
-   U32 numMsgs = this->m_queue.getMessagesAvailable();
-    for (U32 i = 0; i < numMsgs; ++i) {
-        (void) this->doDispatch();
+    // A budget of zero leaves that limit off
+    const U32 messageBudget = this->getTickMessageBudget();
+    const U32 timeBudget = this->getTickTimeBudget();
+    const U32 burst = this->getUrgentBurst();
+    const Fw::Time start = (timeBudget > 0) ? this->getTime() : Fw::Time();
+
+    this->m_dispatchLock.lock();
+    this->m_draining = true;
+    const Fw::Time served = this->getTime();
+    const U32 numMsgs = this->m_queue.getMessagesAvailable();
+    const U32 urgentDepth = this->m_urgentRing.size();
+    const U32 bulkDepth = numMsgs + this->m_ring.size();
+    bool overrun = false;
+    U32 dispatched = 0;
+    U32 queued = 0;
+    // The urgent lane goes first, then queued messages, then ring records,
+    // all against the same budget
+    while (true) {
+        const bool bulkWaiting = (queued < numMsgs) || (this->m_ring.size() > 0);
+        if (!bulkWaiting && (this->m_urgentRing.size() == 0)) {
+            break;
+        }
+        if (this->budgetSpent(dispatched, messageBudget, timeBudget, start)) {
+            overrun = true;
+            break;
+        }
+        const U32 limit = (messageBudget > 0) ? (messageBudget - dispatched) : static_cast<U32>(STAGE_CAPACITY);
+        const U32 urgent = this->serveUrgent(limit, bulkWaiting, burst);
+        if (urgent > 0) {
+            dispatched += urgent;
+            continue;
+        }
+        if (queued < numMsgs) {
+            (void) this->doDispatch();
+            queued++;
+            dispatched++;
+        } else {
+            dispatched += this->drainRing(limit);
+        }
+        this->m_urgentRun = 0;
+    }
+    this->flushStaged();
+    const U32 busyUs = LatencyHistogram::elapsedUs(served, this->getTime());
+    this->m_draining = false;
+
+    if (urgentDepth != this->m_lastUrgentDepth) {
+        this->tlmWrite_URGENT_DEPTH(urgentDepth);
+        this->m_lastUrgentDepth = urgentDepth;
+    }
+    if (bulkDepth != this->m_lastBulkDepth) {
+        this->tlmWrite_BULK_DEPTH(bulkDepth);
+        this->m_lastBulkDepth = bulkDepth;
+    }
+    // Whatever is left waits for the next tick
+    const U32 backlog = this->m_queue.getMessagesAvailable() + this->m_ring.size() + this->m_urgentRing.size();
+    if (overrun) {
+        this->m_budgetOverruns++;
+        this->tlmWrite_BUDGET_OVERRUNS(this->m_budgetOverruns);
+    }
+    if (backlog != this->m_lastBacklog) {
+        this->tlmWrite_DISPATCH_BACKLOG(backlog);
+        this->m_lastBacklog = backlog;
+    }
+    // A file only gets the ticks the queue leaves spare
+    if (!overrun) {
+        this->processFile();
+    }
+    this->failDropped();
+    this->grantCredits();
+    this->publishTelemetry();
+    this->publishLatency();
+    this->publishSummary();
+    this->m_dispatchLock.unLock();
+    if (dispatched > 0) {
+        this->reportBusy(busyUs);
     }
   }
 
@@ -119,6 +658,144 @@ namespace MathModule {
     this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
   }
 
+  void MathReceiver ::
+    DUMP_LATENCY_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq
+    )
+  {
+    // Publish what was gathered before the histograms are cleared
+    this->publishLatency();
+    for (U32 i = 0; i < MathOp::NUM_CONSTANTS; i++) {
+        const MathOp::T op = static_cast<MathOp::T>(i);
+        this->dumpHistogram(LatencyStage::QUEUE_WAIT, op, this->m_queueWaitLatency[i]);
+        this->dumpHistogram(LatencyStage::SERVICE, op, this->m_serviceLatency[i]);
+        this->m_queueWaitLatency[i].reset();
+        this->m_serviceLatency[i].reset();
+    }
+    // Lane waits restart along with the per-operation histograms
+    this->m_urgentWait.reset();
+    this->m_bulkWait.reset();
+    this->m_latencyUpdated = true;
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  void MathReceiver ::
+    DO_MATH_FILE_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq,
+        const Fw::CmdStringArg& inputPath,
+        MathModule::MathOp op,
+        const Fw::CmdStringArg& outputPath
+    )
+  {
+    FW_ASSERT(op.isValid(), op.e);
+    if (this->m_fileJob.active) {
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::BUSY);
+        return;
+    }
+    // Map the operands rather than read them; pages come in as the ticks reach them
+    if (!this->m_fileIn.open(inputPath.toChar())) {
+        this->log_WARNING_HI_FILE_FAILED(MathFileError::OPEN_FAILED);
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+    const FwSizeType size = this->m_fileIn.getSize();
+    if (((size % FILE_PAIR_SIZE) != 0) ||
+        ((size / FILE_PAIR_SIZE) > std::numeric_limits<U32>::max())) {
+        this->m_fileIn.close();
+        this->log_WARNING_HI_FILE_FAILED(MathFileError::BAD_SIZE);
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+    if (this->m_fileOut.open(outputPath.toChar(), Os::File::OPEN_CREATE, Os::File::OVERWRITE) != Os::File::OP_OK) {
+        this->m_fileIn.close();
+        this->log_WARNING_HI_FILE_FAILED(MathFileError::CREATE_FAILED);
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+
+    // The command completes from schedIn once the last result is written
+    FileJob& job = this->m_fileJob;
+    job.active = true;
+    job.opCode = opCode;
+    job.cmdSeq = cmdSeq;
+    job.op = op.e;
+    job.total = static_cast<U32>(size / FILE_PAIR_SIZE);
+    job.done = 0;
+    job.zeros = 0;
+    job.lastTick = this->getTime();
+    this->m_fileCrc.init();
+    this->log_ACTIVITY_HI_FILE_STARTED(inputPath, job.total);
+    this->tlmWrite_FILE_OPS_DONE(0);
+    this->tlmWrite_FILE_PROGRESS_PCT(0);
+  }
+
+  void MathReceiver ::
+    CANCEL_MATH_FILE_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq
+    )
+  {
+    if (!this->m_fileJob.active) {
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+    // The partial result file is left in place without a checksum
+    this->log_ACTIVITY_HI_FILE_CANCELED(this->m_fileJob.done);
+    this->finishFile(Fw::CmdResponse::EXECUTION_ERROR);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  void MathReceiver ::
+    START_RECORDING_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq,
+        const Fw::CmdStringArg& path,
+        U32 maxRecords
+    )
+  {
+    if (this->m_recorder.isOpen()) {
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::BUSY);
+        return;
+    }
+    // The file is created before the pre-message hook sees the recorder, so senders never wait on the disk
+    if (!this->m_recorder.start(path.toChar(), maxRecords)) {
+        this->log_WARNING_HI_RECORDING_FAILED(MathFileError::CREATE_FAILED);
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+    this->m_pendingLock.lock();
+    this->m_recorder.enable();
+    this->m_pendingLock.unLock();
+    this->log_ACTIVITY_HI_RECORDING_STARTED(path, maxRecords);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  void MathReceiver ::
+    STOP_RECORDING_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq
+    )
+  {
+    if (!this->m_recorder.isOpen()) {
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+    // Under the lock no pre-message hook is recording, so none records once it is released
+    this->m_pendingLock.lock();
+    this->m_recorder.disable();
+    this->m_pendingLock.unLock();
+    // Waits for the recorder's task to write out the ring, at most RING_CAPACITY records
+    if (!this->m_recorder.stop()) {
+        this->log_WARNING_HI_RECORDING_FAILED(MathFileError::WRITE_FAILED);
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+    this->log_ACTIVITY_HI_RECORDING_STOPPED(this->m_recorder.getRecorded(), this->m_recorder.getDropped());
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
   // Parameter Checker 
 
   // In: MathReceiver.cpp
@@ -127,19 +804,789 @@ namespace MathModule {
   {
       switch (id) {
           case PARAMID_FACTOR: {
-              Fw::ParamValid valid;
-              F32 val = this->paramGet_FACTOR(valid);
-              FW_ASSERT(
-                  valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT,
-                  valid.e
-              );
+              const F32 val = this->readFactor();
+              this->m_factor.store(val);
+              // Cached results were computed with the old factor
+              this->m_memoGeneration.fetch_add(1);
               this->log_ACTIVITY_HI_FACTOR_UPDATED(val);
               break;
           }
+          case PARAMID_TICK_MESSAGE_BUDGET:
+          case PARAMID_TICK_TIME_BUDGET_US:
+          case PARAMID_SUMMARY_INTERVAL:
+          case PARAMID_FILE_OPS_PER_TICK:
+          case PARAMID_REQUEST_CREDITS:
+          case PARAMID_URGENT_BURST:
+              // Read at the start or end of each tick
+              break;
+          case PARAMID_EVENT_MODE: {
+              const EventMode mode = this->readEventMode();
+              this->m_eventMode.store(mode.e);
+              this->log_ACTIVITY_HI_EVENT_MODE_UPDATED(mode);
+              break;
+          }
+          case PARAMID_OVERFLOW_POLICY: {
+              const OverflowPolicy policy = this->readOverflowPolicy();
+              this->m_overflowPolicy.store(policy.e);
+              this->log_ACTIVITY_HI_OVERFLOW_POLICY_UPDATED(policy);
+              break;
+          }
+          case PARAMID_DISPATCH_MODE: {
+              const DispatchMode mode = this->readDispatchMode();
+              this->m_dispatchMode.store(mode.e);
+              this->log_ACTIVITY_HI_DISPATCH_MODE_UPDATED(mode);
+              // Pick up anything queued while the rate group was servicing the queue
+              this->wakeDispatchTask();
+              break;
+          }
           default:
               FW_ASSERT(0, id);
               break;
       }
   }
 
+  void MathReceiver ::
+    parametersLoaded()
+  {
+      this->m_factor.store(this->readFactor());
+      this->m_memoGeneration.fetch_add(1);
+      this->m_dispatchMode.store(this->readDispatchMode().e);
+      this->m_eventMode.store(this->readEventMode().e);
+      this->m_overflowPolicy.store(this->readOverflowPolicy().e);
+  }
+
+  // ----------------------------------------------------------------------
+  // Dispatch helpers
+  // ----------------------------------------------------------------------
+
+  void MathReceiver ::
+    dispatchTaskRoutine(void* arg)
+  {
+    FW_ASSERT(arg != nullptr);
+    MathReceiver* const receiver = static_cast<MathReceiver*>(arg);
+    while (true) {
+        U8 token = WAKE_STOP;
+        FwSizeType size = 0;
+        FwQueuePriorityType priority = 0;
+        const Os::Queue::Status status = receiver->m_wakeQueue.receive(
+            &token, sizeof(token), Os::Queue::BLOCKING, size, priority
+        );
+        if (status != Os::Queue::OP_OK) {
+            break;
+        }
+        // The task blocks here between drains. A request whose wakeup came
+        // before its message landed is served by the next wakeup or schedIn,
+        // and one announced before the stop is served on the way out.
+        if ((token == WAKE_DISPATCH) || (receiver->getDispatchMode() == DispatchMode::EVENT_DRIVEN)) {
+            receiver->dispatchPending();
+        }
+        if (token == WAKE_STOP) {
+            break;
+        }
+    }
+  }
+
+  template <typename T>
+  T MathReceiver ::
+    readParam(
+        T (MathReceiverComponentBase::*paramGet)(Fw::ParamValid&),
+        Fw::ParamValid& valid
+    )
+  {
+    const T value = (this->*paramGet)(valid);
+    FW_ASSERT(
+        valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT,
+        valid.e
+    );
+    return value;
+  }
+
+  template <typename T>
+  T MathReceiver ::
+    readParam(T (MathReceiverComponentBase::*paramGet)(Fw::ParamValid&))
+  {
+    Fw::ParamValid valid;
+    return this->readParam(paramGet, valid);
+  }
+
+  DispatchMode MathReceiver ::
+    getDispatchMode()
+  {
+    return this->m_dispatchMode.load(std::memory_order_relaxed);
+  }
+
+  DispatchMode MathReceiver ::
+    readDispatchMode()
+  {
+    Fw::ParamValid valid;
+    const DispatchMode mode = this->readParam(&MathReceiver::paramGet_DISPATCH_MODE, valid);
+    return (valid.e == Fw::ParamValid::DEFAULT) ? this->m_defaultDispatchMode : mode;
+  }
+
+  F32 MathReceiver ::
+    getFactor()
+  {
+    return this->m_factor.load(std::memory_order_relaxed);
+  }
+
+  F32 MathReceiver ::
+    readFactor()
+  {
+    return this->readParam(&MathReceiver::paramGet_FACTOR);
+  }
+
+  U32 MathReceiver ::
+    getTickMessageBudget()
+  {
+    return this->readParam(&MathReceiver::paramGet_TICK_MESSAGE_BUDGET);
+  }
+
+  U32 MathReceiver ::
+    getTickTimeBudget()
+  {
+    return this->readParam(&MathReceiver::paramGet_TICK_TIME_BUDGET_US);
+  }
+
+  U32 MathReceiver ::
+    getUrgentBurst()
+  {
+    return this->readParam(&MathReceiver::paramGet_URGENT_BURST);
+  }
+
+  void MathReceiver ::
+    announceRequest()
+  {
+    // Stamp the request before it enters the queue so the handler can report the wait
+    const Fw::Time now = this->getTime();
+    this->m_waitLock.lock();
+    this->m_enqueueTimes[this->m_enqueueCount % MAX_TRACKED_REQUESTS] = now;
+    this->m_enqueueCount++;
+    this->m_waitLock.unLock();
+
+    if (this->getDispatchMode() == DispatchMode::EVENT_DRIVEN) {
+        this->wakeDispatchTask();
+    }
+  }
+
+  EventMode MathReceiver ::
+    getEventMode()
+  {
+    return this->m_eventMode.load(std::memory_order_relaxed);
+  }
+
+  EventMode MathReceiver ::
+    readEventMode()
+  {
+    return this->readParam(&MathReceiver::paramGet_EVENT_MODE);
+  }
+
+  U32 MathReceiver ::
+    getSummaryInterval()
+  {
+    return this->readParam(&MathReceiver::paramGet_SUMMARY_INTERVAL);
+  }
+
+  void MathReceiver ::
+    publishSummary()
+  {
+    this->m_summaryTicks++;
+    if (this->m_summaryTicks < this->getSummaryInterval()) {
+        return;
+    }
+    OpCounts counts;
+    bool performed = false;
+    for (U32 i = 0; i < MathOp::NUM_CONSTANTS; i++) {
+        counts[i] = this->m_summaryCounts[i];
+        performed = performed || (counts[i] > 0);
+        this->m_summaryCounts[i] = 0;
+    }
+    // Idle intervals are not reported
+    if (performed) {
+        this->log_ACTIVITY_HI_OPERATIONS_SUMMARY(this->m_summaryTicks, counts);
+    }
+    this->m_summaryTicks = 0;
+  }
+
+  void MathReceiver ::
+    wakeDispatchTask()
+  {
+    if (!this->m_dispatchTaskStarted) {
+        return;
+    }
+    const U8 token = WAKE_DISPATCH;
+    // A full wakeup queue means the task is already due to drain
+    (void) this->m_wakeQueue.send(&token, sizeof(token), 0, Os::Queue::NONBLOCKING);
+  }
+
+  void MathReceiver ::
+    dispatchPending()
+  {
+    const U32 burst = this->getUrgentBurst();
+    this->m_dispatchLock.lock();
+    this->m_draining = true;
+    const Fw::Time served = this->getTime();
+    U32 dispatched = 0;
+    while (true) {
+        const bool bulkWaiting = (this->m_queue.getMessagesAvailable() > 0) || (this->m_ring.size() > 0);
+        const U32 urgent = this->serveUrgent(STAGE_CAPACITY, bulkWaiting, burst);
+        if (urgent > 0) {
+            dispatched += urgent;
+            continue;
+        }
+        this->m_urgentRun = 0;
+        if (this->doDispatch() != Fw::QueuedComponentBase::MSG_DISPATCH_EMPTY) {
+            dispatched++;
+            continue;
+        }
+        // Ring requests are staged alongside the queued ones
+        const U32 drained = this->drainRing(STAGE_CAPACITY);
+        dispatched += drained;
+        if ((drained == 0) && (this->m_urgentRing.size() == 0)) {
+            break;
+        }
+    }
+    this->flushStaged();
+    const U32 busyUs = LatencyHistogram::elapsedUs(served, this->getTime());
+    this->failDropped();
+    this->grantCredits();
+    this->m_draining = false;
+    this->m_dispatchLock.unLock();
+    if (dispatched > 0) {
+        this->reportBusy(busyUs);
+    }
+  }
+
+  void MathReceiver ::
+    reportBusy(U32 busyUs)
+  {
+    if (this->isConnected_busyOut_OutputPort(0)) {
+        this->busyOut_out(0, busyUs);
+    }
+  }
+
+  bool MathReceiver ::
+    requestsPending()
+  {
+    this->m_waitLock.lock();
+    const bool pending = (this->m_enqueueCount != this->m_dequeueCount);
+    this->m_waitLock.unLock();
+    return pending;
+  }
+
+  void MathReceiver ::
+    syncMemo()
+  {
+    const U32 generation = this->m_memoGeneration.load();
+    if (generation != this->m_memoClearedGeneration) {
+        this->m_memo.clear();
+        this->m_memoClearedGeneration = generation;
+    }
+  }
+
+  void MathReceiver ::
+    stageOperation(
+        U32 requestId,
+        F32 val1,
+        const MathModule::MathOp &op,
+        F32 val2,
+        const Fw::Time& dequeued,
+        bool urgent
+    )
+  {
+    FW_ASSERT(op.isValid(), op.e);
+    if (this->m_stagedCount == STAGE_CAPACITY) {
+        this->flushStaged();
+    }
+    // Remember where the request landed so results keep arrival order
+    this->m_stagedIds[this->m_stagedCount] = requestId;
+    this->m_stagedOps[this->m_stagedCount] = op.e;
+    this->m_stagedF64[this->m_stagedCount] = false;
+    this->m_stagedUrgent[this->m_stagedCount] = urgent;
+    // A repeated request takes its result from the memo cache
+    if (this->m_memo.isEnabled()) {
+        this->syncMemo();
+        this->m_tlmMemoDirty = true;
+        if (this->m_memo.lookup(val1, static_cast<U8>(op.e), val2, this->getFactor(),
+                                this->m_stagedResults[this->m_stagedCount])) {
+            this->m_stagedSlots[this->m_stagedCount] = MEMO_SLOT;
+            this->m_stagedStart[this->m_stagedCount] = dequeued;
+            this->m_stagedCount++;
+            return;
+        }
+    }
+    // Operands go to the structure-of-arrays group for their operation
+    StagedGroup<F32>& group = this->m_stagedGroups[op.e];
+    const U32 slot = group.count++;
+    group.val1[slot] = val1;
+    group.val2[slot] = val2;
+    this->m_stagedSlots[this->m_stagedCount] = static_cast<U16>(slot);
+    this->m_stagedStart[this->m_stagedCount] = dequeued;
+    this->m_stagedCount++;
+  }
+
+  void MathReceiver ::
+    stageOperationF64(
+        U32 requestId,
+        F64 val1,
+        const MathModule::MathOp &op,
+        F64 val2,
+        const Fw::Time& dequeued
+    )
+  {
+    FW_ASSERT(op.isValid(), op.e);
+    if (this->m_stagedCount == STAGE_CAPACITY) {
+        this->flushStaged();
+    }
+    // The memo cache holds single precision results only
+    StagedGroup<F64>& group = this->m_stagedGroupsF64[op.e];
+    const U32 slot = group.count++;
+    group.val1[slot] = val1;
+    group.val2[slot] = val2;
+    this->m_stagedIds[this->m_stagedCount] = requestId;
+    this->m_stagedOps[this->m_stagedCount] = op.e;
+    this->m_stagedF64[this->m_stagedCount] = true;
+    this->m_stagedUrgent[this->m_stagedCount] = false;
+    this->m_stagedSlots[this->m_stagedCount] = static_cast<U16>(slot);
+    this->m_stagedStart[this->m_stagedCount] = dequeued;
+    this->m_stagedCount++;
+  }
+
+  U32 MathReceiver ::
+    vectorElements(const Fw::Buffer& buffer)
+  {
+    const PlatformPointerCastType address = reinterpret_cast<PlatformPointerCastType>(buffer.getData());
+    if ((buffer.getData() == nullptr) ||
+        ((buffer.getSize() % sizeof(F32)) != 0) ||
+        ((address % alignof(F32)) != 0)) {
+        return 0;
+    }
+    return static_cast<U32>(buffer.getSize() / sizeof(F32));
+  }
+
+  void MathReceiver ::
+    rejectVector(
+        U32 requestId,
+        VectorStatus::T status,
+        Fw::Buffer& result
+    )
+  {
+    this->log_WARNING_LO_VECTOR_REJECTED(requestId, status);
+    this->vectorResultOut_out(0, requestId, status, 0, result);
+  }
+
+  void MathReceiver ::
+    flushStaged()
+  {
+    if (this->m_stagedCount == 0) {
+        return;
+    }
+
+    // Evaluate each operation group with one kernel call
+    const F32 factor = this->getFactor();
+    for (U32 i = 0; i < MathOp::NUM_CONSTANTS; i++) {
+        this->m_stagedGroups[i].evaluate(static_cast<MathOp::T>(i), factor);
+        this->m_stagedGroupsF64[i].evaluate(static_cast<MathOp::T>(i), static_cast<F64>(factor));
+    }
+
+    // Emit telemetry, events and results in arrival order
+    for (U32 i = 0; i < this->m_stagedCount; i++) {
+        const MathOp op = this->m_stagedOps[i];
+        const StagedGroup<F32>& group = this->m_stagedGroups[op.e];
+        const StagedGroup<F64>& groupF64 = this->m_stagedGroupsF64[op.e];
+        const U32 slot = this->m_stagedSlots[i];
+        const bool isF64 = this->m_stagedF64[i];
+        F32 result = 0;
+
+        if (isF64) {
+            if ((op.e == MathOp::DIV) && (groupF64.val2[slot] == 0)) {
+                this->log_ACTIVITY_HI_DIVIDE_BY_ZERO();
+            }
+        } else if (slot == MEMO_SLOT) {
+            result = this->m_stagedResults[i];
+        } else if ((op.e == MathOp::DIV) && (group.val2[slot] == 0)) {
+            // Not cached, so every zero denominator is reported
+            result = group.result[slot];
+            this->log_ACTIVITY_HI_DIVIDE_BY_ZERO();
+        } else {
+            result = group.result[slot];
+            this->m_memo.insert(group.val1[slot], static_cast<U8>(op.e), group.val2[slot], factor, result);
+        }
+
+        // Increment number of math ops 
+        numMathOps++;  
+
+        // Emit telemetry and events; summaries go out from schedIn
+        if (this->getEventMode() == EventMode::PER_OP) {
+            this->log_ACTIVITY_HI_OPERATION_PERFORMED(op);
+        } else {
+            this->m_summaryCounts[op.e]++;
+        }
+        this->m_tlmOperation = op.e;
+        this->m_tlmOpsDirty = true;
+
+        // Emit result
+        if (isF64) {
+            this->mathResultF64Out_out(0, this->m_stagedIds[i], groupF64.result[slot]);
+        } else if (this->m_stagedUrgent[i]) {
+            this->mathResultUrgentOut_out(0, this->m_stagedIds[i], result);
+        } else {
+            this->mathResultOut_out(0, this->m_stagedIds[i], result);
+        }
+        this->m_serviceLatency[op.e].record(
+            LatencyHistogram::elapsedUs(this->m_stagedStart[i], this->getTime())
+        );
+    }
+    this->m_latencyUpdated = true;
+
+    for (U32 i = 0; i < MathOp::NUM_CONSTANTS; i++) {
+        this->m_stagedGroups[i].count = 0;
+        this->m_stagedGroupsF64[i].count = 0;
+    }
+    this->m_stagedCount = 0;
+  }
+
+  U32 MathReceiver ::
+    getRequestCredits()
+  {
+    return this->readParam(&MathReceiver::paramGet_REQUEST_CREDITS);
+  }
+
+  void MathReceiver ::
+    grantCredits()
+  {
+    if (!this->isConnected_creditOut_OutputPort(0)) {
+        return;
+    }
+    // Requests dropped on overflow never reach the handler to return their credits
+    this->m_pendingLock.lock();
+    const U32 drops = this->m_queueDrops;
+    this->m_pendingLock.unLock();
+    this->m_creditsOutstanding -= static_cast<I32>(drops - this->m_creditDropsSeen);
+    this->m_creditDropsSeen = drops;
+
+    // Top the sender back up to the limit; a lowered limit takes effect as requests drain.
+    // Requests sent without a credit earn one back too, and the router keeps those
+    const I32 limit = static_cast<I32>(this->getRequestCredits());
+    if (this->m_creditsOutstanding < limit) {
+        this->creditOut_out(0, static_cast<U32>(limit - this->m_creditsOutstanding));
+        this->m_creditsOutstanding = limit;
+    }
+  }
+
+  void MathReceiver ::
+    keepDropped(U32 requestId)
+  {
+    this->m_queueDrops++;
+    // Beyond the capacity a dropped request times out at its sender instead
+    if (this->m_droppedCount < DROPPED_CAPACITY) {
+        this->m_droppedIds[this->m_droppedCount] = requestId;
+        this->m_droppedCount++;
+    }
+  }
+
+  void MathReceiver ::
+    failDropped()
+  {
+    U32 requestIds[DROPPED_CAPACITY];
+    this->m_pendingLock.lock();
+    const U32 count = this->m_droppedCount;
+    (void) memcpy(requestIds, this->m_droppedIds, count * sizeof(requestIds[0]));
+    this->m_droppedCount = 0;
+    this->m_pendingLock.unLock();
+    // A NaN result tells the sender the request was not performed, so its slot frees now
+    const F32 failed = std::numeric_limits<F32>::quiet_NaN();
+    for (U32 i = 0; i < count; i++) {
+        this->log_WARNING_LO_REQUEST_DROPPED(requestIds[i]);
+        this->mathResultOut_out(0, requestIds[i], failed);
+    }
+  }
+
+  OverflowPolicy MathReceiver ::
+    getOverflowPolicy()
+  {
+    return this->m_overflowPolicy.load(std::memory_order_relaxed);
+  }
+
+  OverflowPolicy MathReceiver ::
+    readOverflowPolicy()
+  {
+    return this->readParam(&MathReceiver::paramGet_OVERFLOW_POLICY);
+  }
+
+  U32 MathReceiver ::
+    getFileOpsPerTick()
+  {
+    return this->readParam(&MathReceiver::paramGet_FILE_OPS_PER_TICK);
+  }
+
+  void MathReceiver ::
+    processFile()
+  {
+    FileJob& job = this->m_fileJob;
+    if (!job.active) {
+        return;
+    }
+    const U32 budget = this->getFileOpsPerTick();
+    const F32 factor = this->getFactor();
+    const U8* const pairs = this->m_fileIn.getData();
+    U32 processed = 0;
+    while ((processed < budget) && (job.done < job.total)) {
+        const U32 count = FW_MIN(static_cast<U32>(FILE_CHUNK),
+                                 FW_MIN(budget - processed, job.total - job.done));
+        // Split the interleaved pairs into the arrays the kernels take
+        const U8* pair = pairs + static_cast<FwSizeType>(job.done) * FILE_PAIR_SIZE;
+        for (U32 i = 0; i < count; i++, pair += FILE_PAIR_SIZE) {
+            (void) memcpy(&this->m_fileVal1[i], pair, sizeof(F32));
+            (void) memcpy(&this->m_fileVal2[i], pair + sizeof(F32), sizeof(F32));
+        }
+        job.zeros += MathKernels::evaluate(
+            job.op, this->m_fileVal1, this->m_fileVal2, this->m_fileResults, count, factor
+        );
+
+        const FwSignedSizeType bytes = static_cast<FwSignedSizeType>(count * sizeof(F32));
+        FwSignedSizeType written = bytes;
+        if ((this->m_fileOut.write(reinterpret_cast<const U8*>(this->m_fileResults), written,
+                                   Os::File::WAIT) != Os::File::OP_OK) ||
+            (written != bytes)) {
+            this->log_WARNING_HI_FILE_FAILED(MathFileError::WRITE_FAILED);
+            this->finishFile(Fw::CmdResponse::EXECUTION_ERROR);
+            return;
+        }
+        this->m_fileCrc.update(this->m_fileResults, static_cast<NATIVE_INT_TYPE>(bytes));
+        job.done += count;
+        processed += count;
+    }
+
+    // Throughput over the whole tick period, not just the time spent here
+    const Fw::Time now = this->getTime();
+    const U32 periodUs = LatencyHistogram::elapsedUs(job.lastTick, now);
+    job.lastTick = now;
+    if (periodUs > 0) {
+        this->tlmWrite_FILE_OPS_PER_SEC(
+            static_cast<U32>((static_cast<U64>(processed) * 1000000U) / periodUs)
+        );
+    }
+    this->tlmWrite_FILE_OPS_DONE(job.done);
+    this->tlmWrite_FILE_PROGRESS_PCT(
+        static_cast<U8>((static_cast<U64>(job.done) * 100U) / job.total)
+    );
+    if (job.done < job.total) {
+        return;
+    }
+
+    // The trailer is in host byte order, like the results
+    U32 crc = 0;
+    this->m_fileCrc.final(crc);
+    FwSignedSizeType written = sizeof(crc);
+    if ((this->m_fileOut.write(reinterpret_cast<const U8*>(&crc), written,
+                               Os::File::WAIT) != Os::File::OP_OK) ||
+        (written != static_cast<FwSignedSizeType>(sizeof(crc)))) {
+        this->log_WARNING_HI_FILE_FAILED(MathFileError::WRITE_FAILED);
+        this->finishFile(Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+    this->log_ACTIVITY_HI_FILE_COMPLETED(job.done, job.zeros, crc);
+    this->finishFile(Fw::CmdResponse::OK);
+  }
+
+  void MathReceiver ::
+    finishFile(Fw::CmdResponse response)
+  {
+    FW_ASSERT(this->m_fileJob.active);
+    this->m_fileIn.close();
+    this->m_fileOut.close();
+    this->m_fileJob.active = false;
+    this->cmdResponse_out(this->m_fileJob.opCode, this->m_fileJob.cmdSeq, response);
+  }
+
+  Fw::Time MathReceiver ::
+    recordQueueWait(MathOp::T op)
+  {
+    FW_ASSERT(op < MathOp::NUM_CONSTANTS, op);
+    const Fw::Time now = this->getTime();
+    this->m_waitLock.lock();
+    const U32 sequence = this->m_dequeueCount++;
+    // Slots are reused once more than MAX_TRACKED_REQUESTS requests are queued
+    const bool tracked = (this->m_enqueueCount - sequence) <= MAX_TRACKED_REQUESTS;
+    const Fw::Time enqueued = this->m_enqueueTimes[sequence % MAX_TRACKED_REQUESTS];
+    this->m_waitLock.unLock();
+
+    if (tracked) {
+        this->recordWait(op, enqueued, now);
+    }
+    return now;
+  }
+
+  void MathReceiver ::
+    recordWait(
+        MathOp::T op,
+        const Fw::Time& enqueued,
+        const Fw::Time& dequeued
+    )
+  {
+    const U32 waitUs = LatencyHistogram::elapsedUs(enqueued, dequeued);
+    this->m_tlmQueueWaitUs = waitUs;
+    this->m_tlmQueueWaitDirty = true;
+    this->m_queueWaitLatency[op].record(waitUs);
+    this->m_bulkWait.record(waitUs);
+    this->m_latencyUpdated = true;
+  }
+
+  U32 MathReceiver ::
+    drainRing(U32 maxRecords)
+  {
+    const U32 count = this->m_ring.pop(
+        this->m_ringBatch, FW_MIN(maxRecords, static_cast<U32>(STAGE_CAPACITY))
+    );
+    const Fw::Time now = (count > 0) ? this->getTime() : Fw::Time();
+    for (U32 i = 0; i < count; i++) {
+        const RingRecord& record = this->m_ringBatch[i];
+        this->recordWait(record.op, record.enqueued, now);
+        this->stageOperation(record.requestId, record.val1, record.op, record.val2, now);
+    }
+    return count;
+  }
+
+  U32 MathReceiver ::
+    serveUrgent(
+        U32 maxRecords,
+        bool bulkWaiting,
+        U32 burst
+    )
+  {
+    U32 allowance = FW_MIN(maxRecords, static_cast<U32>(STAGE_CAPACITY));
+    if (bulkWaiting && (burst > 0)) {
+        // Starvation guard: the bulk lane gets a turn after each burst
+        allowance = FW_MIN(allowance, (this->m_urgentRun < burst) ? (burst - this->m_urgentRun) : 0);
+    }
+    const U32 count = this->m_urgentRing.pop(this->m_ringBatch, allowance);
+    if (count == 0) {
+        return 0;
+    }
+    const Fw::Time now = this->getTime();
+    for (U32 i = 0; i < count; i++) {
+        const RingRecord& record = this->m_ringBatch[i];
+        this->m_urgentWait.record(LatencyHistogram::elapsedUs(record.enqueued, now));
+        this->stageOperation(record.requestId, record.val1, record.op, record.val2, now, true);
+    }
+    this->m_latencyUpdated = true;
+    // Urgent results leave before any more bulk work is done
+    this->flushStaged();
+    if (bulkWaiting) {
+        this->m_urgentRun += count;
+    }
+    return count;
+  }
+
+  bool MathReceiver ::
+    budgetSpent(
+        U32 dispatched,
+        U32 messageBudget,
+        U32 timeBudget,
+        const Fw::Time& start
+    )
+  {
+    if ((messageBudget > 0) && (dispatched >= messageBudget)) {
+        return true;
+    }
+    // At least one message goes through each tick
+    return (timeBudget > 0) && (dispatched > 0) &&
+           (LatencyHistogram::elapsedUs(start, this->getTime()) >= timeBudget);
+  }
+
+  void MathReceiver ::
+    publishLatency()
+  {
+    if (!this->m_latencyUpdated) {
+        return;
+    }
+    OpLatency queueWait;
+    OpLatency service;
+    for (U32 i = 0; i < MathOp::NUM_CONSTANTS; i++) {
+        const LatencyHistogram& wait = this->m_queueWaitLatency[i];
+        const LatencyHistogram& serv = this->m_serviceLatency[i];
+        queueWait[i] = LatencySummary(wait.getCount(), wait.percentile(50), wait.percentile(99), wait.getMax());
+        service[i] = LatencySummary(serv.getCount(), serv.percentile(50), serv.percentile(99), serv.getMax());
+    }
+    this->tlmWrite_QUEUE_WAIT_LATENCY(queueWait);
+    this->tlmWrite_SERVICE_LATENCY(service);
+    const LatencyHistogram& urgent = this->m_urgentWait;
+    const LatencyHistogram& bulk = this->m_bulkWait;
+    this->tlmWrite_URGENT_WAIT(
+        LatencySummary(urgent.getCount(), urgent.percentile(50), urgent.percentile(99), urgent.getMax())
+    );
+    this->tlmWrite_BULK_WAIT(
+        LatencySummary(bulk.getCount(), bulk.percentile(50), bulk.percentile(99), bulk.getMax())
+    );
+    this->m_latencyUpdated = false;
+  }
+
+  void MathReceiver ::
+    publishTelemetry()
+  {
+    // Only the latest values survive a downlink cycle
+    if (this->m_tlmOpsDirty) {
+        this->tlmWrite_OPERATION(this->m_tlmOperation);
+        this->tlmWrite_NUMBER_OF_OPS(this->numMathOps);
+        this->m_tlmOpsDirty = false;
+    }
+    if (this->m_tlmQueueWaitDirty) {
+        this->tlmWrite_QUEUE_WAIT_US(this->m_tlmQueueWaitUs);
+        this->m_tlmQueueWaitDirty = false;
+    }
+    if (this->m_tlmMemoDirty) {
+        this->tlmWrite_MEMO_HITS(this->m_memo.getHits());
+        this->tlmWrite_MEMO_MISSES(this->m_memo.getMisses());
+        this->tlmWrite_MEMO_EVICTIONS(this->m_memo.getEvictions());
+        this->m_tlmMemoDirty = false;
+    }
+    if (this->m_tlmExprDirty) {
+        this->tlmWrite_EXPR_CACHE_HITS(this->m_exprCache.getHits());
+        this->tlmWrite_EXPR_CACHE_MISSES(this->m_exprCache.getMisses());
+        this->m_tlmExprDirty = false;
+    }
+    this->m_pendingLock.lock();
+    const U32 drops = this->m_queueDrops;
+    const U32 coalesced = this->m_queueCoalesced;
+    this->m_pendingLock.unLock();
+    if (drops != this->m_tlmQueueDrops) {
+        this->tlmWrite_QUEUE_DROPS(drops);
+        this->m_tlmQueueDrops = drops;
+    }
+    if (coalesced != this->m_tlmQueueCoalesced) {
+        this->tlmWrite_QUEUE_COALESCED(coalesced);
+        this->m_tlmQueueCoalesced = coalesced;
+    }
+    const U32 recorded = this->m_recorder.getRecorded();
+    const U32 recordDrops = this->m_recorder.getDropped();
+    if (recorded != this->m_tlmRecorded) {
+        this->tlmWrite_RECORDED_REQUESTS(recorded);
+        this->m_tlmRecorded = recorded;
+    }
+    if (recordDrops != this->m_tlmRecordDrops) {
+        this->tlmWrite_RECORD_DROPS(recordDrops);
+        this->m_tlmRecordDrops = recordDrops;
+    }
+  }
+
+  void MathReceiver ::
+    dumpHistogram(
+        LatencyStage::T stage,
+        MathOp::T op,
+        const LatencyHistogram& histogram
+    )
+  {
+    if (histogram.getCount() == 0) {
+        return;
+    }
+    const LatencySummary summary(
+        histogram.getCount(), histogram.percentile(50), histogram.percentile(99), histogram.getMax()
+    );
+    LatencyBuckets buckets;
+    for (U32 i = 0; i < LatencyBuckets::SIZE; i++) {
+        buckets[i] = histogram.getBucket(i);
+    }
+    this->log_ACTIVITY_LO_LATENCY_HISTOGRAM(stage, op, summary, buckets);
+  }
+
 } // end namespace MathModule
@@ -8,6 +8,21 @@
 #define MathReceiver_HPP
 
 #include "Components/MathReceiver/MathReceiverComponentAc.hpp"
+#include <Components/MathReceiver/MathExpr.hpp>
+#include <Components/MathReceiver/MathKernels.hpp>
+#include <Components/MathUtils/LatencyHistogram.hpp>
+#include <Components/MathUtils/MappedFile.hpp>
+#include <Components/MathUtils/MemoCache.hpp>
+#include <Components/MathUtils/PendingQueue.hpp>
+#include <Components/MathUtils/RequestRecorder.hpp>
+#include <Components/MathUtils/SpscRing.hpp>
+#include <Fw/Types/MemAllocator.hpp>
+#include <Os/File.hpp>
+#include <Os/Mutex.hpp>
+#include <Os/Queue.hpp>
+#include <Os/Task.hpp>
+#include <Utils/Hash/Hash.hpp>
+#include <atomic>
 
 namespace MathModule {
 
@@ -27,20 +42,138 @@ namespace MathModule {
           const char *const compName /*!< The component name*/
       );
 
+      //! Initialize object MathReceiver
+      //!
+      //! The queue holds at most MAX_QUEUE_DEPTH messages, so every queued
+      //! mathOpIn request fits in the pending queue.
+      void init(
+          const NATIVE_INT_TYPE queueDepth, /*!< The queue depth*/
+          const NATIVE_INT_TYPE instance = 0 /*!< The instance number*/
+      );
+
       //! Destroy object MathReceiver
       //!
       ~MathReceiver();
 
+      //! Start the task that drains the queue in EVENT_DRIVEN mode
+      //!
+      void startDispatchTask(
+          FwSizeType priority, /*!< The task priority*/
+          FwSizeType stackSize /*!< The task stack size*/
+      );
+
+      //! Stop and join the dispatch task
+      //!
+      //! In EVENT_DRIVEN mode the task drains the queue once more before it
+      //! exits, so call this while the result consumers still run.
+      void stopDispatchTask();
+
+      //! Set the dispatch mode used while DISPATCH_MODE holds no stored value
+      //!
+      //! Call before loadParameters. A value loaded from the parameter database
+      //! or set by command takes precedence.
+      void setDefaultDispatchMode(
+          DispatchMode mode /*!< The dispatch mode*/
+      );
+
+      //! Allocate the memo cache that answers repeated requests without recomputing them
+      //!
+      //! The cache is off until this is called. Call before the component starts handling requests.
+      void allocateMemo(
+          NATIVE_UINT_TYPE identifier, /*!< The memory segment identifier*/
+          Fw::MemAllocator& allocator, /*!< The allocator for the cache entries*/
+          U32 entries /*!< The number of entries; rounded down to a power of two*/
+      );
+
+      //! Return the memo cache memory to the allocator
+      //!
+      void deallocateMemo(
+          Fw::MemAllocator& allocator /*!< The allocator passed to allocateMemo*/
+      );
+
     PRIVATE:
 
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      enum {
+        //! Number of queued requests whose enqueue time is tracked
+        MAX_TRACKED_REQUESTS = 64,
+        //! Largest queue depth; the rest of the pending queue covers callers between hooks
+        MAX_QUEUE_DEPTH = PendingQueue::CAPACITY - 8,
+        //! Number of single requests staged before they are evaluated
+        STAGE_CAPACITY = MathBatch::SIZE,
+        //! Number of records the mathOpRingIn ring holds
+        RING_CAPACITY = 64,
+        //! Number of records the mathOpUrgentIn lane holds
+        URGENT_CAPACITY = 16,
+        //! Number of dropped mathOpIn requests that can wait for their failure result
+        DROPPED_CAPACITY = 4 * PendingQueue::CAPACITY,
+        //! Staged slot of a request answered by the memo cache
+        MEMO_SLOT = 0xFFFF,
+        //! Operand pairs of a DO_MATH_FILE evaluated by one kernel call
+        FILE_CHUNK = 1024,
+        //! Bytes of one operand pair in a DO_MATH_FILE operand file
+        FILE_PAIR_SIZE = 2 * sizeof(F32)
+      };
+
+      //! State of the running DO_MATH_FILE command
+      struct FileJob {
+        bool active; //!< Whether a command is running
+        FwOpcodeType opCode; //!< The opcode of the command
+        U32 cmdSeq; //!< The sequence number of the command
+        MathOp::T op; //!< The operation
+        U32 total; //!< The number of operand pairs in the file
+        U32 done; //!< The number of results written
+        U32 zeros; //!< The number of zero denominators
+        Fw::Time lastTick; //!< When the previous tick finished its share
+      };
+
+      //! A request passed through the ring
+      struct RingRecord {
+        U32 requestId; //!< The identifier of the request
+        F32 val1; //!< The first operand
+        F32 val2; //!< The second operand
+        MathOp::T op; //!< The operation
+        Fw::Time enqueued; //!< When the request entered the ring
+      };
+
+      //! Staged operands for one operation, in structure-of-arrays form
+      template <typename T>
+      struct StagedGroup {
+        T val1[STAGE_CAPACITY]; //!< The first operands
+        T val2[STAGE_CAPACITY]; //!< The second operands
+        T result[STAGE_CAPACITY]; //!< The results
+        U32 count; //!< The number of staged operand pairs
+
+        //! Evaluate the staged operand pairs with one kernel call
+        void evaluate(MathOp::T op, T factor) {
+            if (this->count > 0) {
+                (void) MathKernels::evaluate(op, this->val1, this->val2, this->result, this->count, factor);
+            }
+        }
+      };
+
+      //! Wakeup tokens sent to the dispatch task
+      enum WakeToken : U8 {
+        WAKE_DISPATCH,
+        WAKE_STOP
+      };
+
       // ----------------------------------------------------------------------
       // Handler implementations for user-defined typed input ports
       // ----------------------------------------------------------------------
       void parameterUpdated(FwPrmIdType id);
+
+      //! Refresh the cached parameters once loadParameters has run
+      void parametersLoaded();
+
       //! Handler implementation for mathOpIn
       //!
       void mathOpIn_handler(
           const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< Identifies the request in the matching result*/
           F32 val1, /*!< 
       The first operand
       */
@@ -52,6 +185,128 @@ namespace MathModule {
       */
       );
 
+      //! Pre-message hook for mathOpIn
+      //! Runs on the caller's thread before the request is enqueued
+      void mathOpIn_preMsgHook(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< Identifies the request in the matching result*/
+          F32 val1, /*!< The first operand*/
+          const MathModule::MathOp &op, /*!< The operation*/
+          F32 val2 /*!< The second operand*/
+      );
+
+      //! Overflow hook for mathOpIn
+      //! Runs on the caller's thread when the request finds the queue full
+      void mathOpIn_overflowHook(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< Identifies the request in the matching result*/
+          F32 val1, /*!< The first operand*/
+          const MathModule::MathOp &op, /*!< The operation*/
+          F32 val2 /*!< The second operand*/
+      );
+
+      //! Handler implementation for mathOpF64In
+      //!
+      void mathOpF64In_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< Identifies the request in the matching result*/
+          F64 val1, /*!< The first operand*/
+          const MathModule::MathOp &op, /*!< The operation*/
+          F64 val2 /*!< The second operand*/
+      );
+
+      //! Pre-message hook for mathOpF64In
+      //! Runs on the caller's thread before the request is enqueued
+      void mathOpF64In_preMsgHook(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< Identifies the request in the matching result*/
+          F64 val1, /*!< The first operand*/
+          const MathModule::MathOp &op, /*!< The operation*/
+          F64 val2 /*!< The second operand*/
+      );
+
+      //! Handler implementation for mathOpRingIn
+      //! Runs on the caller's thread and only adds the request to the ring
+      void mathOpRingIn_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< Identifies the request in the matching result*/
+          F32 val1, /*!< The first operand*/
+          const MathModule::MathOp &op, /*!< The operation*/
+          F32 val2 /*!< The second operand*/
+      );
+
+      //! Handler implementation for mathOpUrgentIn
+      //! Runs on the caller's thread and only adds the request to the urgent lane
+      void mathOpUrgentIn_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< Identifies the request in the matching result*/
+          F32 val1, /*!< The first operand*/
+          const MathModule::MathOp &op, /*!< The operation*/
+          F32 val2 /*!< The second operand*/
+      );
+
+      //! Handler implementation for mathBatchIn
+      //!
+      void mathBatchIn_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< Identifies the request in the matching result*/
+          const MathModule::MathOp &op, /*!< The operation*/
+          U32 count, /*!< The number of valid operand pairs*/
+          const MathModule::MathBatch &val1, /*!< The first operands*/
+          const MathModule::MathBatch &val2 /*!< The second operands*/
+      );
+
+      //! Pre-message hook for mathBatchIn
+      //! Runs on the caller's thread before the batch is enqueued
+      void mathBatchIn_preMsgHook(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< Identifies the request in the matching result*/
+          const MathModule::MathOp &op, /*!< The operation*/
+          U32 count, /*!< The number of valid operand pairs*/
+          const MathModule::MathBatch &val1, /*!< The first operands*/
+          const MathModule::MathBatch &val2 /*!< The second operands*/
+      );
+
+      //! Handler implementation for vectorIn
+      //! Operates on the buffer memory in place; nothing but the descriptors is queued
+      void vectorIn_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< Identifies the request in the matching result*/
+          const MathModule::MathOp &op, /*!< The operation*/
+          Fw::Buffer &val1, /*!< The first operands*/
+          Fw::Buffer &val2, /*!< The second operands*/
+          Fw::Buffer &result /*!< Receives the results; no data means in place*/
+      );
+
+      //! Pre-message hook for vectorIn
+      //! Runs on the caller's thread before the request is enqueued
+      void vectorIn_preMsgHook(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< Identifies the request in the matching result*/
+          const MathModule::MathOp &op, /*!< The operation*/
+          Fw::Buffer &val1, /*!< The first operands*/
+          Fw::Buffer &val2, /*!< The second operands*/
+          Fw::Buffer &result /*!< Receives the results; no data means in place*/
+      );
+
+      //! Handler implementation for exprIn
+      //!
+      void exprIn_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< Identifies the request in the matching result*/
+          const Fw::StringBase &expr, /*!< The expression over a, b, c and d*/
+          const MathModule::ExprVars &vars /*!< The values of the variables*/
+      );
+
+      //! Pre-message hook for exprIn
+      //! Runs on the caller's thread before the expression is enqueued
+      void exprIn_preMsgHook(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< Identifies the request in the matching result*/
+          const Fw::StringBase &expr, /*!< The expression over a, b, c and d*/
+          const MathModule::ExprVars &vars /*!< The values of the variables*/
+      );
+
       //! Handler implementation for schedIn
       //!
       void schedIn_handler(
@@ -74,6 +329,245 @@ namespace MathModule {
           const U32 cmdSeq /*!< The command sequence number*/
       );
 
+      //! Implementation for DUMP_LATENCY command handler
+      //! Dump the latency histograms as events and reset them
+      void DUMP_LATENCY_cmdHandler(
+          const FwOpcodeType opCode, /*!< The opcode*/
+          const U32 cmdSeq /*!< The command sequence number*/
+      );
+
+      //! Implementation for DO_MATH_FILE command handler
+      //! Evaluate every operand pair of a file, a few thousand per tick, into a result file
+      void DO_MATH_FILE_cmdHandler(
+          const FwOpcodeType opCode, /*!< The opcode*/
+          const U32 cmdSeq, /*!< The command sequence number*/
+          const Fw::CmdStringArg& inputPath, /*!< F32 operand pairs in host byte order*/
+          MathModule::MathOp op, /*!< The operation*/
+          const Fw::CmdStringArg& outputPath /*!< Receives the F32 results and their CRC-32*/
+      );
+
+      //! Implementation for CANCEL_MATH_FILE command handler
+      //! Stop the running DO_MATH_FILE command
+      void CANCEL_MATH_FILE_cmdHandler(
+          const FwOpcodeType opCode, /*!< The opcode*/
+          const U32 cmdSeq /*!< The command sequence number*/
+      );
+
+      //! Implementation for START_RECORDING command handler
+      //! Record every mathOpIn request and its arrival time to a log for MathReplay
+      void START_RECORDING_cmdHandler(
+          const FwOpcodeType opCode, /*!< The opcode*/
+          const U32 cmdSeq, /*!< The command sequence number*/
+          const Fw::CmdStringArg& path, /*!< Receives the request log*/
+          U32 maxRecords /*!< The most requests to record*/
+      );
+
+      //! Implementation for STOP_RECORDING command handler
+      //! Stop recording and complete the request log
+      void STOP_RECORDING_cmdHandler(
+          const FwOpcodeType opCode, /*!< The opcode*/
+          const U32 cmdSeq /*!< The command sequence number*/
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Dispatch helpers
+      // ----------------------------------------------------------------------
+
+      //! Entry point of the dispatch task
+      static void dispatchTaskRoutine(
+          void* arg /*!< The MathReceiver instance*/
+      );
+
+      //! Read a parameter, which must hold a stored or default value
+      template <typename T>
+      T readParam(
+          T (MathReceiverComponentBase::*paramGet)(Fw::ParamValid&), /*!< The paramGet_ function*/
+          Fw::ParamValid& valid /*!< Set to whether the value is stored or the default*/
+      );
+
+      //! Read a parameter, which must hold a stored or default value
+      template <typename T>
+      T readParam(
+          T (MathReceiverComponentBase::*paramGet)(Fw::ParamValid&) /*!< The paramGet_ function*/
+      );
+
+      //! Cached value of the DISPATCH_MODE parameter; takes no lock
+      DispatchMode getDispatchMode();
+
+      //! Read the DISPATCH_MODE parameter from the parameter store
+      DispatchMode readDispatchMode();
+
+      //! Cached value of the EVENT_MODE parameter; takes no lock
+      EventMode getEventMode();
+
+      //! Read the EVENT_MODE parameter from the parameter store
+      EventMode readEventMode();
+
+      //! Current value of the SUMMARY_INTERVAL parameter
+      U32 getSummaryInterval();
+
+      //! Emit the OPERATIONS_SUMMARY event when the summary interval ends
+      void publishSummary();
+
+      //! Wake the dispatch task, if it is running
+      void wakeDispatchTask();
+
+      //! Stamp a request about to be enqueued and wake the dispatch task if needed
+      void announceRequest();
+
+      //! Cached value of the FACTOR parameter; takes no lock
+      F32 getFactor();
+
+      //! Read the FACTOR parameter from the parameter store
+      F32 readFactor();
+
+      //! Current value of the TICK_MESSAGE_BUDGET parameter
+      U32 getTickMessageBudget();
+
+      //! Current value of the TICK_TIME_BUDGET_US parameter
+      U32 getTickTimeBudget();
+
+      //! Current value of the URGENT_BURST parameter
+      U32 getUrgentBurst();
+
+      //! Dispatch the messages queued now, under the dispatch lock
+      void dispatchPending();
+
+      //! Report the time a drain spent serving requests on busyOut
+      void reportBusy(
+          U32 busyUs /*!< Microseconds the drain took*/
+      );
+
+      //! Whether a math request has been announced but not yet handled
+      bool requestsPending();
+
+      //! Record the time the request being handled spent in the queue
+      //!
+      //! \return the time the request left the queue
+      Fw::Time recordQueueWait(
+          MathOp::T op /*!< The operation of the request*/
+      );
+
+      //! Record the time a request waited before being handled
+      void recordWait(
+          MathOp::T op, /*!< The operation of the request*/
+          const Fw::Time& enqueued, /*!< When the request was enqueued*/
+          const Fw::Time& dequeued /*!< When the request was dequeued*/
+      );
+
+      //! Stage up to maxRecords requests from the ring
+      //!
+      //! \return the number of requests taken from the ring
+      U32 drainRing(
+          U32 maxRecords /*!< The maximum number of requests to take*/
+      );
+
+      //! Stage and evaluate up to maxRecords requests from the urgent lane
+      //!
+      //! Once burst urgent requests have been served in a row while bulk
+      //! requests wait, the bulk lane gets the next turn.
+      //!
+      //! \return the number of requests taken from the urgent lane
+      U32 serveUrgent(
+          U32 maxRecords, /*!< The maximum number of requests to take*/
+          bool bulkWaiting, /*!< Whether queued messages or ring records are waiting*/
+          U32 burst /*!< The URGENT_BURST parameter*/
+      );
+
+      //! Whether the tick budget is spent
+      bool budgetSpent(
+          U32 dispatched, /*!< Messages dispatched so far this tick*/
+          U32 messageBudget, /*!< The message budget, 0 for none*/
+          U32 timeBudget, /*!< The time budget in microseconds, 0 for none*/
+          const Fw::Time& start /*!< When the tick started*/
+      );
+
+      //! Write the latency telemetry if new samples were recorded
+      void publishLatency();
+
+      //! Write the staged operation telemetry if it changed since the last tick
+      void publishTelemetry();
+
+      //! Emit one latency histogram as an event
+      void dumpHistogram(
+          LatencyStage::T stage, /*!< The measured stage*/
+          MathOp::T op, /*!< The operation*/
+          const LatencyHistogram& histogram /*!< The histogram*/
+      );
+
+      //! Empty the memo cache if FACTOR changed since it was last emptied
+      void syncMemo();
+
+      //! Stage a single request for evaluation with its operation group
+      void stageOperation(
+          U32 requestId, /*!< The identifier of the request*/
+          F32 val1, /*!< The first operand*/
+          const MathModule::MathOp &op, /*!< The operation*/
+          F32 val2, /*!< The second operand*/
+          const Fw::Time& dequeued, /*!< The time the request left the queue*/
+          bool urgent = false /*!< Whether the result goes to mathResultUrgentOut*/
+      );
+
+      //! Number of F32 elements a vectorIn buffer holds
+      //!
+      //! \return 0 if the buffer is empty, holds a partial element or is not aligned for F32
+      static U32 vectorElements(
+          const Fw::Buffer& buffer /*!< The buffer*/
+      );
+
+      //! Report a rejected vectorIn request and answer it with no results
+      void rejectVector(
+          U32 requestId, /*!< The identifier of the request*/
+          VectorStatus::T status, /*!< Why the request was rejected*/
+          Fw::Buffer& result /*!< The result buffer of the request, handed back unchanged*/
+      );
+
+      //! Stage a double precision request for evaluation with its operation group
+      void stageOperationF64(
+          U32 requestId, /*!< The identifier of the request*/
+          F64 val1, /*!< The first operand*/
+          const MathModule::MathOp &op, /*!< The operation*/
+          F64 val2, /*!< The second operand*/
+          const Fw::Time& dequeued /*!< The time the request left the queue*/
+      );
+
+      //! Evaluate staged requests and emit their results in arrival order
+      void flushStaged();
+
+      //! Current value of the REQUEST_CREDITS parameter
+      U32 getRequestCredits();
+
+      //! Grant the sender credits for the mathOpIn requests drained since the last grant
+      void grantCredits();
+
+      //! Count a mathOpIn request dropped by the overflow policy and keep it for failDropped
+      //!
+      //! Called with m_pendingLock held
+      void keepDropped(
+          U32 requestId /*!< The dropped request*/
+      );
+
+      //! Send a failure result for each mathOpIn request the overflow policy dropped
+      void failDropped();
+
+      //! Cached value of the OVERFLOW_POLICY parameter; takes no lock
+      OverflowPolicy getOverflowPolicy();
+
+      //! Read the OVERFLOW_POLICY parameter from the parameter store
+      OverflowPolicy readOverflowPolicy();
+
+      //! Current value of the FILE_OPS_PER_TICK parameter
+      U32 getFileOpsPerTick();
+
+      //! Evaluate the next share of the running DO_MATH_FILE command
+      void processFile();
+
+      //! Close the files of the DO_MATH_FILE command and send its response
+      void finishFile(
+          Fw::CmdResponse response /*!< The command response*/
+      );
 
     PRIVATE:
       // ----------------------------------------------------------------------
@@ -81,6 +575,222 @@ namespace MathModule {
       // ---------------------------------------------------------------------- 
     U32 numMathOps; 
 
+      //! Serializes queue dispatch between schedIn and the dispatch task
+      Os::Mutex m_dispatchLock;
+
+      //! Dispatch task used in EVENT_DRIVEN mode
+      Os::Task m_dispatchTask;
+
+      //! Wakeup queue for the dispatch task
+      Os::Queue m_wakeQueue;
+
+      //! Whether the dispatch task has been started
+      bool m_dispatchTaskStarted;
+
+      //! Whether a drain is in progress and will flush staged requests
+      bool m_draining;
+
+      //! Copy of FACTOR, refreshed when the parameter is loaded or set
+      std::atomic<F32> m_factor;
+
+      //! Copy of DISPATCH_MODE, refreshed when the parameter is loaded or set
+      std::atomic<DispatchMode::T> m_dispatchMode;
+
+      //! Dispatch mode while DISPATCH_MODE holds its default value
+      DispatchMode m_defaultDispatchMode;
+
+      //! Copy of EVENT_MODE, refreshed when the parameter is loaded or set
+      std::atomic<EventMode::T> m_eventMode;
+
+      //! Copy of OVERFLOW_POLICY, refreshed when the parameter is loaded or set
+      std::atomic<OverflowPolicy::T> m_overflowPolicy;
+
+      //! Operations performed since the last summary, per operation
+      U32 m_summaryCounts[MathOp::NUM_CONSTANTS];
+
+      //! Ticks since the last summary
+      U32 m_summaryTicks;
+
+      //! Staged operands, one group per operation
+      StagedGroup<F32> m_stagedGroups[MathOp::NUM_CONSTANTS];
+
+      //! Staged double precision operands, one group per operation
+      StagedGroup<F64> m_stagedGroupsF64[MathOp::NUM_CONSTANTS];
+
+      //! Whether each staged request came from mathOpF64In, in arrival order
+      bool m_stagedF64[STAGE_CAPACITY];
+
+      //! Whether each staged request came from mathOpUrgentIn, in arrival order
+      bool m_stagedUrgent[STAGE_CAPACITY];
+
+      //! Operation of each staged request, in arrival order
+      MathOp::T m_stagedOps[STAGE_CAPACITY];
+
+      //! Identifier of each staged request, in arrival order
+      U32 m_stagedIds[STAGE_CAPACITY];
+
+      //! Slot of each staged request within its group, in arrival order
+      U16 m_stagedSlots[STAGE_CAPACITY];
+
+      //! Dequeue time of each staged request, in arrival order
+      Fw::Time m_stagedStart[STAGE_CAPACITY];
+
+      //! Memo cache result of each staged request whose slot is MEMO_SLOT, in arrival order
+      F32 m_stagedResults[STAGE_CAPACITY];
+
+      //! Number of staged requests
+      U32 m_stagedCount;
+
+      //! Queue wait latencies, one histogram per operation
+      LatencyHistogram m_queueWaitLatency[MathOp::NUM_CONSTANTS];
+
+      //! Service latencies, one histogram per operation
+      LatencyHistogram m_serviceLatency[MathOp::NUM_CONSTANTS];
+
+      //! Whether samples were recorded since the latency telemetry was written
+      bool m_latencyUpdated;
+
+      //! Backlog reported by the last DISPATCH_BACKLOG update
+      U32 m_lastBacklog;
+
+      //! Urgent lane depth reported by the last URGENT_DEPTH update
+      U32 m_lastUrgentDepth;
+
+      //! Bulk lane depth reported by the last BULK_DEPTH update
+      U32 m_lastBulkDepth;
+
+      //! Last operation performed, staged for the OPERATION channel
+      MathOp::T m_tlmOperation;
+
+      //! Whether OPERATION and NUMBER_OF_OPS changed since the last tick
+      bool m_tlmOpsDirty;
+
+      //! Last queue wait, staged for the QUEUE_WAIT_US channel
+      U32 m_tlmQueueWaitUs;
+
+      //! Whether QUEUE_WAIT_US changed since the last tick
+      bool m_tlmQueueWaitDirty;
+
+      //! Whether the expression cache counters changed since the last tick
+      bool m_tlmExprDirty;
+
+      //! Compiled programs of recent DO_EXPR expressions
+      MathExpr::Cache m_exprCache;
+
+      //! Results of recent single requests; off unless allocateMemo was called
+      MemoCache m_memo;
+
+      //! Memory of m_memo, owned by the allocator passed to allocateMemo
+      MemoCache::Entry* m_memoEntries;
+
+      //! Memory segment identifier passed to allocateMemo
+      NATIVE_UINT_TYPE m_memoIdentifier;
+
+      //! Incremented when FACTOR changes; the dispatch path empties m_memo when it moves
+      std::atomic<U32> m_memoGeneration;
+
+      //! Value of m_memoGeneration when m_memo was last emptied
+      U32 m_memoClearedGeneration;
+
+      //! Whether the memo cache counters changed since the last tick
+      bool m_tlmMemoDirty;
+
+      //! Credits granted less mathOpIn requests dequeued; negative after requests sent without credits
+      I32 m_creditsOutstanding;
+
+      //! Value of m_queueDrops when the credits of dropped requests were last returned
+      U32 m_creditDropsSeen;
+
+      //! Guards the pending queue and its counters
+      Os::Mutex m_pendingLock;
+
+      //! Operands of the queued mathOpIn requests; each queued message takes the front one
+      PendingQueue m_pending;
+
+      //! Requests merged into the request being handled
+      U32 m_followerIds[PendingQueue::CAPACITY];
+
+      //! Number of mathOpIn requests dropped by the overflow policy
+      U32 m_queueDrops;
+
+      //! Dropped mathOpIn requests waiting for their failure result, oldest first
+      U32 m_droppedIds[DROPPED_CAPACITY];
+
+      //! Number of requests in m_droppedIds
+      U32 m_droppedCount;
+
+      //! Number of mathOpIn requests merged into a queued duplicate
+      U32 m_queueCoalesced;
+
+      //! Value of m_queueDrops last written to QUEUE_DROPS
+      U32 m_tlmQueueDrops;
+
+      //! Value of m_queueCoalesced last written to QUEUE_COALESCED
+      U32 m_tlmQueueCoalesced;
+
+      //! Writes mathOpIn requests to a log; fed under m_pendingLock
+      RequestRecorder m_recorder;
+
+      //! Value last written to RECORDED_REQUESTS
+      U32 m_tlmRecorded;
+
+      //! Value last written to RECORD_DROPS
+      U32 m_tlmRecordDrops;
+
+      //! The running DO_MATH_FILE command
+      FileJob m_fileJob;
+
+      //! Operand file of the running DO_MATH_FILE command
+      MappedFile m_fileIn;
+
+      //! Result file of the running DO_MATH_FILE command
+      Os::File m_fileOut;
+
+      //! CRC-32 of the results written so far
+      Utils::Hash m_fileCrc;
+
+      //! First operands of one DO_MATH_FILE chunk
+      F32 m_fileVal1[FILE_CHUNK];
+
+      //! Second operands of one DO_MATH_FILE chunk
+      F32 m_fileVal2[FILE_CHUNK];
+
+      //! Results of one DO_MATH_FILE chunk
+      F32 m_fileResults[FILE_CHUNK];
+
+      //! Number of ticks whose budget ran out with messages still queued
+      U32 m_budgetOverruns;
+
+      //! Requests from mathOpRingIn; the port caller produces and the drain consumes
+      SpscRing<RingRecord, RING_CAPACITY> m_ring;
+
+      //! Requests from mathOpUrgentIn; guarded callers produce and the drain consumes
+      SpscRing<RingRecord, URGENT_CAPACITY> m_urgentRing;
+
+      //! Urgent requests served in a row while bulk requests waited
+      U32 m_urgentRun;
+
+      //! Urgent lane waits
+      LatencyHistogram m_urgentWait;
+
+      //! Bulk lane waits, of queued requests and ring records
+      LatencyHistogram m_bulkWait;
+
+      //! Records taken from a ring by one drainRing or serveUrgent call
+      RingRecord m_ringBatch[STAGE_CAPACITY];
+
+      //! Guards the enqueue time tracking below
+      Os::Mutex m_waitLock;
+
+      //! Enqueue times of requests, indexed by arrival count
+      Fw::Time m_enqueueTimes[MAX_TRACKED_REQUESTS];
+
+      //! Number of math requests (single or batch) that have entered the queue
+      U32 m_enqueueCount;
+
+      //! Number of math requests that have left the queue
+      U32 m_dequeueCount;
+
     };
 
 } // end namespace MathModule
@@ -0,0 +1,174 @@
+// ----------------------------------------------------------------------
+// MathReceiverBenchMain.cpp
+// ----------------------------------------------------------------------
+
+#include "Components/MathReceiver/test/ut/MathReceiverTester.hpp"
+#include "Components/MathUtils/test/bench/MathBench.hpp"
+#include <cstdlib>
+
+namespace MathModule {
+
+  //! Drives the MathReceiver hot paths through the test harness
+  class MathReceiverBench :
+    public MathReceiverTester
+  {
+
+    public:
+
+      enum {
+        //! Histories hold every output of one round at the largest depth
+        BENCH_HISTORY_SIZE = 2 * TEST_INSTANCE_QUEUE_DEPTH
+      };
+
+      MathReceiverBench() :
+        MathReceiverTester(BENCH_HISTORY_SIZE)
+      {
+
+      }
+
+      //! Queue depth requests per round and drain them with one schedIn call
+      void runDrain(
+          const char* mix, /*!< The name of the operation mix*/
+          const MathOp::T* ops, /*!< The operations, used round robin*/
+          U32 numOps, /*!< The number of operations in the mix*/
+          U32 depth, /*!< The requests queued per round*/
+          U32 totalOps /*!< The approximate number of requests to measure*/
+      ) {
+        FW_ASSERT((depth > 0) && (depth <= static_cast<U32>(TEST_INSTANCE_QUEUE_DEPTH)), depth);
+        const U32 rounds = FW_MAX(totalOps / depth, 1U);
+        MathBench::Stopwatch enqueue;
+        MathBench::Stopwatch drain;
+        U32 requestId = 0;
+
+        // The first round is a warm-up and is not measured
+        for (U32 round = 0; round <= rounds; round++) {
+            const bool measured = (round > 0);
+            if (measured) {
+                enqueue.start();
+            }
+            for (U32 i = 0; i < depth; i++) {
+                const F32 val1 = static_cast<F32>(i + 1);
+                const F32 val2 = static_cast<F32>(depth - i);
+                this->invoke_to_mathOpIn(0, requestId++, val1, ops[i % numOps], val2);
+            }
+            if (measured) {
+                enqueue.stop();
+                drain.start();
+            }
+            this->invoke_to_schedIn(0, 0);
+            if (measured) {
+                drain.stop();
+            }
+            FW_ASSERT(this->fromPortHistory_mathResultOut->size() == depth);
+            this->clearHistory();
+        }
+
+        const U64 ops = static_cast<U64>(rounds) * depth;
+        MathBench::report("MathReceiver", "mathOpIn", mix, depth, ops, enqueue);
+        MathBench::report("MathReceiver", "schedIn_drain", mix, depth, ops, drain);
+      }
+
+      //! Apply an operation to two arrays in buffers, into a third buffer or in place
+      void runVector(
+          U32 elements, /*!< The number of elements per array*/
+          bool inPlace, /*!< Whether the results overwrite the first array*/
+          U32 rounds /*!< The number of requests to measure*/
+      ) {
+        F32* const val1 = new F32[elements];
+        F32* const val2 = new F32[elements];
+        F32* const out = new F32[elements];
+        for (U32 i = 0; i < elements; i++) {
+            val1[i] = static_cast<F32>(i + 1);
+            val2[i] = static_cast<F32>(elements - i);
+        }
+        Fw::Buffer buffer1(reinterpret_cast<U8*>(val1), elements * sizeof(F32));
+        Fw::Buffer buffer2(reinterpret_cast<U8*>(val2), elements * sizeof(F32));
+        Fw::Buffer bufferOut;
+        if (!inPlace) {
+            bufferOut.set(reinterpret_cast<U8*>(out), elements * sizeof(F32));
+        }
+        MathBench::Stopwatch vector;
+
+        // The first round is a warm-up and is not measured
+        for (U32 round = 0; round <= rounds; round++) {
+            const bool measured = (round > 0);
+            this->invoke_to_vectorIn(0, round, MathOp::MUL, buffer1, buffer2, bufferOut);
+            if (measured) {
+                vector.start();
+            }
+            this->invoke_to_schedIn(0, 0);
+            if (measured) {
+                vector.stop();
+            }
+            FW_ASSERT(this->fromPortHistory_vectorResultOut->size() == 1);
+            this->clearHistory();
+        }
+
+        // Each element is reported as one operation, so bandwidth is 12 bytes per op
+        const U64 ops = static_cast<U64>(rounds) * elements;
+        MathBench::report("MathReceiver", inPlace ? "vectorIn_in_place" : "vectorIn", "MUL", elements, ops, vector);
+        delete[] val1;
+        delete[] val2;
+        delete[] out;
+      }
+
+      //! Compare reading FACTOR from the cache with reading it from the parameter store
+      void runFactorLookup(
+          U32 totalOps /*!< The number of lookups to measure*/
+      ) {
+        MathBench::Stopwatch cached;
+        MathBench::Stopwatch store;
+        // Accumulate the factors so the reads are not optimized away
+        volatile F32 sink = 0;
+
+        cached.start();
+        for (U32 i = 0; i < totalOps; i++) {
+            sink = sink + this->component.getFactor();
+        }
+        cached.stop();
+
+        store.start();
+        for (U32 i = 0; i < totalOps; i++) {
+            sink = sink + this->component.readFactor();
+        }
+        store.stop();
+
+        MathBench::report("MathReceiver", "factor_cached", "NONE", 1, totalOps, cached);
+        MathBench::report("MathReceiver", "factor_paramGet", "NONE", 1, totalOps, store);
+      }
+
+  };
+
+}
+
+int main(int argc, char **argv) {
+    // The number of requests measured per configuration may be given on the command line
+    const U32 totalOps = (argc > 1) ? static_cast<U32>(std::strtoul(argv[1], nullptr, 10)) : 20000;
+
+    const MathModule::MathOp::T add[] = {MathModule::MathOp::ADD};
+    const MathModule::MathOp::T div[] = {MathModule::MathOp::DIV};
+    const MathModule::MathOp::T mixed[] = {
+        MathModule::MathOp::ADD, MathModule::MathOp::SUB,
+        MathModule::MathOp::MUL, MathModule::MathOp::DIV
+    };
+    const U32 depths[] = {1, 8, 32, 64};
+
+    for (U32 d = 0; d < FW_NUM_ARRAY_ELEMENTS(depths); d++) {
+        MathModule::MathReceiverBench bench;
+        bench.runDrain("ADD", add, FW_NUM_ARRAY_ELEMENTS(add), depths[d], totalOps);
+        bench.runDrain("DIV", div, FW_NUM_ARRAY_ELEMENTS(div), depths[d], totalOps);
+        bench.runDrain("MIXED", mixed, FW_NUM_ARRAY_ELEMENTS(mixed), depths[d], totalOps);
+    }
+
+    MathModule::MathReceiverBench bench;
+    bench.runFactorLookup(totalOps);
+
+    // Arrays well beyond the caches, so the kernel runs at memory bandwidth
+    const U32 elements[] = {100000, 1000000};
+    for (U32 e = 0; e < FW_NUM_ARRAY_ELEMENTS(elements); e++) {
+        const U32 rounds = FW_MAX(totalOps / 1000, 1U);
+        bench.runVector(elements[e], false, rounds);
+        bench.runVector(elements[e], true, rounds);
+    }
+    return 0;
+}
@@ -27,6 +27,101 @@ TEST(Nominal, Throttle) {
     tester.testThrottle();
 }
 
+TEST(Nominal, EventDriven) {
+    MathModule::MathReceiverTester tester;
+    tester.testEventDriven();
+}
+
+TEST(Nominal, DefaultDispatchMode) {
+    MathModule::MathReceiverTester tester;
+    tester.testDefaultDispatchMode();
+}
+
+TEST(Nominal, Batch) {
+    MathModule::MathReceiverTester tester;
+    tester.testBatch();
+}
+
+TEST(Nominal, DrainOrder) {
+    MathModule::MathReceiverTester tester;
+    tester.testDrainOrder();
+}
+
+TEST(Nominal, Latency) {
+    MathModule::MathReceiverTester tester;
+    tester.testLatency();
+}
+
+TEST(Nominal, TickBudget) {
+    MathModule::MathReceiverTester tester;
+    tester.testTickBudget();
+}
+
+TEST(Nominal, Ring) {
+    MathModule::MathReceiverTester tester;
+    tester.testRing();
+}
+
+TEST(Nominal, FactorCache) {
+    MathModule::MathReceiverTester tester;
+    tester.testFactorCache();
+}
+
+TEST(Nominal, OpSummary) {
+    MathModule::MathReceiverTester tester;
+    tester.testOpSummary();
+}
+
+TEST(Nominal, EventSummary) {
+    MathModule::MathReceiverTester tester;
+    tester.testEventSummary();
+}
+
+TEST(Nominal, Expr) {
+    MathModule::MathReceiverTester tester;
+    tester.testExpr();
+}
+
+TEST(Nominal, Memo) {
+    MathModule::MathReceiverTester tester;
+    tester.testMemo();
+}
+
+TEST(Nominal, MathFile) {
+    MathModule::MathReceiverTester tester;
+    tester.testMathFile();
+}
+
+TEST(Nominal, F64) {
+    MathModule::MathReceiverTester tester;
+    tester.testF64();
+}
+
+TEST(Nominal, Vector) {
+    MathModule::MathReceiverTester tester;
+    tester.testVector();
+}
+
+TEST(Nominal, Credits) {
+    MathModule::MathReceiverTester tester;
+    tester.testCredits();
+}
+
+TEST(Nominal, Overflow) {
+    MathModule::MathReceiverTester tester;
+    tester.testOverflow();
+}
+
+TEST(Nominal, Lanes) {
+    MathModule::MathReceiverTester tester;
+    tester.testLanes();
+}
+
+TEST(Nominal, Recording) {
+    MathModule::MathReceiverTester tester;
+    tester.testRecording();
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     STest::Random::seed();
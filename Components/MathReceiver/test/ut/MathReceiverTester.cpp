@@ -6,6 +6,11 @@
 
 #include "MathReceiverTester.hpp"
 #include "STest/Pick/Pick.hpp"
+#include <Fw/Types/MallocAllocator.hpp>
+#include <Fw/Types/String.hpp>
+#include <Utils/Hash/Hash.hpp>
+#include <cmath>
+#include <cstdio>
 
 namespace MathModule {
   #define CMD_SEQ 42
@@ -15,11 +20,21 @@ namespace MathModule {
 
   MathReceiverTester ::
     MathReceiverTester() :
-      MathReceiverGTestBase("Tester", MathReceiverTester::MAX_HISTORY_SIZE),
-      component("MathReceiver")
+      MathReceiverTester(MathReceiverTester::MAX_HISTORY_SIZE)
+  {
+
+  }
+
+  MathReceiverTester ::
+    MathReceiverTester(NATIVE_INT_TYPE maxHistorySize) :
+      MathReceiverGTestBase("Tester", maxHistorySize),
+      component("MathReceiver"),
+      m_creditsGranted(0),
+      m_busyReports(0)
   {
     this->initComponents();
     this->connectPorts();
+    this->component.loadParameters();
   }
 
   MathReceiverTester ::
@@ -110,11 +125,17 @@ namespace MathModule {
       const F32 val1 = pickF32Value();
       const F32 val2 = pickF32Value();
 
+      const U32 requestId = STest::Pick::any();
+
+      // report the operation by itself, as the aggregated summary is covered by testOpSummary
+      this->paramSet_EVENT_MODE(EventMode::PER_OP, Fw::ParamValid::VALID);
+      this->paramSend_EVENT_MODE(TEST_INSTANCE_ID, CMD_SEQ);
+
       // clear history
       this->clearHistory();
 
       // invoke operation port with add operation
-      this->invoke_to_mathOpIn(0, val1, op, val2);
+      this->invoke_to_mathOpIn(0, requestId, val1, op, val2);
       // invoke scheduler port to dispatch message
       const U32 context = STest::Pick::any();
       this->invoke_to_schedIn(0, context);
@@ -127,7 +148,7 @@ namespace MathModule {
       ASSERT_from_mathResultOut_SIZE(1);
       // check that the component performed the operation correctly
       const F32 result = computeResult(val1, op, val2, factor);
-      ASSERT_from_mathResultOut(0, result);
+      ASSERT_from_mathResultOut(0, requestId, result);
 
       // verify events
 
@@ -141,12 +162,18 @@ namespace MathModule {
 
       // verify telemetry
 
-      // check that one channel was written
-      ASSERT_TLM_SIZE(2);
+      // check that the op and count channels were written once each; the
+      // same tick also publishes the queue and latency channels below
+      ASSERT_TLM_NUMBER_OF_OPS_SIZE(1);
       // check that it was the op channel
       ASSERT_TLM_OPERATION_SIZE(1);
       // check for the correct value of the channel
       ASSERT_TLM_OPERATION(0, op);
+      // check that the queue wait was reported
+      ASSERT_TLM_QUEUE_WAIT_US_SIZE(1);
+      // check that the latency summaries were published by the scheduler
+      ASSERT_TLM_QUEUE_WAIT_LATENCY_SIZE(1);
+      ASSERT_TLM_SERVICE_LATENCY_SIZE(1);
 
   }
 
@@ -204,6 +231,906 @@ namespace MathModule {
 
   }
 
+  void MathReceiverTester ::
+  testEventDriven()
+  {
+      const F32 val1 = pickF32Value();
+      const F32 val2 = pickF32Value();
+
+      // By default the request waits for the scheduler, even with the dispatch task running
+      this->clearHistory();
+      this->component.startDispatchTask(Os::Task::TASK_DEFAULT, Os::Task::TASK_DEFAULT);
+      this->invoke_to_mathOpIn(0, 1, val1, MathOp::ADD, val2);
+      ASSERT_from_mathResultOut_SIZE(0);
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      ASSERT_from_mathResultOut_SIZE(1);
+      ASSERT_from_mathResultOut(0, 1, computeResult(val1, MathOp::ADD, val2, 1.0));
+      ASSERT_EQ(this->m_busyReports, 1U);
+
+      // Switch to event-driven dispatch
+      this->clearHistory();
+      this->paramSet_DISPATCH_MODE(DispatchMode::EVENT_DRIVEN, Fw::ParamValid::VALID);
+      this->paramSend_DISPATCH_MODE(TEST_INSTANCE_ID, CMD_SEQ);
+      ASSERT_EVENTS_SIZE(1);
+      ASSERT_EVENTS_DISPATCH_MODE_UPDATED_SIZE(1);
+      ASSERT_EVENTS_DISPATCH_MODE_UPDATED(0, DispatchMode::EVENT_DRIVEN);
+
+      // Requests are drained by the dispatch task without a scheduler call.
+      // The invoke wakes the task before the message lands in the queue, so
+      // the wakeup may find the queue empty; the task drains again as it
+      // stops, so the join returns once the request is handled
+      this->clearHistory();
+      this->invoke_to_mathOpIn(0, 2, val1, MathOp::MUL, val2);
+      this->component.stopDispatchTask();
+      ASSERT_FALSE(this->component.requestsPending());
+
+      ASSERT_from_mathResultOut_SIZE(1);
+      ASSERT_from_mathResultOut(0, 2, computeResult(val1, MathOp::MUL, val2, 1.0));
+      // The drain reported its service time
+      ASSERT_EQ(this->m_busyReports, 2U);
+      // Telemetry still waits for the scheduler
+      ASSERT_TLM_SIZE(0);
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      ASSERT_from_mathResultOut_SIZE(1);
+      // A tick that served nothing reports nothing
+      ASSERT_EQ(this->m_busyReports, 2U);
+      // The test clock does not advance, so the request waited no time
+      ASSERT_TLM_QUEUE_WAIT_US_SIZE(1);
+      ASSERT_TLM_QUEUE_WAIT_US(0, 0);
+  }
+
+  void MathReceiverTester ::
+  testDefaultDispatchMode()
+  {
+      // A topology can make event-driven dispatch the default, but a stored DISPATCH_MODE takes precedence
+      this->paramSet_DISPATCH_MODE(DispatchMode::RATE_GROUP, Fw::ParamValid::VALID);
+      this->component.setDefaultDispatchMode(DispatchMode::EVENT_DRIVEN);
+      this->component.loadParameters();
+      this->clearHistory();
+      this->component.startDispatchTask(Os::Task::TASK_DEFAULT, Os::Task::TASK_DEFAULT);
+      this->invoke_to_mathOpIn(0, 1, 2.0f, MathOp::ADD, 3.0f);
+      ASSERT_from_mathResultOut_SIZE(0);
+      this->invoke_to_schedIn(0, 0);
+      ASSERT_from_mathResultOut_SIZE(1);
+      ASSERT_from_mathResultOut(0, 1, 5.0f);
+
+      // Without a stored value the configured default applies
+      this->paramSet_DISPATCH_MODE(DispatchMode::RATE_GROUP, Fw::ParamValid::INVALID);
+      this->component.loadParameters();
+      this->clearHistory();
+      this->invoke_to_mathOpIn(0, 2, 2.0f, MathOp::ADD, 3.0f);
+      this->component.stopDispatchTask();
+      ASSERT_from_mathResultOut_SIZE(1);
+      ASSERT_from_mathResultOut(0, 2, 5.0f);
+  }
+
+  void MathReceiverTester ::
+  testBatch()
+  {
+      const F32 factor = pickF32Value();
+      this->setFactor(factor, ThrottleState::NOT_THROTTLED);
+
+      // Use a count that exercises both the vector and remainder loops
+      const U32 count = MathBatch::SIZE - 3;
+      MathBatch val1;
+      MathBatch val2;
+      MathBatch expected;
+      for (U32 i = 0; i < count; i++) {
+          val1[i] = pickF32Value();
+          val2[i] = pickF32Value();
+      }
+      // Two elements divide by zero and come back as zero
+      val2[1] = 0;
+      val2[count - 1] = 0;
+      for (U32 i = 0; i < count; i++) {
+          expected[i] = (val2[i] == 0) ? 0 : computeResult(val1[i], MathOp::DIV, val2[i], factor);
+      }
+
+      this->clearHistory();
+      const U32 requestId = STest::Pick::any();
+      this->invoke_to_mathBatchIn(0, requestId, MathOp::DIV, count, val1, val2);
+      this->invoke_to_schedIn(0, STest::Pick::any());
+
+      // one batch result for the whole request
+      ASSERT_FROM_PORT_HISTORY_SIZE(1);
+      ASSERT_from_mathResultBatchOut_SIZE(1);
+      ASSERT_from_mathResultBatchOut(0, requestId, count, expected);
+
+      // one event for the zero denominators and one summary for the tick
+      ASSERT_EVENTS_SIZE(2);
+      OpCounts counts;
+      counts[MathOp::DIV] = count;
+      ASSERT_EVENTS_OPERATIONS_SUMMARY_SIZE(1);
+      ASSERT_EVENTS_OPERATIONS_SUMMARY(0, 1, counts);
+      ASSERT_EVENTS_BATCH_DIVIDE_BY_ZERO_SIZE(1);
+      ASSERT_EVENTS_BATCH_DIVIDE_BY_ZERO(0, 2);
+
+      // every element counts as an operation
+      ASSERT_TLM_NUMBER_OF_OPS_SIZE(1);
+      ASSERT_TLM_NUMBER_OF_OPS(0, count);
+  }
+
+  void MathReceiverTester ::
+  testDrainOrder()
+  {
+      const F32 factor = pickF32Value();
+      this->setFactor(factor, ThrottleState::NOT_THROTTLED);
+      this->paramSet_EVENT_MODE(EventMode::PER_OP, Fw::ParamValid::VALID);
+      this->paramSend_EVENT_MODE(TEST_INSTANCE_ID, CMD_SEQ);
+
+      // Queue a mix of operations; the drain groups them by operation
+      const U32 numOps = 8;
+      const MathOp ops[numOps] = {
+          MathOp::ADD, MathOp::DIV, MathOp::ADD, MathOp::MUL,
+          MathOp::SUB, MathOp::DIV, MathOp::MUL, MathOp::ADD
+      };
+      F32 val1[numOps];
+      F32 val2[numOps];
+      this->clearHistory();
+      for (U32 i = 0; i < numOps; i++) {
+          val1[i] = pickF32Value();
+          val2[i] = pickF32Value();
+          this->invoke_to_mathOpIn(0, 100 + i, val1[i], ops[i], val2[i]);
+      }
+      this->invoke_to_schedIn(0, STest::Pick::any());
+
+      // results and events still come out in arrival order
+      ASSERT_from_mathResultOut_SIZE(numOps);
+      ASSERT_EVENTS_OPERATION_PERFORMED_SIZE(numOps);
+      for (U32 i = 0; i < numOps; i++) {
+          ASSERT_from_mathResultOut(i, 100 + i, computeResult(val1[i], ops[i], val2[i], factor));
+          ASSERT_EVENTS_OPERATION_PERFORMED(i, ops[i]);
+      }
+      // the op count is written once per tick
+      ASSERT_TLM_NUMBER_OF_OPS_SIZE(1);
+      ASSERT_TLM_NUMBER_OF_OPS(0, numOps);
+      ASSERT_TLM_OPERATION_SIZE(1);
+      ASSERT_TLM_OPERATION(0, ops[numOps - 1]);
+  }
+
+  void MathReceiverTester ::
+  testLatency()
+  {
+      // Requests wait 1500 us in the queue and are serviced instantly
+      Fw::Time enqueued(TB_NONE, 100, 0);
+      this->setTestTime(enqueued);
+      this->clearHistory();
+      this->invoke_to_mathOpIn(0, 1, pickF32Value(), MathOp::ADD, pickF32Value());
+      this->invoke_to_mathOpIn(0, 2, pickF32Value(), MathOp::ADD, pickF32Value());
+      Fw::Time dequeued(TB_NONE, 100, 1500);
+      this->setTestTime(dequeued);
+      this->invoke_to_schedIn(0, STest::Pick::any());
+
+      OpLatency queueWait;
+      OpLatency service;
+      queueWait[MathOp::ADD] = LatencySummary(2, 1500, 1500, 1500);
+      service[MathOp::ADD] = LatencySummary(2, 0, 0, 0);
+      ASSERT_TLM_QUEUE_WAIT_LATENCY_SIZE(1);
+      ASSERT_TLM_QUEUE_WAIT_LATENCY(0, queueWait);
+      ASSERT_TLM_SERVICE_LATENCY_SIZE(1);
+      ASSERT_TLM_SERVICE_LATENCY(0, service);
+
+      // Nothing new to report on an idle tick
+      this->clearHistory();
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      ASSERT_TLM_SIZE(0);
+
+      // The dump emits one event per non-empty histogram
+      this->sendCmd_DUMP_LATENCY(TEST_INSTANCE_ID, CMD_SEQ);
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      ASSERT_CMD_RESPONSE_SIZE(1);
+      ASSERT_CMD_RESPONSE(0, MathReceiverComponentBase::OPCODE_DUMP_LATENCY, CMD_SEQ, Fw::CmdResponse::OK);
+      ASSERT_EVENTS_LATENCY_HISTOGRAM_SIZE(2);
+      LatencyBuckets waitBuckets;
+      LatencyBuckets serviceBuckets;
+      waitBuckets[11] = 2;
+      serviceBuckets[0] = 2;
+      ASSERT_EVENTS_LATENCY_HISTOGRAM(0, LatencyStage::QUEUE_WAIT, MathOp::ADD, queueWait[MathOp::ADD], waitBuckets);
+      ASSERT_EVENTS_LATENCY_HISTOGRAM(1, LatencyStage::SERVICE, MathOp::ADD, service[MathOp::ADD], serviceBuckets);
+
+      // and resets the histograms
+      ASSERT_TLM_QUEUE_WAIT_LATENCY_SIZE(1);
+      ASSERT_TLM_QUEUE_WAIT_LATENCY(0, OpLatency());
+      ASSERT_TLM_SERVICE_LATENCY(0, OpLatency());
+  }
+
+  void MathReceiverTester ::
+  testTickBudget()
+  {
+      // Allow three messages per tick
+      this->paramSet_TICK_MESSAGE_BUDGET(3, Fw::ParamValid::VALID);
+      this->paramSend_TICK_MESSAGE_BUDGET(TEST_INSTANCE_ID, CMD_SEQ);
+
+      this->clearHistory();
+      for (U32 i = 0; i < 5; i++) {
+          this->invoke_to_mathOpIn(0, i, pickF32Value(), MathOp::ADD, pickF32Value());
+      }
+      this->invoke_to_schedIn(0, STest::Pick::any());
+
+      // The rest is carried over and counted as an overrun
+      ASSERT_from_mathResultOut_SIZE(3);
+      ASSERT_TLM_DISPATCH_BACKLOG_SIZE(1);
+      ASSERT_TLM_DISPATCH_BACKLOG(0, 2);
+      ASSERT_TLM_BUDGET_OVERRUNS_SIZE(1);
+      ASSERT_TLM_BUDGET_OVERRUNS(0, 1);
+
+      // The next tick finishes the backlog within budget
+      this->clearHistory();
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      ASSERT_from_mathResultOut_SIZE(2);
+      ASSERT_EQ(this->fromPortHistory_mathResultOut->at(0).requestId, 3U);
+      ASSERT_EQ(this->fromPortHistory_mathResultOut->at(1).requestId, 4U);
+      ASSERT_TLM_DISPATCH_BACKLOG_SIZE(1);
+      ASSERT_TLM_DISPATCH_BACKLOG(0, 0);
+      ASSERT_TLM_BUDGET_OVERRUNS_SIZE(0);
+  }
+
+  void MathReceiverTester ::
+  testRing()
+  {
+      const F32 factor = pickF32Value();
+      this->setFactor(factor, ThrottleState::NOT_THROTTLED);
+
+      // Ring requests wait for the drain like queued ones
+      this->setTestTime(Fw::Time(TB_NONE, 20, 0));
+      this->clearHistory();
+      F32 val1[3];
+      F32 val2[3];
+      const MathOp ops[3] = {MathOp::MUL, MathOp::SUB, MathOp::MUL};
+      for (U32 i = 0; i < 3; i++) {
+          val1[i] = pickF32Value();
+          val2[i] = pickF32Value();
+          this->invoke_to_mathOpRingIn(0, i, val1[i], ops[i], val2[i]);
+      }
+      ASSERT_from_mathResultOut_SIZE(0);
+
+      this->setTestTime(Fw::Time(TB_NONE, 20, 200));
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      ASSERT_from_mathResultOut_SIZE(3);
+      for (U32 i = 0; i < 3; i++) {
+          ASSERT_from_mathResultOut(i, i, computeResult(val1[i], ops[i], val2[i], factor));
+      }
+      ASSERT_TLM_QUEUE_WAIT_US_SIZE(1);
+      ASSERT_TLM_QUEUE_WAIT_US(0, 200);
+
+      // Ring requests count against the tick budget after queued ones
+      this->paramSet_TICK_MESSAGE_BUDGET(2, Fw::ParamValid::VALID);
+      this->paramSend_TICK_MESSAGE_BUDGET(TEST_INSTANCE_ID, CMD_SEQ);
+      this->clearHistory();
+      this->invoke_to_mathOpRingIn(0, 10, 1.0, MathOp::ADD, 1.0);
+      this->invoke_to_mathOpRingIn(0, 11, 1.0, MathOp::ADD, 1.0);
+      this->invoke_to_mathOpIn(0, 12, 1.0, MathOp::ADD, 1.0);
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      ASSERT_from_mathResultOut_SIZE(2);
+      ASSERT_EQ(this->fromPortHistory_mathResultOut->at(0).requestId, 12U);
+      ASSERT_EQ(this->fromPortHistory_mathResultOut->at(1).requestId, 10U);
+      ASSERT_TLM_DISPATCH_BACKLOG(0, 1);
+      ASSERT_TLM_BUDGET_OVERRUNS(0, 1);
+
+      // A full ring drops the request
+      this->clearHistory();
+      for (U32 i = 1; i < MathReceiver::RING_CAPACITY; i++) {
+          this->invoke_to_mathOpRingIn(0, 100 + i, 1.0, MathOp::ADD, 1.0);
+      }
+      ASSERT_EVENTS_SIZE(0);
+      this->invoke_to_mathOpRingIn(0, 200, 1.0, MathOp::ADD, 1.0);
+      ASSERT_EVENTS_RING_FULL_SIZE(1);
+      ASSERT_EVENTS_RING_FULL(0, 200);
+  }
+
+  void MathReceiverTester ::
+  testFactorCache()
+  {
+      // The cache starts from the loaded default
+      ASSERT_EQ(this->component.getFactor(), 1.0f);
+
+      // The set opcode refreshes the cache
+      const F32 factor = pickF32Value();
+      this->setFactor(factor, ThrottleState::NOT_THROTTLED);
+      ASSERT_EQ(this->component.getFactor(), factor);
+
+      // Saving leaves it alone
+      this->paramSave_FACTOR(TEST_INSTANCE_ID, CMD_SEQ);
+      ASSERT_EQ(this->component.getFactor(), factor);
+
+      // Loading parameters refreshes it
+      const F32 loaded = pickF32Value();
+      this->paramSet_FACTOR(loaded, Fw::ParamValid::VALID);
+      this->component.loadParameters();
+      ASSERT_EQ(this->component.getFactor(), loaded);
+      ASSERT_EQ(this->component.getFactor(), this->component.readFactor());
+  }
+
+  void MathReceiverTester ::
+  testOpSummary()
+  {
+      const F32 val1 = pickF32Value();
+      const F32 val2 = pickF32Value();
+
+      // By default the operation is counted, and the tick reports it in the summary
+      this->clearHistory();
+      this->invoke_to_mathOpIn(0, 1, val1, MathOp::MUL, val2);
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      ASSERT_from_mathResultOut_SIZE(1);
+      ASSERT_from_mathResultOut(0, 1, computeResult(val1, MathOp::MUL, val2, 1.0));
+      ASSERT_EVENTS_SIZE(1);
+      ASSERT_EVENTS_OPERATION_PERFORMED_SIZE(0);
+      ASSERT_EVENTS_OPERATIONS_SUMMARY_SIZE(1);
+      OpCounts counts;
+      counts[MathOp::MUL] = 1;
+      ASSERT_EVENTS_OPERATIONS_SUMMARY(0, 1, counts);
+      ASSERT_TLM_OPERATION_SIZE(1);
+      ASSERT_TLM_OPERATION(0, MathOp::MUL);
+  }
+
+  void MathReceiverTester ::
+  testEventSummary()
+  {
+      // Summarize every other tick
+      this->paramSet_SUMMARY_INTERVAL(2, Fw::ParamValid::VALID);
+      this->paramSend_SUMMARY_INTERVAL(TEST_INSTANCE_ID, CMD_SEQ);
+
+      this->clearHistory();
+      this->invoke_to_mathOpIn(0, 1, pickF32Value(), MathOp::ADD, pickF32Value());
+      this->invoke_to_mathOpIn(0, 2, pickF32Value(), MathOp::MUL, pickF32Value());
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      ASSERT_from_mathResultOut_SIZE(2);
+      ASSERT_EVENTS_SIZE(0);
+
+      this->invoke_to_mathOpIn(0, 3, pickF32Value(), MathOp::ADD, pickF32Value());
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      OpCounts counts;
+      counts[MathOp::ADD] = 2;
+      counts[MathOp::MUL] = 1;
+      ASSERT_EVENTS_SIZE(1);
+      ASSERT_EVENTS_OPERATIONS_SUMMARY_SIZE(1);
+      ASSERT_EVENTS_OPERATIONS_SUMMARY(0, 2, counts);
+
+      // Idle intervals are not reported
+      this->clearHistory();
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      ASSERT_EVENTS_SIZE(0);
+
+      // The debug mode reports each operation as it is performed
+      this->paramSet_EVENT_MODE(EventMode::PER_OP, Fw::ParamValid::VALID);
+      this->paramSend_EVENT_MODE(TEST_INSTANCE_ID, CMD_SEQ);
+      ASSERT_EVENTS_EVENT_MODE_UPDATED_SIZE(1);
+      ASSERT_EVENTS_EVENT_MODE_UPDATED(0, EventMode::PER_OP);
+      this->clearHistory();
+      this->invoke_to_mathOpIn(0, 4, pickF32Value(), MathOp::SUB, pickF32Value());
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      ASSERT_EVENTS_SIZE(1);
+      ASSERT_EVENTS_OPERATION_PERFORMED_SIZE(1);
+      ASSERT_EVENTS_OPERATION_PERFORMED(0, MathOp::SUB);
+  }
+
+  void MathReceiverTester ::
+  testExpr()
+  {
+      const F32 factor = pickF32Value();
+      this->setFactor(factor, ThrottleState::NOT_THROTTLED);
+
+      // One dispatch evaluates the whole formula with the factor applied
+      const Fw::String expr("(a + b) * c - d / 2");
+      ExprVars vars;
+      for (U32 i = 0; i < ExprVars::SIZE; i++) {
+          vars[i] = pickF32Value();
+      }
+      this->clearHistory();
+      this->invoke_to_exprIn(0, 7, expr, vars);
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      const F32 expected = ((vars[0] + vars[1]) * vars[2] - vars[3] / 2) * factor;
+      ASSERT_from_exprResultOut_SIZE(1);
+      ASSERT_from_exprResultOut(0, 7, ExprStatus::OK, expected);
+      ASSERT_TLM_EXPR_CACHE_MISSES(0, 1);
+
+      // The same text reuses the compiled program
+      vars[3] = 0;
+      this->clearHistory();
+      this->invoke_to_exprIn(0, 8, expr, vars);
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      ASSERT_from_exprResultOut(0, 8, ExprStatus::OK, (vars[0] + vars[1]) * vars[2] * factor);
+      ASSERT_TLM_EXPR_CACHE_HITS_SIZE(1);
+      ASSERT_TLM_EXPR_CACHE_HITS(0, 1);
+      ASSERT_TLM_EXPR_CACHE_MISSES(0, 1);
+
+      // A zero denominator yields zero, as on mathOpIn
+      this->clearHistory();
+      this->invoke_to_exprIn(0, 9, Fw::String("a / (b - b)"), vars);
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      ASSERT_from_exprResultOut(0, 9, ExprStatus::OK, 0);
+      ASSERT_EVENTS_DIVIDE_BY_ZERO_SIZE(1);
+
+      // Malformed expressions are rejected
+      this->clearHistory();
+      this->invoke_to_exprIn(0, 10, Fw::String("a + * b"), vars);
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      ASSERT_from_exprResultOut(0, 10, ExprStatus::SYNTAX_ERROR, 0);
+      ASSERT_EVENTS_EXPR_INVALID_SIZE(1);
+      ASSERT_EVENTS_EXPR_INVALID(0, 10, ExprStatus::SYNTAX_ERROR);
+  }
+
+  void MathReceiverTester ::
+  testMemo()
+  {
+      Fw::MallocAllocator allocator;
+      this->component.allocateMemo(0, allocator, 16);
+      const F32 factor = pickF32Value();
+      this->setFactor(factor, ThrottleState::NOT_THROTTLED);
+      const F32 val1 = pickF32Value();
+      const F32 val2 = pickF32Value();
+      const F32 expected = computeResult(val1, MathOp::MUL, val2, factor);
+
+      // The first request computes the result
+      this->clearHistory();
+      this->invoke_to_mathOpIn(0, 1, val1, MathOp::MUL, val2);
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      ASSERT_from_mathResultOut(0, 1, expected);
+      ASSERT_TLM_MEMO_HITS(0, 0);
+      ASSERT_TLM_MEMO_MISSES(0, 1);
+
+      // and a repeat is answered from the cache
+      this->clearHistory();
+      this->invoke_to_mathOpIn(0, 2, val1, MathOp::MUL, val2);
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      ASSERT_from_mathResultOut(0, 2, expected);
+      ASSERT_TLM_MEMO_HITS(0, 1);
+      ASSERT_TLM_MEMO_MISSES(0, 1);
+      ASSERT_TLM_NUMBER_OF_OPS(0, 2);
+
+      // Zero denominators are never cached, so each one is reported
+      this->clearHistory();
+      for (U32 i = 0; i < 2; i++) {
+          this->invoke_to_mathOpIn(0, 3 + i, val1, MathOp::DIV, 0);
+          this->invoke_to_schedIn(0, STest::Pick::any());
+      }
+      ASSERT_EVENTS_DIVIDE_BY_ZERO_SIZE(2);
+      ASSERT_TLM_MEMO_HITS(1, 1);
+
+      // A new factor empties the cache
+      const F32 newFactor = factor + 1;
+      this->setFactor(newFactor, ThrottleState::NOT_THROTTLED);
+      this->clearHistory();
+      this->invoke_to_mathOpIn(0, 5, val1, MathOp::MUL, val2);
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      ASSERT_from_mathResultOut(0, 5, computeResult(val1, MathOp::MUL, val2, newFactor));
+      ASSERT_TLM_MEMO_HITS(0, 1);
+      ASSERT_TLM_MEMO_MISSES(0, 4);
+      ASSERT_TLM_MEMO_EVICTIONS(0, 0);
+
+      this->component.deallocateMemo(allocator);
+  }
+
+  void MathReceiverTester ::
+  testMathFile()
+  {
+      const char* const inputPath = "MathReceiverFileIn.bin";
+      const char* const outputPath = "MathReceiverFileOut.bin";
+      const F32 factor = pickF32Value();
+      this->setFactor(factor, ThrottleState::NOT_THROTTLED);
+
+      // Ten operand pairs, one with a zero denominator
+      const U32 numPairs = 10;
+      F32 pairs[2 * numPairs];
+      for (U32 i = 0; i < numPairs; i++) {
+          pairs[2 * i] = pickF32Value();
+          pairs[2 * i + 1] = (i == 5) ? 0 : pickF32Value();
+      }
+      FILE* input = fopen(inputPath, "wb");
+      ASSERT_NE(input, nullptr);
+      ASSERT_EQ(fwrite(pairs, sizeof(pairs), 1, input), 1U);
+      (void) fclose(input);
+
+      // Four pairs per tick
+      this->paramSet_FILE_OPS_PER_TICK(4, Fw::ParamValid::VALID);
+      this->paramSend_FILE_OPS_PER_TICK(TEST_INSTANCE_ID, CMD_SEQ);
+      this->clearHistory();
+      this->sendCmd_DO_MATH_FILE(TEST_INSTANCE_ID, CMD_SEQ, Fw::CmdStringArg(inputPath), MathOp::DIV,
+                                 Fw::CmdStringArg(outputPath));
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      ASSERT_EVENTS_FILE_STARTED_SIZE(1);
+      ASSERT_EVENTS_FILE_STARTED(0, inputPath, numPairs);
+      ASSERT_TLM_FILE_OPS_DONE_SIZE(2);
+      ASSERT_TLM_FILE_OPS_DONE(1, 4);
+      ASSERT_TLM_FILE_PROGRESS_PCT(1, 40);
+      ASSERT_CMD_RESPONSE_SIZE(0);
+
+      // One file at a time
+      this->clearHistory();
+      this->sendCmd_DO_MATH_FILE(TEST_INSTANCE_ID, CMD_SEQ + 1, Fw::CmdStringArg(inputPath), MathOp::ADD,
+                                 Fw::CmdStringArg(outputPath));
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      ASSERT_CMD_RESPONSE_SIZE(1);
+      ASSERT_CMD_RESPONSE(0, MathReceiverComponentBase::OPCODE_DO_MATH_FILE, CMD_SEQ + 1, Fw::CmdResponse::BUSY);
+      ASSERT_TLM_FILE_OPS_DONE(0, 8);
+
+      // The last tick finishes the file and completes the command
+      this->clearHistory();
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      ASSERT_TLM_FILE_OPS_DONE(0, numPairs);
+      ASSERT_TLM_FILE_PROGRESS_PCT(0, 100);
+      ASSERT_CMD_RESPONSE_SIZE(1);
+      ASSERT_CMD_RESPONSE(0, MathReceiverComponentBase::OPCODE_DO_MATH_FILE, CMD_SEQ, Fw::CmdResponse::OK);
+
+      // The result file holds every result and their CRC-32
+      F32 results[numPairs];
+      U32 crc = 0;
+      FILE* output = fopen(outputPath, "rb");
+      ASSERT_NE(output, nullptr);
+      ASSERT_EQ(fread(results, sizeof(results), 1, output), 1U);
+      ASSERT_EQ(fread(&crc, sizeof(crc), 1, output), 1U);
+      (void) fclose(output);
+      for (U32 i = 0; i < numPairs; i++) {
+          const F32 expected = (i == 5) ? 0 : computeResult(pairs[2 * i], MathOp::DIV, pairs[2 * i + 1], factor);
+          ASSERT_EQ(results[i], expected);
+      }
+      Utils::Hash hash;
+      hash.update(results, sizeof(results));
+      U32 expectedCrc = 0;
+      hash.final(expectedCrc);
+      ASSERT_EQ(crc, expectedCrc);
+      ASSERT_EVENTS_FILE_COMPLETED_SIZE(1);
+      ASSERT_EVENTS_FILE_COMPLETED(0, numPairs, 1, crc);
+
+      // A cancel stops the file and fails its command
+      this->clearHistory();
+      this->sendCmd_DO_MATH_FILE(TEST_INSTANCE_ID, CMD_SEQ, Fw::CmdStringArg(inputPath), MathOp::ADD,
+                                 Fw::CmdStringArg(outputPath));
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      this->sendCmd_CANCEL_MATH_FILE(TEST_INSTANCE_ID, CMD_SEQ + 1);
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      ASSERT_EVENTS_FILE_CANCELED_SIZE(1);
+      ASSERT_EVENTS_FILE_CANCELED(0, 4);
+      ASSERT_CMD_RESPONSE_SIZE(2);
+      ASSERT_CMD_RESPONSE(0, MathReceiverComponentBase::OPCODE_DO_MATH_FILE, CMD_SEQ, Fw::CmdResponse::EXECUTION_ERROR);
+      ASSERT_CMD_RESPONSE(1, MathReceiverComponentBase::OPCODE_CANCEL_MATH_FILE, CMD_SEQ + 1, Fw::CmdResponse::OK);
+
+      // A file that ends inside an operand pair is rejected
+      input = fopen(inputPath, "wb");
+      ASSERT_NE(input, nullptr);
+      ASSERT_EQ(fwrite(pairs, sizeof(F32) * 3, 1, input), 1U);
+      (void) fclose(input);
+      this->clearHistory();
+      this->sendCmd_DO_MATH_FILE(TEST_INSTANCE_ID, CMD_SEQ, Fw::CmdStringArg(inputPath), MathOp::ADD,
+                                 Fw::CmdStringArg(outputPath));
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      ASSERT_EVENTS_FILE_FAILED_SIZE(1);
+      ASSERT_EVENTS_FILE_FAILED(0, MathFileError::BAD_SIZE);
+      ASSERT_CMD_RESPONSE(0, MathReceiverComponentBase::OPCODE_DO_MATH_FILE, CMD_SEQ, Fw::CmdResponse::EXECUTION_ERROR);
+
+      (void) remove(inputPath);
+      (void) remove(outputPath);
+  }
+
+  void MathReceiverTester ::
+  testF64()
+  {
+      const F32 factor = pickF32Value();
+      this->setFactor(factor, ThrottleState::NOT_THROTTLED);
+      this->paramSet_EVENT_MODE(EventMode::PER_OP, Fw::ParamValid::VALID);
+      this->paramSend_EVENT_MODE(TEST_INSTANCE_ID, CMD_SEQ);
+
+      // An operand F32 cannot represent, mixed with a single precision request
+      const F64 val1 = 1.0 + 1e-12;
+      const F64 val2 = 3.0;
+      this->clearHistory();
+      this->invoke_to_mathOpF64In(0, 1, val1, MathOp::DIV, val2);
+      this->invoke_to_mathOpIn(0, 2, 4.0f, MathOp::ADD, 1.0f);
+      this->invoke_to_mathOpF64In(0, 3, val1, MathOp::SUB, 1.0);
+      this->invoke_to_mathOpF64In(0, 4, val1, MathOp::DIV, 0.0);
+      this->invoke_to_schedIn(0, STest::Pick::any());
+
+      // Each precision answers on its own port with the factor applied
+      ASSERT_from_mathResultF64Out_SIZE(3);
+      ASSERT_from_mathResultF64Out(0, 1, (val1 / val2) * static_cast<F64>(factor));
+      ASSERT_from_mathResultF64Out(1, 3, (val1 - 1.0) * static_cast<F64>(factor));
+      ASSERT_from_mathResultF64Out(2, 4, 0.0);
+      ASSERT_from_mathResultOut_SIZE(1);
+      ASSERT_from_mathResultOut(0, 2, computeResult(4.0f, MathOp::ADD, 1.0f, factor));
+      ASSERT_EVENTS_DIVIDE_BY_ZERO_SIZE(1);
+
+      // and both are reported in arrival order
+      ASSERT_EVENTS_OPERATION_PERFORMED_SIZE(4);
+      ASSERT_EVENTS_OPERATION_PERFORMED(0, MathOp::DIV);
+      ASSERT_EVENTS_OPERATION_PERFORMED(1, MathOp::ADD);
+      ASSERT_EVENTS_OPERATION_PERFORMED(2, MathOp::SUB);
+      ASSERT_EVENTS_OPERATION_PERFORMED(3, MathOp::DIV);
+      ASSERT_TLM_NUMBER_OF_OPS(0, 4);
+  }
+
+  void MathReceiverTester ::
+    testVector()
+  {
+      const F32 factor = pickF32Value();
+      this->setFactor(factor, ThrottleState::NOT_THROTTLED);
+
+      // A length that exercises both the vector and remainder loops
+      const U32 count = 1027;
+      static F32 val1[count];
+      static F32 val2[count];
+      static F32 out[count];
+      for (U32 i = 0; i < count; i++) {
+          val1[i] = pickF32Value();
+          val2[i] = pickF32Value();
+      }
+      val2[5] = 0;
+      Fw::Buffer buffer1(reinterpret_cast<U8*>(val1), sizeof(val1));
+      Fw::Buffer buffer2(reinterpret_cast<U8*>(val2), sizeof(val2));
+      Fw::Buffer bufferOut(reinterpret_cast<U8*>(out), sizeof(out));
+
+      // Elementwise into the caller's result buffer
+      this->clearHistory();
+      this->invoke_to_vectorIn(0, 1, MathOp::DIV, buffer1, buffer2, bufferOut);
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      ASSERT_from_vectorResultOut_SIZE(1);
+      ASSERT_EQ(this->fromPortHistory_vectorResultOut->at(0).status, VectorStatus::OK);
+      ASSERT_EQ(this->fromPortHistory_vectorResultOut->at(0).count, count);
+      ASSERT_EQ(this->fromPortHistory_vectorResultOut->at(0).result.getData(), reinterpret_cast<U8*>(out));
+      for (U32 i = 0; i < count; i++) {
+          const F32 expected = (val2[i] == 0) ? 0 : computeResult(val1[i], MathOp::DIV, val2[i], factor);
+          ASSERT_EQ(out[i], expected) << "element " << i;
+      }
+      ASSERT_EVENTS_BATCH_DIVIDE_BY_ZERO_SIZE(1);
+      ASSERT_EVENTS_BATCH_DIVIDE_BY_ZERO(0, 1);
+      ASSERT_TLM_NUMBER_OF_OPS(0, count);
+
+      // A single element is broadcast, and with no result buffer the array is overwritten
+      F32 scalar = 2.0f;
+      Fw::Buffer bufferScalar(reinterpret_cast<U8*>(&scalar), sizeof(scalar));
+      Fw::Buffer inPlace;
+      for (U32 i = 0; i < count; i++) {
+          out[i] = val1[i];
+      }
+      this->clearHistory();
+      this->invoke_to_vectorIn(0, 2, MathOp::SUB, bufferScalar, bufferOut, inPlace);
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      ASSERT_from_vectorResultOut_SIZE(1);
+      ASSERT_EQ(this->fromPortHistory_vectorResultOut->at(0).count, count);
+      ASSERT_EQ(this->fromPortHistory_vectorResultOut->at(0).result.getData(), reinterpret_cast<U8*>(out));
+      for (U32 i = 0; i < count; i++) {
+          ASSERT_EQ(out[i], computeResult(scalar, MathOp::SUB, val1[i], factor)) << "element " << i;
+      }
+
+      // Arrays of different lengths cannot be combined
+      Fw::Buffer shorter(reinterpret_cast<U8*>(val2), sizeof(val2) - sizeof(F32));
+      this->clearHistory();
+      this->invoke_to_vectorIn(0, 3, MathOp::ADD, buffer1, shorter, bufferOut);
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      ASSERT_from_vectorResultOut_SIZE(1);
+      ASSERT_EQ(this->fromPortHistory_vectorResultOut->at(0).status, VectorStatus::SIZE_MISMATCH);
+      ASSERT_EQ(this->fromPortHistory_vectorResultOut->at(0).count, 0U);
+      ASSERT_EVENTS_VECTOR_REJECTED_SIZE(1);
+      ASSERT_EVENTS_VECTOR_REJECTED(0, 3, VectorStatus::SIZE_MISMATCH);
+
+      // and a partial element is not an array
+      Fw::Buffer partial(reinterpret_cast<U8*>(val1), sizeof(val1) - 1);
+      this->clearHistory();
+      this->invoke_to_vectorIn(0, 4, MathOp::ADD, partial, buffer2, bufferOut);
+      this->invoke_to_schedIn(0, STest::Pick::any());
+      ASSERT_EVENTS_VECTOR_REJECTED_SIZE(1);
+      ASSERT_EVENTS_VECTOR_REJECTED(0, 4, VectorStatus::BAD_BUFFER);
+  }
+
+  void MathReceiverTester ::
+    testCredits()
+  {
+      // The first tick grants the whole allowance
+      this->invoke_to_schedIn(0, 0);
+      ASSERT_EQ(this->m_creditsGranted, 8U);
+
+      // Each drained request earns its credit back
+      for (U32 i = 0; i < 3; i++) {
+          this->invoke_to_mathOpIn(0, i, 1.0, MathOp::ADD, 2.0);
+      }
+      this->invoke_to_schedIn(0, 0);
+      ASSERT_EQ(this->m_creditsGranted, 11U);
+
+      // A lowered allowance holds credits back until the queue drains below it
+      this->paramSet_REQUEST_CREDITS(2, Fw::ParamValid::VALID);
+      this->paramSend_REQUEST_CREDITS(TEST_INSTANCE_ID, CMD_SEQ);
+      for (U32 i = 0; i < 3; i++) {
+          this->invoke_to_mathOpIn(0, i, 1.0, MathOp::ADD, 2.0);
+      }
+      this->invoke_to_schedIn(0, 0);
+      ASSERT_EQ(this->m_creditsGranted, 11U);
+      for (U32 i = 0; i < 4; i++) {
+          this->invoke_to_mathOpIn(0, i, 1.0, MathOp::ADD, 2.0);
+      }
+      this->invoke_to_schedIn(0, 0);
+      ASSERT_EQ(this->m_creditsGranted, 12U);
+
+      // Requests beyond the credits granted earn a credit back each, for the router to keep
+      for (U32 i = 0; i < 5; i++) {
+          this->invoke_to_mathOpIn(0, i, 1.0, MathOp::ADD, 2.0);
+      }
+      this->invoke_to_schedIn(0, 0);
+      ASSERT_EQ(this->m_creditsGranted, 17U);
+  }
+
+  void MathReceiverTester ::
+    testOverflow()
+  {
+      const U32 depth = TEST_INSTANCE_QUEUE_DEPTH;
+
+      // The default drops the request that finds the queue full, and answers it after the queue drains
+      this->clearHistory();
+      for (U32 i = 0; i <= depth; i++) {
+          this->invoke_to_mathOpIn(0, i, static_cast<F32>(i), MathOp::ADD, 1.0f);
+      }
+      this->invoke_to_schedIn(0, 0);
+      ASSERT_from_mathResultOut_SIZE(depth + 1);
+      ASSERT_from_mathResultOut(depth - 1, depth - 1, static_cast<F32>(depth));
+      ASSERT_EQ(this->fromPortHistory_mathResultOut->at(depth).requestId, depth);
+      ASSERT_TRUE(std::isnan(this->fromPortHistory_mathResultOut->at(depth).result));
+      ASSERT_EVENTS_REQUEST_DROPPED_SIZE(1);
+      ASSERT_EVENTS_REQUEST_DROPPED(0, depth);
+      ASSERT_TLM_QUEUE_DROPS_SIZE(1);
+      ASSERT_TLM_QUEUE_DROPS(0, 1);
+
+      // DROP_OLDEST makes room by dropping the front of the queue
+      this->paramSet_OVERFLOW_POLICY(OverflowPolicy::DROP_OLDEST, Fw::ParamValid::VALID);
+      this->paramSend_OVERFLOW_POLICY(TEST_INSTANCE_ID, CMD_SEQ);
+      ASSERT_EVENTS_OVERFLOW_POLICY_UPDATED_SIZE(1);
+      ASSERT_EVENTS_OVERFLOW_POLICY_UPDATED(0, OverflowPolicy::DROP_OLDEST);
+      this->clearHistory();
+      for (U32 i = 0; i < depth + 2; i++) {
+          this->invoke_to_mathOpIn(0, i, static_cast<F32>(i), MathOp::ADD, 1.0f);
+      }
+      this->invoke_to_schedIn(0, 0);
+      ASSERT_from_mathResultOut_SIZE(depth + 2);
+      for (U32 i = 0; i < depth; i++) {
+          ASSERT_from_mathResultOut(i, i + 2, static_cast<F32>(i + 3));
+      }
+      for (U32 i = 0; i < 2; i++) {
+          ASSERT_EQ(this->fromPortHistory_mathResultOut->at(depth + i).requestId, i);
+          ASSERT_TRUE(std::isnan(this->fromPortHistory_mathResultOut->at(depth + i).result));
+      }
+      ASSERT_EVENTS_REQUEST_DROPPED_SIZE(2);
+      ASSERT_TLM_QUEUE_DROPS_SIZE(1);
+      ASSERT_TLM_QUEUE_DROPS(0, 3);
+
+      // COALESCE answers a duplicate along with the queued request and drops the rest
+      this->paramSet_OVERFLOW_POLICY(OverflowPolicy::COALESCE, Fw::ParamValid::VALID);
+      this->paramSend_OVERFLOW_POLICY(TEST_INSTANCE_ID, CMD_SEQ);
+      this->clearHistory();
+      for (U32 i = 0; i < depth; i++) {
+          this->invoke_to_mathOpIn(0, i, static_cast<F32>(i), MathOp::ADD, 1.0f);
+      }
+      this->invoke_to_mathOpIn(0, 100, 10.0f, MathOp::ADD, 1.0f);
+      this->invoke_to_mathOpIn(0, 101, 10.0f, MathOp::SUB, 1.0f);
+      this->invoke_to_schedIn(0, 0);
+      ASSERT_from_mathResultOut_SIZE(depth + 2);
+      ASSERT_from_mathResultOut(10, 10, 11.0f);
+      ASSERT_from_mathResultOut(11, 100, 11.0f);
+      ASSERT_from_mathResultOut(12, 11, 12.0f);
+      ASSERT_EQ(this->fromPortHistory_mathResultOut->at(depth + 1).requestId, 101U);
+      ASSERT_TRUE(std::isnan(this->fromPortHistory_mathResultOut->at(depth + 1).result));
+      ASSERT_EVENTS_REQUEST_DROPPED_SIZE(1);
+      ASSERT_EVENTS_REQUEST_DROPPED(0, 101);
+      ASSERT_TLM_QUEUE_COALESCED_SIZE(1);
+      ASSERT_TLM_QUEUE_COALESCED(0, 1);
+      ASSERT_TLM_QUEUE_DROPS_SIZE(1);
+      ASSERT_TLM_QUEUE_DROPS(0, 4);
+  }
+
+  void MathReceiverTester ::
+    testLanes()
+  {
+      // Three requests per tick, and a bulk message after every two urgent ones
+      this->paramSet_TICK_MESSAGE_BUDGET(3, Fw::ParamValid::VALID);
+      this->paramSend_TICK_MESSAGE_BUDGET(TEST_INSTANCE_ID, CMD_SEQ);
+      this->paramSet_URGENT_BURST(2, Fw::ParamValid::VALID);
+      this->paramSend_URGENT_BURST(TEST_INSTANCE_ID, CMD_SEQ);
+
+      this->clearHistory();
+      for (U32 i = 0; i < 5; i++) {
+          this->invoke_to_mathOpIn(0, i, 1.0f, MathOp::ADD, 2.0f);
+      }
+      for (U32 i = 10; i < 13; i++) {
+          this->invoke_to_mathOpUrgentIn(0, i, 3.0f, MathOp::MUL, 4.0f);
+      }
+      ASSERT_from_mathResultUrgentOut_SIZE(0);
+
+      // Urgent requests go first until the burst runs out
+      this->invoke_to_schedIn(0, 0);
+      ASSERT_from_mathResultUrgentOut_SIZE(2);
+      ASSERT_from_mathResultUrgentOut(0, 10, 12.0f);
+      ASSERT_from_mathResultUrgentOut(1, 11, 12.0f);
+      ASSERT_from_mathResultOut_SIZE(1);
+      ASSERT_from_mathResultOut(0, 0, 3.0f);
+      ASSERT_TLM_URGENT_DEPTH_SIZE(1);
+      ASSERT_TLM_URGENT_DEPTH(0, 3);
+      ASSERT_TLM_BULK_DEPTH_SIZE(1);
+      ASSERT_TLM_BULK_DEPTH(0, 5);
+      ASSERT_TLM_URGENT_WAIT_SIZE(1);
+      ASSERT_TLM_BULK_WAIT_SIZE(1);
+
+      // The last urgent request leads the next tick
+      this->clearHistory();
+      this->invoke_to_schedIn(0, 0);
+      ASSERT_from_mathResultUrgentOut_SIZE(1);
+      ASSERT_from_mathResultUrgentOut(0, 12, 12.0f);
+      ASSERT_from_mathResultOut_SIZE(2);
+      ASSERT_from_mathResultOut(0, 1, 3.0f);
+      ASSERT_from_mathResultOut(1, 2, 3.0f);
+
+      this->clearHistory();
+      this->invoke_to_schedIn(0, 0);
+      ASSERT_from_mathResultUrgentOut_SIZE(0);
+      ASSERT_from_mathResultOut_SIZE(2);
+      ASSERT_TLM_URGENT_DEPTH(0, 0);
+  }
+
+  void MathReceiverTester ::
+    testRecording()
+  {
+      const char* const path = "MathReceiverRecording.bin";
+
+      this->clearHistory();
+      this->sendCmd_START_RECORDING(TEST_INSTANCE_ID, CMD_SEQ, Fw::CmdStringArg(path), 2);
+      this->invoke_to_schedIn(0, 0);
+      ASSERT_CMD_RESPONSE_SIZE(1);
+      ASSERT_CMD_RESPONSE(0, MathReceiverComponentBase::OPCODE_START_RECORDING, CMD_SEQ, Fw::CmdResponse::OK);
+      ASSERT_EVENTS_RECORDING_STARTED_SIZE(1);
+      ASSERT_EVENTS_RECORDING_STARTED(0, path, 2);
+
+      // One log at a time
+      this->clearHistory();
+      this->sendCmd_START_RECORDING(TEST_INSTANCE_ID, CMD_SEQ + 1, Fw::CmdStringArg(path), 2);
+      this->invoke_to_schedIn(0, 0);
+      ASSERT_CMD_RESPONSE(0, MathReceiverComponentBase::OPCODE_START_RECORDING, CMD_SEQ + 1,
+                          Fw::CmdResponse::BUSY);
+
+      // Requests are stamped on arrival; the log has room for two of the three
+      this->clearHistory();
+      this->setTestTime(Fw::Time(TB_NONE, 30, 100));
+      this->invoke_to_mathOpIn(0, 7, 1.0f, MathOp::ADD, 2.0f);
+      this->setTestTime(Fw::Time(TB_NONE, 30, 600));
+      this->invoke_to_mathOpIn(0, 8, 3.0f, MathOp::DIV, 4.0f);
+      this->invoke_to_mathOpIn(0, 9, 5.0f, MathOp::MUL, 6.0f);
+      this->invoke_to_schedIn(0, 0);
+      ASSERT_from_mathResultOut_SIZE(3);
+      ASSERT_TLM_RECORDED_REQUESTS_SIZE(1);
+      ASSERT_TLM_RECORDED_REQUESTS(0, 2);
+      ASSERT_TLM_RECORD_DROPS_SIZE(1);
+      ASSERT_TLM_RECORD_DROPS(0, 1);
+
+      this->clearHistory();
+      this->sendCmd_STOP_RECORDING(TEST_INSTANCE_ID, CMD_SEQ);
+      this->invoke_to_schedIn(0, 0);
+      ASSERT_CMD_RESPONSE(0, MathReceiverComponentBase::OPCODE_STOP_RECORDING, CMD_SEQ, Fw::CmdResponse::OK);
+      ASSERT_EVENTS_RECORDING_STOPPED_SIZE(1);
+      ASSERT_EVENTS_RECORDING_STOPPED(0, 2, 1);
+
+      // The log holds the two requests in arrival order
+      MappedFile log;
+      ASSERT_TRUE(log.open(path));
+      U32 count = 0;
+      ASSERT_TRUE(RequestLog::readHeader(log.getData(), count));
+      ASSERT_EQ(count, 2U);
+      RequestLog::Record record;
+      RequestLog::readRecord(log.getData() + RequestLog::HEADER_SIZE, record);
+      ASSERT_EQ(record.requestId, 7U);
+      ASSERT_EQ(record.seconds, 30U);
+      ASSERT_EQ(record.useconds, 100U);
+      ASSERT_EQ(record.val2, 2.0f);
+      RequestLog::readRecord(log.getData() + RequestLog::HEADER_SIZE + RequestLog::RECORD_SIZE, record);
+      ASSERT_EQ(record.requestId, 8U);
+      ASSERT_EQ(record.useconds, 600U);
+      ASSERT_EQ(record.op, static_cast<U8>(MathOp::DIV));
+      log.close();
+      (void) remove(path);
+
+      // Nothing to stop now
+      this->clearHistory();
+      this->sendCmd_STOP_RECORDING(TEST_INSTANCE_ID, CMD_SEQ + 1);
+      this->invoke_to_schedIn(0, 0);
+      ASSERT_CMD_RESPONSE(0, MathReceiverComponentBase::OPCODE_STOP_RECORDING, CMD_SEQ + 1,
+                          Fw::CmdResponse::EXECUTION_ERROR);
+  }
+
   // ----------------------------------------------------------------------
   // Handlers for typed from ports
   // ----------------------------------------------------------------------
@@ -211,10 +1138,83 @@ namespace MathModule {
   void MathReceiverTester ::
     from_mathResultOut_handler(
         const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        F32 result
+    )
+  {
+    this->pushFromPortEntry_mathResultOut(requestId, result);
+  }
+
+  void MathReceiverTester ::
+    from_mathResultUrgentOut_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        F32 result
+    )
+  {
+    this->pushFromPortEntry_mathResultUrgentOut(requestId, result);
+  }
+
+  void MathReceiverTester ::
+    from_mathResultF64Out_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        F64 result
+    )
+  {
+    this->pushFromPortEntry_mathResultF64Out(requestId, result);
+  }
+
+  void MathReceiverTester ::
+    from_mathResultBatchOut_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        U32 count,
+        const MathModule::MathBatch &results
+    )
+  {
+    this->pushFromPortEntry_mathResultBatchOut(requestId, count, results);
+  }
+
+  void MathReceiverTester ::
+    from_vectorResultOut_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        const MathModule::VectorStatus &status,
+        U32 count,
+        Fw::Buffer &result
+    )
+  {
+    this->pushFromPortEntry_vectorResultOut(requestId, status, count, result);
+  }
+
+  void MathReceiverTester ::
+    from_creditOut_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 credits
+    )
+  {
+    this->m_creditsGranted += credits;
+  }
+
+  void MathReceiverTester ::
+    from_busyOut_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 busyUs
+    )
+  {
+    this->m_busyReports++;
+  }
+
+  void MathReceiverTester ::
+    from_exprResultOut_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        const MathModule::ExprStatus &status,
         F32 result
     )
   {
-    this->pushFromPortEntry_mathResultOut(result);
+    this->pushFromPortEntry_exprResultOut(requestId, status, result);
   }
 
 
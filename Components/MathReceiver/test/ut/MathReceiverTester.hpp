@@ -25,13 +25,20 @@ namespace MathModule {
       static const NATIVE_INT_TYPE MAX_HISTORY_SIZE = 10;
       // Instance ID supplied to the component instance under test
       static const NATIVE_INT_TYPE TEST_INSTANCE_ID = 0;
-      // Queue depth supplied to component instance under test
-      static const NATIVE_INT_TYPE TEST_INSTANCE_QUEUE_DEPTH = 10;
+      // Queue depth supplied to component instance under test; deep enough
+      // for the benchmark to queue up to 64 requests per drain
+      static const NATIVE_INT_TYPE TEST_INSTANCE_QUEUE_DEPTH = 64;
 
       //! Construct object MathReceiverTester
       //!
       MathReceiverTester();
 
+      //! Construct object MathReceiverTester with room for longer histories
+      //!
+      explicit MathReceiverTester(
+          NATIVE_INT_TYPE maxHistorySize /*!< The maximum size of each history*/
+      );
+
       //! Destroy object MathReceiverTester
       //!
       ~MathReceiverTester();
@@ -81,6 +88,44 @@ namespace MathModule {
 
     void testThrottle();
 
+    void testEventDriven();
+
+    void testDefaultDispatchMode();
+
+    void testBatch();
+
+    void testDrainOrder();
+
+    void testLatency();
+
+    void testTickBudget();
+
+    void testRing();
+
+    void testFactorCache();
+
+    void testOpSummary();
+
+    void testEventSummary();
+
+    void testExpr();
+
+    void testMemo();
+
+    void testMathFile();
+
+    void testF64();
+
+    void testVector();
+
+    void testCredits();
+
+    void testOverflow();
+
+    void testLanes();
+
+    void testRecording();
+
     private:
 
       // ----------------------------------------------------------------------
@@ -91,11 +136,70 @@ namespace MathModule {
       //!
       void from_mathResultOut_handler(
           const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< The identifier of the request*/
           F32 result /*!< 
       the result of the operation
       */
       );
 
+      //! Handler for from_mathResultUrgentOut
+      //!
+      void from_mathResultUrgentOut_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< The identifier of the request*/
+          F32 result /*!< The result of the operation*/
+      );
+
+      //! Handler for from_mathResultF64Out
+      //!
+      void from_mathResultF64Out_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< The identifier of the request*/
+          F64 result /*!< the result of the operation*/
+      );
+
+      //! Handler for from_mathResultBatchOut
+      //!
+      void from_mathResultBatchOut_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< The identifier of the request*/
+          U32 count, /*!< The number of valid results*/
+          const MathModule::MathBatch &results /*!< The results of the operation*/
+      );
+
+      //! Handler for from_vectorResultOut
+      //!
+      void from_vectorResultOut_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< The identifier of the request*/
+          const MathModule::VectorStatus &status, /*!< Whether the operation was performed*/
+          U32 count, /*!< The number of results*/
+          Fw::Buffer &result /*!< The buffer holding the results*/
+      );
+
+      //! Handler for from_creditOut
+      //! Adds to m_creditsGranted instead of the port history, which tests count in full
+      void from_creditOut_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 credits /*!< The number of credits granted*/
+      );
+
+      //! Handler for from_busyOut
+      //! Counts the reports in m_busyReports instead of the port history, which tests count in full
+      void from_busyOut_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 busyUs /*!< Microseconds spent serving requests since the last report*/
+      );
+
+      //! Handler for from_exprResultOut
+      //!
+      void from_exprResultOut_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< The identifier of the request*/
+          const MathModule::ExprStatus &status, /*!< Whether the expression compiled*/
+          F32 result /*!< The value of the expression*/
+      );
+
     private:
 
       // ----------------------------------------------------------------------
@@ -110,7 +214,7 @@ namespace MathModule {
       //!
       void initComponents();
 
-    private:
+    protected:
 
       // ----------------------------------------------------------------------
       // Variables
@@ -120,6 +224,12 @@ namespace MathModule {
       //!
       MathReceiver component;
 
+      //! Credits granted by the component so far
+      U32 m_creditsGranted;
+
+      //! Service time reports made by the component so far
+      U32 m_busyReports;
+
 
 
   };
@@ -0,0 +1,347 @@
+// ======================================================================
+// \title  MathReplay.cpp
+// \brief  cpp file for MathReplay component implementation class
+// ======================================================================
+
+
+#include <Components/MathReplay/MathReplay.hpp>
+#include <FpConfig.hpp>
+
+namespace MathModule {
+
+  // ----------------------------------------------------------------------
+  // Construction, initialization, and destruction
+  // ----------------------------------------------------------------------
+
+  MathReplay ::
+    MathReplay(
+        const char *const compName
+    ) : MathReplayComponentBase(compName),
+        m_records(0),
+        m_pacing(ReplayPacing::FAST),
+        m_window(0),
+        m_active(false),
+        m_opCode(0),
+        m_cmdSeq(0),
+        m_stopRequested(false),
+        m_taskDone(false),
+        m_tracker(REPLAY_ID_FLAG, REPLAY_ID_FLAG),
+        m_sent(0),
+        m_completed(0),
+        m_lost(0),
+        m_lastCompleted(0)
+  {
+
+  }
+
+  MathReplay ::
+    ~MathReplay()
+  {
+    if (this->m_active) {
+        this->m_stopRequested = true;
+        (void) this->m_task.join();
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for user-defined typed input ports
+  // ----------------------------------------------------------------------
+
+  void MathReplay ::
+    mathResultIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        F32 result
+    )
+  {
+    if (this->m_tracker.owns(requestId)) {
+        const Fw::Time now = this->getTime();
+        U32 latencyUs = 0;
+        this->m_lock.lock();
+        if (this->m_tracker.complete(requestId, now, latencyUs)) {
+            // A NaN result answers a request the receiver dropped, so it is lost without waiting for the timeout
+            if (result == result) {
+                this->m_completed++;
+                this->m_latency.record(latencyUs);
+            } else {
+                this->m_lost++;
+            }
+        }
+        this->m_lock.unLock();
+        // Late results of replayed requests stop here too, so the client never sees them
+        return;
+    }
+    if (this->isConnected_clientResultOut_OutputPort(0)) {
+        this->clientResultOut_out(0, requestId, result);
+    }
+  }
+
+  void MathReplay ::
+    schedIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        NATIVE_UINT_TYPE context
+    )
+  {
+    if (this->m_active && this->m_taskDone.load()) {
+        this->finishReplay(false);
+    }
+    this->publishTelemetry(this->getTime());
+  }
+
+  // ----------------------------------------------------------------------
+  // Command handler implementations
+  // ----------------------------------------------------------------------
+
+  void MathReplay ::
+    REPLAY_START_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq,
+        const Fw::CmdStringArg& path,
+        MathModule::ReplayPacing pacing
+    )
+  {
+    FW_ASSERT(pacing.isValid(), pacing.e);
+    if (this->m_active) {
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::BUSY);
+        return;
+    }
+    if (!this->m_log.open(path.toChar())) {
+        this->log_WARNING_HI_REPLAY_FAILED(MathFileError::OPEN_FAILED);
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+    // A log cut short by a failed recording still holds the records its header counts
+    U32 records = 0;
+    const FwSizeType size = this->m_log.getSize();
+    if ((size < RequestLog::HEADER_SIZE) ||
+        !RequestLog::readHeader(this->m_log.getData(), records) ||
+        (records == 0) ||
+        (((size - RequestLog::HEADER_SIZE) / RequestLog::RECORD_SIZE) < records)) {
+        this->m_log.close();
+        this->log_WARNING_HI_REPLAY_FAILED(MathFileError::BAD_SIZE);
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+
+    const Fw::Time now = this->getTime();
+    this->m_lock.lock();
+    this->m_tracker.reset();
+    this->m_sent = 0;
+    this->m_completed = 0;
+    this->m_lost = 0;
+    this->m_latency.reset();
+    this->m_startTime = now;
+    this->m_lock.unLock();
+    this->m_lastTick = now;
+    this->m_lastCompleted = 0;
+
+    // The command completes from schedIn once the last result is in
+    this->m_records = records;
+    this->m_pacing = pacing;
+    this->m_window = (pacing.e == ReplayPacing::FAST) ?
+        this->getReplayWindow() : static_cast<U32>(RequestTracker::CAPACITY);
+    this->m_opCode = opCode;
+    this->m_cmdSeq = cmdSeq;
+    this->m_stopRequested = false;
+    this->m_taskDone = false;
+    this->m_active = true;
+    Os::TaskString taskName("MathReplay");
+    Os::Task::Arguments arguments(taskName, MathReplay::replayTaskRoutine, this);
+    const Os::Task::Status taskStatus = this->m_task.start(arguments);
+    FW_ASSERT(taskStatus == Os::Task::OP_OK, taskStatus);
+    this->log_ACTIVITY_HI_REPLAY_STARTED(path, records, pacing);
+  }
+
+  void MathReplay ::
+    REPLAY_STOP_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq
+    )
+  {
+    if (!this->m_active) {
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+    // The task sleeps at most SLEEP_SLICE_US at a time, so the join is short
+    this->m_stopRequested = true;
+    this->finishReplay(true);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  U32 MathReplay ::
+    getReplayWindow()
+  {
+    Fw::ParamValid valid;
+    const U32 window = this->paramGet_REPLAY_WINDOW(valid);
+    FW_ASSERT(
+        valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT,
+        valid.e
+    );
+    return FW_MAX(static_cast<U32>(1), FW_MIN(window, static_cast<U32>(RequestTracker::CAPACITY)));
+  }
+
+  void MathReplay ::
+    replayTaskRoutine(void* arg)
+  {
+    FW_ASSERT(arg != nullptr);
+    static_cast<MathReplay*>(arg)->replay();
+  }
+
+  void MathReplay ::
+    replay()
+  {
+    const U8* const records = this->m_log.getData() + RequestLog::HEADER_SIZE;
+    RequestLog::Record first;
+    RequestLog::readRecord(records, first);
+    const Fw::Time start = this->getTime();
+
+    for (U32 i = 0; (i < this->m_records) && !this->m_stopRequested.load(); i++) {
+        RequestLog::Record record;
+        RequestLog::readRecord(records + static_cast<FwSizeType>(i) * RequestLog::RECORD_SIZE, record);
+        if (this->m_pacing.e == ReplayPacing::ORIGINAL) {
+            // Keep each request at its recorded offset from the first
+            const U64 due = offsetUs(first.seconds, first.useconds, record.seconds, record.useconds);
+            const Fw::Time now = this->getTime();
+            const U64 elapsed = offsetUs(start.getSeconds(), start.getUSeconds(),
+                                         now.getSeconds(), now.getUSeconds());
+            if (due > elapsed) {
+                this->sleepUs(due - elapsed);
+            }
+        }
+
+        // Wait for room in the window
+        bool room = false;
+        while (!this->m_stopRequested.load()) {
+            const Fw::Time now = this->getTime();
+            this->m_lock.lock();
+            this->m_lost += this->m_tracker.expire(now, LOST_TIMEOUT_US);
+            room = (this->m_tracker.getOutstanding() < this->m_window) && !this->m_tracker.isFull();
+            this->m_lock.unLock();
+            if (room) {
+                break;
+            }
+            this->sleepUs(POLL_US);
+        }
+        if (!room) {
+            break;
+        }
+        if (record.op >= MathOp::NUM_CONSTANTS) {
+            // Not a request this build can send
+            this->m_lock.lock();
+            this->m_lost++;
+            this->m_lock.unLock();
+            continue;
+        }
+
+        const Fw::Time sent = this->getTime();
+        this->m_lock.lock();
+        const U32 requestId = this->m_tracker.claim(sent);
+        this->m_sent++;
+        this->m_lock.unLock();
+        // The result may come back before this call returns
+        this->mathOpOut_out(0, requestId, record.val1, static_cast<MathOp::T>(record.op), record.val2);
+    }
+
+    // Collect the last results
+    while (!this->m_stopRequested.load()) {
+        const Fw::Time now = this->getTime();
+        this->m_lock.lock();
+        this->m_lost += this->m_tracker.expire(now, LOST_TIMEOUT_US);
+        const bool waiting = (this->m_tracker.getOutstanding() > 0);
+        this->m_lock.unLock();
+        if (!waiting) {
+            break;
+        }
+        this->sleepUs(POLL_US);
+    }
+    this->m_taskDone = true;
+  }
+
+  void MathReplay ::
+    sleepUs(U64 us)
+  {
+    while ((us > 0) && !this->m_stopRequested.load()) {
+        const U32 slice = static_cast<U32>(FW_MIN(us, static_cast<U64>(SLEEP_SLICE_US)));
+        (void) Os::Task::delay(Fw::TimeInterval(0, slice));
+        us -= slice;
+    }
+  }
+
+  void MathReplay ::
+    finishReplay(bool stopped)
+  {
+    FW_ASSERT(this->m_active);
+    (void) this->m_task.join();
+    this->m_log.close();
+    this->m_active = false;
+
+    // Results still due will not be counted; late ones pass on to the client
+    const Fw::Time now = this->getTime();
+    this->m_lock.lock();
+    this->m_lost += this->m_tracker.abandon();
+    const U32 sent = this->m_sent;
+    const U32 completed = this->m_completed;
+    const U32 lost = this->m_lost;
+    const U32 durationUs = LatencyHistogram::elapsedUs(this->m_startTime, now);
+    const LatencySummary latency(
+        this->m_latency.getCount(), this->m_latency.percentile(50),
+        this->m_latency.percentile(99), this->m_latency.getMax()
+    );
+    this->m_lock.unLock();
+
+    if (stopped) {
+        this->log_ACTIVITY_HI_REPLAY_STOPPED(sent);
+        this->cmdResponse_out(this->m_opCode, this->m_cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+    const U32 opsPerSec = (durationUs > 0) ?
+        static_cast<U32>((static_cast<U64>(completed) * 1000000U) / durationUs) : 0;
+    this->log_ACTIVITY_HI_REPLAY_COMPLETED(completed, lost, opsPerSec, latency);
+    this->cmdResponse_out(this->m_opCode, this->m_cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  void MathReplay ::
+    publishTelemetry(const Fw::Time& now)
+  {
+    this->m_lock.lock();
+    const U32 sent = this->m_sent;
+    const U32 completed = this->m_completed;
+    const U32 lost = this->m_lost;
+    const LatencySummary latency(
+        this->m_latency.getCount(), this->m_latency.percentile(50),
+        this->m_latency.percentile(99), this->m_latency.getMax()
+    );
+    this->m_lock.unLock();
+
+    // Throughput over the whole tick period
+    const U32 tickUs = LatencyHistogram::elapsedUs(this->m_lastTick, now);
+    const U32 opsPerSec = (tickUs > 0) ?
+        static_cast<U32>((static_cast<U64>(completed - this->m_lastCompleted) * 1000000U) / tickUs) : 0;
+    this->m_lastTick = now;
+    this->m_lastCompleted = completed;
+
+    this->tlmWrite_REPLAY_SENT(sent);
+    this->tlmWrite_REPLAY_RESULTS(completed);
+    this->tlmWrite_REPLAY_LOST(lost);
+    this->tlmWrite_REPLAY_OPS_PER_SEC(opsPerSec);
+    this->tlmWrite_REPLAY_LATENCY(latency);
+  }
+
+  U64 MathReplay ::
+    offsetUs(
+        U32 startSeconds,
+        U32 startUseconds,
+        U32 endSeconds,
+        U32 endUseconds
+    )
+  {
+    const U64 start = static_cast<U64>(startSeconds) * 1000000U + startUseconds;
+    const U64 end = static_cast<U64>(endSeconds) * 1000000U + endUseconds;
+    return (end > start) ? (end - start) : 0;
+  }
+
+} // end namespace MathModule
@@ -0,0 +1,207 @@
+// ======================================================================
+// \title  MathReplay.hpp
+// \brief  hpp file for MathReplay component implementation class
+// ======================================================================
+
+#ifndef MathReplay_HPP
+#define MathReplay_HPP
+
+#include "Components/MathReplay/MathReplayComponentAc.hpp"
+#include <Components/MathUtils/LatencyHistogram.hpp>
+#include <Components/MathUtils/MappedFile.hpp>
+#include <Components/MathUtils/RequestLog.hpp>
+#include <Components/MathUtils/RequestTracker.hpp>
+#include <Os/Mutex.hpp>
+#include <Os/Task.hpp>
+#include <atomic>
+
+namespace MathModule {
+
+  class MathReplay :
+    public MathReplayComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction, initialization, and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object MathReplay
+      //!
+      MathReplay(
+          const char *const compName /*!< The component name*/
+      );
+
+      //! Destroy object MathReplay
+      //!
+      ~MathReplay();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Constants and types
+      // ----------------------------------------------------------------------
+
+      enum {
+        //! Set in the identifier of every replayed request
+        REPLAY_ID_FLAG = 0x80000000,
+        //! Microseconds without a result before a request counts as lost
+        LOST_TIMEOUT_US = 1000000,
+        //! Microseconds the task sleeps while the window is full
+        POLL_US = 1000,
+        //! Longest single sleep of the task, in microseconds, so a stop is seen promptly
+        SLEEP_SLICE_US = 10000
+      };
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for user-defined typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for mathResultIn
+      //!
+      void mathResultIn_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< The identifier of the request*/
+          F32 result /*!< The result of the operation*/
+      );
+
+      //! Handler implementation for schedIn
+      //!
+      void schedIn_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          NATIVE_UINT_TYPE context /*!< The call order*/
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Command handler implementations
+      // ----------------------------------------------------------------------
+
+      //! Implementation for REPLAY_START command handler
+      //! Send the requests of a log recorded by MathReceiver; completes once every result is in
+      void REPLAY_START_cmdHandler(
+          const FwOpcodeType opCode, /*!< The opcode*/
+          const U32 cmdSeq, /*!< The command sequence number*/
+          const Fw::CmdStringArg& path, /*!< The request log*/
+          MathModule::ReplayPacing pacing /*!< How the requests are paced*/
+      );
+
+      //! Implementation for REPLAY_STOP command handler
+      //! Stop the running replay
+      void REPLAY_STOP_cmdHandler(
+          const FwOpcodeType opCode, /*!< The opcode*/
+          const U32 cmdSeq /*!< The command sequence number*/
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Current value of the REPLAY_WINDOW parameter, capped at the tracker capacity
+      U32 getReplayWindow();
+
+      //! Entry point of the replay task
+      static void replayTaskRoutine(
+          void* arg /*!< The MathReplay instance*/
+      );
+
+      //! Send every request of the log, then wait for the results; runs on the replay task
+      void replay();
+
+      //! Sleep on the replay task, waking early if a stop is requested
+      void sleepUs(
+          U64 us /*!< The time to sleep, in microseconds*/
+      );
+
+      //! Join the replay task, report the outcome, and complete the REPLAY_START command
+      void finishReplay(
+          bool stopped /*!< Whether REPLAY_STOP ended the replay*/
+      );
+
+      //! Write the replay telemetry
+      void publishTelemetry(
+          const Fw::Time& now /*!< The current time*/
+      );
+
+      //! Microseconds between two times, without the cap of LatencyHistogram::elapsedUs
+      static U64 offsetUs(
+          U32 startSeconds, /*!< Seconds of the earlier time*/
+          U32 startUseconds, /*!< Microseconds of the earlier time*/
+          U32 endSeconds, /*!< Seconds of the later time*/
+          U32 endUseconds /*!< Microseconds of the later time*/
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The log being replayed
+      MappedFile m_log;
+
+      //! Requests in the log
+      U32 m_records;
+
+      //! Pacing of the running replay
+      ReplayPacing m_pacing;
+
+      //! Requests in flight at once for the running replay
+      U32 m_window;
+
+      //! The replay task
+      Os::Task m_task;
+
+      //! Whether a replay is running or waiting to be finished
+      bool m_active;
+
+      //! Opcode of the running REPLAY_START command
+      FwOpcodeType m_opCode;
+
+      //! Sequence number of the running REPLAY_START command
+      U32 m_cmdSeq;
+
+      //! Set by REPLAY_STOP to end the replay task early
+      std::atomic<bool> m_stopRequested;
+
+      //! Set by the replay task once it has finished
+      std::atomic<bool> m_taskDone;
+
+      //! Guards the members below; never held across a port call
+      Os::Mutex m_lock;
+
+      //! Replayed requests waiting for results; ORIGINAL pacing may fill it
+      RequestTracker m_tracker;
+
+      //! Requests sent by the replay
+      U32 m_sent;
+
+      //! Results received for the replay
+      U32 m_completed;
+
+      //! Requests given up on without a result
+      U32 m_lost;
+
+      //! Round-trip times of the replay
+      LatencyHistogram m_latency;
+
+      //! When the replay started
+      Fw::Time m_startTime;
+
+      //! Time of the last schedIn call
+      Fw::Time m_lastTick;
+
+      //! Value of m_completed at the last schedIn call
+      U32 m_lastCompleted;
+
+    };
+
+} // end namespace MathModule
+
+#endif
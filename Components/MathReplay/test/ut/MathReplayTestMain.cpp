@@ -0,0 +1,32 @@
+// ----------------------------------------------------------------------
+// TestMain.cpp
+// ----------------------------------------------------------------------
+
+#include "MathReplayTester.hpp"
+#include "STest/Random/Random.hpp"
+
+TEST(Nominal, Fast) {
+    MathModule::MathReplayTester tester;
+    tester.testFast();
+}
+
+TEST(Nominal, Original) {
+    MathModule::MathReplayTester tester;
+    tester.testOriginal();
+}
+
+TEST(Nominal, Stop) {
+    MathModule::MathReplayTester tester;
+    tester.testStop();
+}
+
+TEST(Nominal, BadLog) {
+    MathModule::MathReplayTester tester;
+    tester.testBadLog();
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    STest::Random::seed();
+    return RUN_ALL_TESTS();
+}
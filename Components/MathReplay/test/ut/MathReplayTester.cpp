@@ -0,0 +1,224 @@
+// ======================================================================
+// \title  MathReplay.hpp
+// \brief  cpp file for MathReplay test harness implementation class
+// ======================================================================
+
+#include "MathReplayTester.hpp"
+#include "STest/Pick/Pick.hpp"
+#include <cstdio>
+
+namespace MathModule {
+  #define CMD_SEQ 42
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  MathReplayTester ::
+    MathReplayTester() :
+      MathReplayGTestBase("Tester", MathReplayTester::MAX_HISTORY_SIZE),
+      component("MathReplay"),
+      m_answer(true)
+  {
+    this->initComponents();
+    this->connectPorts();
+    this->component.loadParameters();
+  }
+
+  MathReplayTester ::
+    ~MathReplayTester()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void MathReplayTester ::
+    writeLog(
+        const char* path,
+        U32 count,
+        U32 headerCount
+    )
+  {
+    FILE* const file = fopen(path, "wb");
+    ASSERT_NE(file, nullptr);
+    U8 header[RequestLog::HEADER_SIZE];
+    RequestLog::writeHeader(header, headerCount);
+    ASSERT_EQ(fwrite(header, sizeof(header), 1, file), 1U);
+    for (U32 i = 0; i < count; i++) {
+        const RequestLog::Record record = {
+            30, i * 1000, i, static_cast<F32>(i + 1), 2.0f, static_cast<U8>(i % MathOp::NUM_CONSTANTS)
+        };
+        U8 bytes[RequestLog::RECORD_SIZE];
+        RequestLog::writeRecord(bytes, record);
+        ASSERT_EQ(fwrite(bytes, sizeof(bytes), 1, file), 1U);
+    }
+    (void) fclose(file);
+  }
+
+  void MathReplayTester ::
+    waitForReplay()
+  {
+    // The test time stands still, so only the task can end the replay
+    for (U32 i = 0; (i < 5000) && !this->component.m_taskDone.load(); i++) {
+        (void) Os::Task::delay(Fw::TimeInterval(0, 1000));
+    }
+    ASSERT_TRUE(this->component.m_taskDone.load());
+    this->invoke_to_schedIn(0, 0);
+  }
+
+  void MathReplayTester ::
+    testFast()
+  {
+    const char* const path = "MathReplayFast.bin";
+    this->writeLog(path, 3, 3);
+    this->paramSet_REPLAY_WINDOW(2, Fw::ParamValid::VALID);
+    this->paramSend_REPLAY_WINDOW(TEST_INSTANCE_ID, CMD_SEQ);
+
+    this->clearHistory();
+    this->sendCmd_REPLAY_START(TEST_INSTANCE_ID, CMD_SEQ, Fw::CmdStringArg(path), ReplayPacing::FAST);
+    ASSERT_EVENTS_REPLAY_STARTED_SIZE(1);
+    ASSERT_EVENTS_REPLAY_STARTED(0, path, 3, ReplayPacing::FAST);
+    this->waitForReplay();
+
+    // Each request goes out under a replay identifier
+    ASSERT_from_mathOpOut_SIZE(3);
+    ASSERT_from_mathOpOut(0, 0x80000000, 1.0f, MathOp::ADD, 2.0f);
+    ASSERT_from_mathOpOut(2, 0x80000002, 3.0f, MathOp::MUL, 2.0f);
+    ASSERT_from_clientResultOut_SIZE(0);
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, MathReplayComponentBase::OPCODE_REPLAY_START, CMD_SEQ, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_REPLAY_COMPLETED_SIZE(1);
+    ASSERT_EVENTS_REPLAY_COMPLETED(0, 3, 0, 0, LatencySummary(3, 0, 0, 0));
+    ASSERT_TLM_REPLAY_SENT(0, 3);
+    ASSERT_TLM_REPLAY_RESULTS(0, 3);
+    ASSERT_TLM_REPLAY_LOST(0, 0);
+
+    // Other results pass through, while stale replay identifiers stop here
+    this->clearHistory();
+    this->invoke_to_mathResultIn(0, 5, 1.0f);
+    this->invoke_to_mathResultIn(0, 0x80000001, 2.0f);
+    ASSERT_from_clientResultOut_SIZE(1);
+    ASSERT_from_clientResultOut(0, 5, 1.0f);
+    (void) remove(path);
+  }
+
+  void MathReplayTester ::
+    testOriginal()
+  {
+    // Requests recorded a millisecond apart are sent a millisecond apart
+    const char* const path = "MathReplayOriginal.bin";
+    this->writeLog(path, 4, 4);
+    this->clearHistory();
+    this->sendCmd_REPLAY_START(TEST_INSTANCE_ID, CMD_SEQ, Fw::CmdStringArg(path), ReplayPacing::ORIGINAL);
+    this->waitForReplay();
+    ASSERT_from_mathOpOut_SIZE(4);
+    ASSERT_from_mathOpOut(3, 0x80000003, 4.0f, MathOp::DIV, 2.0f);
+    ASSERT_CMD_RESPONSE(0, MathReplayComponentBase::OPCODE_REPLAY_START, CMD_SEQ, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_REPLAY_COMPLETED(0, 4, 0, 0, LatencySummary(4, 0, 0, 0));
+    (void) remove(path);
+  }
+
+  void MathReplayTester ::
+    testStop()
+  {
+    const char* const path = "MathReplayStop.bin";
+    this->writeLog(path, 3, 3);
+    this->paramSet_REPLAY_WINDOW(1, Fw::ParamValid::VALID);
+    this->paramSend_REPLAY_WINDOW(TEST_INSTANCE_ID, CMD_SEQ);
+
+    // Unanswered, the first request fills the window
+    this->m_answer = false;
+    this->clearHistory();
+    this->sendCmd_REPLAY_START(TEST_INSTANCE_ID, CMD_SEQ, Fw::CmdStringArg(path), ReplayPacing::FAST);
+    U32 outstanding = 0;
+    for (U32 i = 0; (i < 5000) && (outstanding == 0); i++) {
+        (void) Os::Task::delay(Fw::TimeInterval(0, 1000));
+        this->component.m_lock.lock();
+        outstanding = this->component.m_tracker.getOutstanding();
+        this->component.m_lock.unLock();
+    }
+    ASSERT_EQ(outstanding, 1U);
+
+    // One replay at a time
+    this->sendCmd_REPLAY_START(TEST_INSTANCE_ID, CMD_SEQ + 1, Fw::CmdStringArg(path), ReplayPacing::FAST);
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, MathReplayComponentBase::OPCODE_REPLAY_START, CMD_SEQ + 1, Fw::CmdResponse::BUSY);
+
+    this->sendCmd_REPLAY_STOP(TEST_INSTANCE_ID, CMD_SEQ + 2);
+    ASSERT_CMD_RESPONSE_SIZE(3);
+    ASSERT_CMD_RESPONSE(1, MathReplayComponentBase::OPCODE_REPLAY_START, CMD_SEQ,
+                        Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_CMD_RESPONSE(2, MathReplayComponentBase::OPCODE_REPLAY_STOP, CMD_SEQ + 2, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_REPLAY_STOPPED_SIZE(1);
+    ASSERT_EVENTS_REPLAY_STOPPED(0, 1);
+    ASSERT_from_mathOpOut_SIZE(1);
+
+    // The unanswered request counts as lost, and its late result is dropped
+    this->clearHistory();
+    this->invoke_to_mathResultIn(0, 0x80000000, 3.0f);
+    ASSERT_from_clientResultOut_SIZE(0);
+    this->invoke_to_schedIn(0, 0);
+    ASSERT_TLM_REPLAY_LOST(0, 1);
+
+    // Nothing to stop now
+    this->clearHistory();
+    this->sendCmd_REPLAY_STOP(TEST_INSTANCE_ID, CMD_SEQ);
+    ASSERT_CMD_RESPONSE(0, MathReplayComponentBase::OPCODE_REPLAY_STOP, CMD_SEQ,
+                        Fw::CmdResponse::EXECUTION_ERROR);
+    (void) remove(path);
+  }
+
+  void MathReplayTester ::
+    testBadLog()
+  {
+    const char* const path = "MathReplayBad.bin";
+    this->clearHistory();
+    this->sendCmd_REPLAY_START(TEST_INSTANCE_ID, CMD_SEQ, Fw::CmdStringArg(path), ReplayPacing::FAST);
+    ASSERT_EVENTS_REPLAY_FAILED(0, MathFileError::OPEN_FAILED);
+    ASSERT_CMD_RESPONSE(0, MathReplayComponentBase::OPCODE_REPLAY_START, CMD_SEQ,
+                        Fw::CmdResponse::EXECUTION_ERROR);
+
+    // A header that counts more records than the log holds
+    this->writeLog(path, 2, 3);
+    this->clearHistory();
+    this->sendCmd_REPLAY_START(TEST_INSTANCE_ID, CMD_SEQ, Fw::CmdStringArg(path), ReplayPacing::FAST);
+    ASSERT_EVENTS_REPLAY_FAILED(0, MathFileError::BAD_SIZE);
+    ASSERT_CMD_RESPONSE(0, MathReplayComponentBase::OPCODE_REPLAY_START, CMD_SEQ,
+                        Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_from_mathOpOut_SIZE(0);
+    (void) remove(path);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  void MathReplayTester ::
+    from_mathOpOut_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        F32 val1,
+        const MathModule::MathOp &op,
+        F32 val2
+    )
+  {
+    // Called on the replay task
+    this->pushFromPortEntry_mathOpOut(requestId, val1, op, val2);
+    if (this->m_answer) {
+        this->invoke_to_mathResultIn(0, requestId, val1 + val2);
+    }
+  }
+
+  void MathReplayTester ::
+    from_clientResultOut_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        F32 result
+    )
+  {
+    this->pushFromPortEntry_clientResultOut(requestId, result);
+  }
+
+} // end namespace MathModule
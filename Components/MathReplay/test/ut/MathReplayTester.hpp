@@ -0,0 +1,111 @@
+// ======================================================================
+// \title  MathReplay/test/ut/Tester.hpp
+// \brief  hpp file for MathReplay test harness implementation class
+// ======================================================================
+
+#ifndef TESTER_HPP
+#define TESTER_HPP
+
+#include "MathReplayGTestBase.hpp"
+#include "Components/MathReplay/MathReplay.hpp"
+
+namespace MathModule {
+
+  class MathReplayTester :
+    public MathReplayGTestBase
+  {
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+    public:
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const NATIVE_INT_TYPE MAX_HISTORY_SIZE = 10;
+      // Instance ID supplied to the component instance under test
+      static const NATIVE_INT_TYPE TEST_INSTANCE_ID = 0;
+
+      //! Construct object MathReplayTester
+      //!
+      MathReplayTester();
+
+      //! Destroy object MathReplayTester
+      //!
+      ~MathReplayTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      //! Write a log of count requests, one per millisecond, whose header claims headerCount
+      void writeLog(const char* path, U32 count, U32 headerCount);
+
+      //! Wait for the replay task to finish, then tick once so the replay completes
+      void waitForReplay();
+
+      void testFast();
+
+      void testOriginal();
+
+      void testStop();
+
+      void testBadLog();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Handlers for typed from ports
+      // ----------------------------------------------------------------------
+
+      //! Handler for from_mathOpOut
+      //!
+      void from_mathOpOut_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< Identifies the request in the matching result*/
+          F32 val1, /*!< The first operand*/
+          const MathModule::MathOp &op, /*!< The operation*/
+          F32 val2 /*!< The second operand*/
+      );
+
+      //! Handler for from_clientResultOut
+      //!
+      void from_clientResultOut_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< The identifier of the request*/
+          F32 result /*!< The result of the operation*/
+      );
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper methods
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      //!
+      void connectPorts();
+
+      //! Initialize components
+      //!
+      void initComponents();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      //!
+      MathReplay component;
+
+      //! Whether mathOpOut requests are answered at once with the sum of their operands
+      bool m_answer;
+
+  };
+
+} // end namespace MathModule
+
+#endif
@@ -0,0 +1,241 @@
+// ======================================================================
+// \title  MathRouter.cpp
+// \brief  cpp file for MathRouter component implementation class
+// ======================================================================
+
+
+#include <Components/MathRouter/MathRouter.hpp>
+#include <Components/MathUtils/LatencyHistogram.hpp>
+#include <FpConfig.hpp>
+
+namespace MathModule {
+
+  // ----------------------------------------------------------------------
+  // Construction, initialization, and destruction
+  // ----------------------------------------------------------------------
+
+  MathRouter ::
+    MathRouter(
+        const char *const compName
+    ) : MathRouterComponentBase(compName),
+        m_nextWorker(0),
+        m_ticked(false)
+  {
+    for (U32 i = 0; i < NUM_WORKERS; i++) {
+        this->m_workers[i].inFlight = 0;
+        this->m_workers[i].completed = 0;
+        this->m_workers[i].busyUs = 0;
+        this->m_workers[i].credits = 0;
+        this->m_workers[i].owed = 0;
+    }
+  }
+
+  MathRouter ::
+    ~MathRouter()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for user-defined typed input ports
+  // ----------------------------------------------------------------------
+
+  void MathRouter ::
+    mathOpIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        F32 val1,
+        const MathModule::MathOp &op,
+        F32 val2
+    )
+  {
+    this->route(requestId, val1, op, val2, true);
+  }
+
+  void MathRouter ::
+    mathOpUncreditedIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        F32 val1,
+        const MathModule::MathOp &op,
+        F32 val2
+    )
+  {
+    this->route(requestId, val1, op, val2, false);
+  }
+
+  void MathRouter ::
+    workerResultIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        F32 result
+    )
+  {
+    FW_ASSERT(portNum >= 0 && portNum < NUM_WORKERS, portNum);
+    WorkerState& state = this->m_workers[portNum];
+    if (state.inFlight > 0) {
+        state.inFlight--;
+    }
+    state.completed++;
+    this->mathResultOut_out(0, requestId, result);
+  }
+
+  void MathRouter ::
+    workerCreditIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 credits
+    )
+  {
+    FW_ASSERT(portNum >= 0 && portNum < NUM_WORKERS, portNum);
+    WorkerState& state = this->m_workers[portNum];
+    // The worker grants a credit back for every request it dequeues, so the
+    // ones for requests that spent none go to settle what is owed
+    const U32 settled = FW_MIN(state.owed, credits);
+    state.owed -= settled;
+    const U32 granted = credits - settled;
+    state.credits += granted;
+    // The sender sees one pool; pickWorker spends it where it was granted
+    if ((granted > 0) && this->isConnected_creditOut_OutputPort(0)) {
+        this->creditOut_out(0, granted);
+    }
+  }
+
+  void MathRouter ::
+    workerBusyIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 busyUs
+    )
+  {
+    FW_ASSERT(portNum >= 0 && portNum < NUM_WORKERS, portNum);
+    // Time in flight would count the wait in the worker queue; the worker reports only its service time
+    WorkerState& state = this->m_workers[portNum];
+    state.busyUs = static_cast<U32>(
+        FW_MIN(static_cast<U64>(state.busyUs) + busyUs, static_cast<U64>(0xFFFFFFFF))
+    );
+  }
+
+  void MathRouter ::
+    schedIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        NATIVE_UINT_TYPE context
+    )
+  {
+    const Fw::Time now = this->getTime();
+    const U32 tickUs = this->m_ticked ? LatencyHistogram::elapsedUs(this->m_lastTick, now) : 0;
+
+    WorkerCounts inFlight;
+    WorkerCounts utilization;
+    WorkerCounts completed;
+    for (U32 i = 0; i < NUM_WORKERS; i++) {
+        WorkerState& state = this->m_workers[i];
+        const U32 busyUs = state.busyUs;
+        state.busyUs = 0;
+
+        inFlight[i] = state.inFlight;
+        utilization[i] = (tickUs > 0) ? static_cast<U32>(
+            FW_MIN(static_cast<U64>(busyUs) * 100 / tickUs, static_cast<U64>(100))
+        ) : 0;
+        completed[i] = state.completed;
+    }
+    this->m_lastTick = now;
+    this->m_ticked = true;
+
+    this->tlmWrite_WORKER_IN_FLIGHT(inFlight);
+    this->tlmWrite_WORKER_UTILIZATION(utilization);
+    this->tlmWrite_WORKER_OPS(completed);
+  }
+
+  // ----------------------------------------------------------------------
+  // Parameter updates
+  // ----------------------------------------------------------------------
+
+  void MathRouter ::
+    parameterUpdated(FwPrmIdType id)
+  {
+      switch (id) {
+          case PARAMID_ROUTING_POLICY:
+              this->log_ACTIVITY_HI_ROUTING_POLICY_UPDATED(this->getRoutingPolicy());
+              break;
+          default:
+              FW_ASSERT(0, id);
+              break;
+      }
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  RoutingPolicy MathRouter ::
+    getRoutingPolicy()
+  {
+    Fw::ParamValid valid;
+    const RoutingPolicy policy = this->paramGet_ROUTING_POLICY(valid);
+    FW_ASSERT(
+        valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT,
+        valid.e
+    );
+    return policy;
+  }
+
+  void MathRouter ::
+    route(
+        U32 requestId,
+        F32 val1,
+        const MathModule::MathOp &op,
+        F32 val2,
+        bool credited
+    )
+  {
+    const U32 worker = this->pickWorker(credited);
+    if (worker == NO_WORKER) {
+        // The sender times the request out
+        this->log_WARNING_HI_NO_WORKER_AVAILABLE(requestId);
+        return;
+    }
+    WorkerState& state = this->m_workers[worker];
+    state.inFlight++;
+    if (credited && (state.credits > 0)) {
+        state.credits--;
+    } else {
+        state.owed++;
+    }
+    this->workerOpOut_out(static_cast<NATIVE_INT_TYPE>(worker), requestId, val1, op, val2);
+  }
+
+  U32 MathRouter ::
+    pickWorker(bool credited)
+  {
+    const RoutingPolicy policy = this->getRoutingPolicy();
+    // Without credits from any worker, every connected worker is a candidate;
+    // uncredited requests may go to any of them
+    bool holding = false;
+    for (U32 i = 0; credited && (i < NUM_WORKERS); i++) {
+        holding = holding || (this->m_workers[i].credits > 0);
+    }
+    U32 chosen = NO_WORKER;
+    // Scanning from m_nextWorker breaks ties in round-robin order
+    for (U32 i = 0; i < NUM_WORKERS; i++) {
+        const U32 worker = (this->m_nextWorker + i) % NUM_WORKERS;
+        if (!this->isConnected_workerOpOut_OutputPort(static_cast<NATIVE_INT_TYPE>(worker))) {
+            continue;
+        }
+        if (holding && (this->m_workers[worker].credits == 0)) {
+            continue;
+        }
+        if (policy.e == RoutingPolicy::ROUND_ROBIN) {
+            chosen = worker;
+            break;
+        }
+        if ((chosen == NO_WORKER) ||
+            (this->m_workers[worker].inFlight < this->m_workers[chosen].inFlight)) {
+            chosen = worker;
+        }
+    }
+    if (chosen != NO_WORKER) {
+        this->m_nextWorker = (chosen + 1) % NUM_WORKERS;
+    }
+    return chosen;
+  }
+
+} // end namespace MathModule
@@ -0,0 +1,166 @@
+// ======================================================================
+// \title  MathRouter.hpp
+// \brief  hpp file for MathRouter component implementation class
+// ======================================================================
+
+#ifndef MathRouter_HPP
+#define MathRouter_HPP
+
+#include "Components/MathRouter/MathRouterComponentAc.hpp"
+
+namespace MathModule {
+
+  class MathRouter :
+    public MathRouterComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction, initialization, and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object MathRouter
+      //!
+      MathRouter(
+          const char *const compName /*!< The component name*/
+      );
+
+      //! Destroy object MathRouter
+      //!
+      ~MathRouter();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Constants and types
+      // ----------------------------------------------------------------------
+
+      enum {
+        //! Number of workers
+        NUM_WORKERS = WorkerCounts::SIZE,
+        //! Returned by pickWorker when no worker is connected
+        NO_WORKER = NUM_WORKERS
+      };
+
+      //! Load accounting for one worker
+      struct WorkerState {
+        U32 inFlight; //!< Requests routed to the worker and not yet answered
+        U32 completed; //!< Requests the worker has answered
+        U32 busyUs; //!< Time the worker reported serving requests since the last tick
+        U32 credits; //!< Requests the worker has room for in its queue
+        U32 owed; //!< Credits the worker will grant back for requests that spent none
+      };
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for user-defined typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for mathOpIn
+      //!
+      void mathOpIn_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< Identifies the request in the matching result*/
+          F32 val1, /*!< The first operand*/
+          const MathModule::MathOp &op, /*!< The operation*/
+          F32 val2 /*!< The second operand*/
+      );
+
+      //! Handler implementation for mathOpUncreditedIn
+      //!
+      void mathOpUncreditedIn_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< Identifies the request in the matching result*/
+          F32 val1, /*!< The first operand*/
+          const MathModule::MathOp &op, /*!< The operation*/
+          F32 val2 /*!< The second operand*/
+      );
+
+      //! Handler implementation for workerResultIn
+      //!
+      void workerResultIn_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number, which is the worker*/
+          U32 requestId, /*!< The identifier of the request*/
+          F32 result /*!< The result of the operation*/
+      );
+
+      //! Handler implementation for workerCreditIn
+      //!
+      void workerCreditIn_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number, which is the worker*/
+          U32 credits /*!< The number of credits granted*/
+      );
+
+      //! Handler implementation for workerBusyIn
+      //!
+      void workerBusyIn_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number, which is the worker*/
+          U32 busyUs /*!< Microseconds spent serving requests since the last report*/
+      );
+
+      //! Handler implementation for schedIn
+      //!
+      void schedIn_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          NATIVE_UINT_TYPE context /*!< The call order*/
+      );
+
+      //! Report a routing policy change
+      void parameterUpdated(FwPrmIdType id);
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Current value of the ROUTING_POLICY parameter
+      RoutingPolicy getRoutingPolicy();
+
+      //! Pick a worker and send it a request
+      //!
+      //! A request that spends no credit is owed to its worker, so the credit
+      //! the worker grants back for it is not passed on to the sender.
+      void route(
+          U32 requestId, /*!< Identifies the request in the matching result*/
+          F32 val1, /*!< The first operand*/
+          const MathModule::MathOp &op, /*!< The operation*/
+          F32 val2, /*!< The second operand*/
+          bool credited /*!< Whether the request may spend a credit*/
+      );
+
+      //! Pick the worker for the next request
+      //!
+      //! For a credited request, workers holding credits are preferred, so a
+      //! credited sender never overfills a worker queue.
+      //!
+      //! \return the worker index, or NO_WORKER if none is connected
+      U32 pickWorker(
+          bool credited /*!< Whether the request may spend a credit*/
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! Load accounting, one entry per worker
+      WorkerState m_workers[NUM_WORKERS];
+
+      //! Worker considered first for the next request
+      U32 m_nextWorker;
+
+      //! Time of the last schedIn call
+      Fw::Time m_lastTick;
+
+      //! Whether schedIn has been called
+      bool m_ticked;
+
+    };
+
+} // end namespace MathModule
+
+#endif
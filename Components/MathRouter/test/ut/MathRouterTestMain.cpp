@@ -0,0 +1,37 @@
+// ----------------------------------------------------------------------
+// TestMain.cpp
+// ----------------------------------------------------------------------
+
+#include "MathRouterTester.hpp"
+#include "STest/Random/Random.hpp"
+
+TEST(Nominal, RoundRobin) {
+    MathModule::MathRouterTester tester;
+    tester.testRoundRobin();
+}
+
+TEST(Nominal, LeastQueueDepth) {
+    MathModule::MathRouterTester tester;
+    tester.testLeastQueueDepth();
+}
+
+TEST(Nominal, Utilization) {
+    MathModule::MathRouterTester tester;
+    tester.testUtilization();
+}
+
+TEST(Nominal, Credits) {
+    MathModule::MathRouterTester tester;
+    tester.testCredits();
+}
+
+TEST(Nominal, Uncredited) {
+    MathModule::MathRouterTester tester;
+    tester.testUncredited();
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    STest::Random::seed();
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,226 @@
+// ======================================================================
+// \title  MathRouter.hpp
+// \brief  cpp file for MathRouter test harness implementation class
+// ======================================================================
+
+#include "MathRouterTester.hpp"
+#include "STest/Pick/Pick.hpp"
+
+namespace MathModule {
+  #define CMD_SEQ 42
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  MathRouterTester ::
+    MathRouterTester() :
+      MathRouterGTestBase("Tester", MathRouterTester::MAX_HISTORY_SIZE),
+      component("MathRouter")
+  {
+    this->initComponents();
+    this->connectPorts();
+    this->component.loadParameters();
+  }
+
+  MathRouterTester ::
+    ~MathRouterTester()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  NATIVE_INT_TYPE MathRouterTester ::
+    routeRequest(U32 requestId)
+  {
+    this->clearHistory();
+    this->invoke_to_mathOpIn(0, requestId, 1.0, MathOp::ADD, 2.0);
+    EXPECT_EQ(this->fromPortHistory_workerOpOut->size(), 1U);
+    EXPECT_EQ(this->fromPortHistory_workerOpOut->at(0).requestId, requestId);
+    return this->m_routedWorkers[0];
+  }
+
+  void MathRouterTester ::
+    testRoundRobin()
+  {
+    // Requests cycle through the workers in order
+    for (U32 i = 0; i < 2 * WorkerCounts::SIZE; i++) {
+        ASSERT_EQ(this->routeRequest(i), static_cast<NATIVE_INT_TYPE>(i % WorkerCounts::SIZE));
+    }
+
+    // A worker's result goes back to the sender unchanged
+    this->clearHistory();
+    this->invoke_to_workerResultIn(2, 6, 3.0);
+    ASSERT_from_mathResultOut_SIZE(1);
+    ASSERT_from_mathResultOut(0, 6, 3.0);
+  }
+
+  void MathRouterTester ::
+    testLeastQueueDepth()
+  {
+    this->clearHistory();
+    this->paramSet_ROUTING_POLICY(RoutingPolicy::LEAST_QUEUE_DEPTH, Fw::ParamValid::VALID);
+    this->paramSend_ROUTING_POLICY(TEST_INSTANCE_ID, CMD_SEQ);
+    ASSERT_EVENTS_ROUTING_POLICY_UPDATED_SIZE(1);
+    ASSERT_EVENTS_ROUTING_POLICY_UPDATED(0, RoutingPolicy::LEAST_QUEUE_DEPTH);
+
+    // Idle workers tie, so the first requests spread out
+    for (U32 i = 0; i < WorkerCounts::SIZE; i++) {
+        ASSERT_EQ(this->routeRequest(i), static_cast<NATIVE_INT_TYPE>(i));
+    }
+
+    // Workers 1 and 3 finish; they take the next requests
+    this->invoke_to_workerResultIn(1, 1, 0.0);
+    this->invoke_to_workerResultIn(3, 3, 0.0);
+    ASSERT_EQ(this->routeRequest(10), 1);
+    ASSERT_EQ(this->routeRequest(11), 3);
+
+    this->clearHistory();
+    this->invoke_to_schedIn(0, 0);
+    WorkerCounts inFlight;
+    for (U32 i = 0; i < WorkerCounts::SIZE; i++) {
+        inFlight[i] = 1;
+    }
+    ASSERT_TLM_WORKER_IN_FLIGHT_SIZE(1);
+    ASSERT_TLM_WORKER_IN_FLIGHT(0, inFlight);
+  }
+
+  void MathRouterTester ::
+    testUtilization()
+  {
+    this->setTestTime(Fw::Time(TB_NONE, 50, 0));
+    this->invoke_to_schedIn(0, 0);
+
+    // Worker 0 serves its request for a quarter of the tick
+    ASSERT_EQ(this->routeRequest(1), 0);
+    this->invoke_to_workerBusyIn(0, 250000);
+    this->invoke_to_workerResultIn(0, 1, 0.0);
+
+    // Worker 1 has a request waiting in its queue but has served it for only a tenth of the tick
+    ASSERT_EQ(this->routeRequest(2), 1);
+    this->invoke_to_workerBusyIn(1, 60000);
+    this->invoke_to_workerBusyIn(1, 40000);
+
+    this->setTestTime(Fw::Time(TB_NONE, 51, 0));
+    this->clearHistory();
+    this->invoke_to_schedIn(0, 0);
+
+    WorkerCounts utilization;
+    utilization[0] = 25;
+    utilization[1] = 10;
+    WorkerCounts inFlight;
+    inFlight[1] = 1;
+    WorkerCounts completed;
+    completed[0] = 1;
+    ASSERT_TLM_WORKER_UTILIZATION(0, utilization);
+    ASSERT_TLM_WORKER_IN_FLIGHT(0, inFlight);
+    ASSERT_TLM_WORKER_OPS(0, completed);
+
+    // Time in flight is not service time: a tick without reports shows no load
+    this->setTestTime(Fw::Time(TB_NONE, 52, 0));
+    this->clearHistory();
+    this->invoke_to_schedIn(0, 0);
+    utilization[0] = 0;
+    utilization[1] = 0;
+    ASSERT_TLM_WORKER_UTILIZATION(0, utilization);
+
+    // Reports beyond the tick saturate at full load
+    this->invoke_to_workerBusyIn(1, 3000000);
+    this->setTestTime(Fw::Time(TB_NONE, 53, 0));
+    this->clearHistory();
+    this->invoke_to_schedIn(0, 0);
+    utilization[1] = 100;
+    ASSERT_TLM_WORKER_UTILIZATION(0, utilization);
+  }
+
+  void MathRouterTester ::
+    testCredits()
+  {
+    // Worker grants reach the sender as they arrive
+    this->clearHistory();
+    this->invoke_to_workerCreditIn(2, 1);
+    this->invoke_to_workerCreditIn(3, 2);
+    ASSERT_from_creditOut_SIZE(2);
+    ASSERT_from_creditOut(0, 1);
+    ASSERT_from_creditOut(1, 2);
+
+    // Only workers holding credits are picked, in round-robin order
+    ASSERT_EQ(this->routeRequest(0), 2);
+    ASSERT_EQ(this->routeRequest(1), 3);
+    ASSERT_EQ(this->routeRequest(2), 3);
+
+    // Once every credit is spent, requests spread over all workers again
+    ASSERT_EQ(this->routeRequest(3), 0);
+    ASSERT_EQ(this->routeRequest(4), 1);
+  }
+
+  void MathRouterTester ::
+    testUncredited()
+  {
+    this->invoke_to_workerCreditIn(1, 2);
+
+    // An uncredited request may go to a worker without credits and leaves the credits alone
+    this->clearHistory();
+    this->invoke_to_mathOpUncreditedIn(0, 1, 1.0, MathOp::ADD, 2.0);
+    ASSERT_from_workerOpOut_SIZE(1);
+    ASSERT_EQ(this->m_routedWorkers[0], 0);
+
+    // The credit worker 0 grants back for it is kept, and only the rest reaches the sender
+    this->clearHistory();
+    this->invoke_to_workerCreditIn(0, 1);
+    ASSERT_from_creditOut_SIZE(0);
+    this->invoke_to_workerCreditIn(0, 2);
+    ASSERT_from_creditOut_SIZE(1);
+    ASSERT_from_creditOut(0, 2);
+
+    // Credited requests spend the credits the sender was passed
+    ASSERT_EQ(this->routeRequest(2), 1);
+    ASSERT_EQ(this->routeRequest(3), 0);
+    ASSERT_EQ(this->routeRequest(4), 1);
+    ASSERT_EQ(this->routeRequest(5), 0);
+    this->clearHistory();
+    this->invoke_to_workerCreditIn(1, 2);
+    ASSERT_from_creditOut_SIZE(1);
+    ASSERT_from_creditOut(0, 2);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  void MathRouterTester ::
+    from_mathResultOut_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        F32 result
+    )
+  {
+    this->pushFromPortEntry_mathResultOut(requestId, result);
+  }
+
+  void MathRouterTester ::
+    from_creditOut_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 credits
+    )
+  {
+    this->pushFromPortEntry_creditOut(credits);
+  }
+
+  void MathRouterTester ::
+    from_workerOpOut_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        F32 val1,
+        const MathModule::MathOp &op,
+        F32 val2
+    )
+  {
+    // Remember which worker each request went to
+    this->m_routedWorkers[this->fromPortHistory_workerOpOut->size()] = portNum;
+    this->pushFromPortEntry_workerOpOut(requestId, val1, op, val2);
+  }
+
+} // end namespace MathModule
@@ -0,0 +1,117 @@
+// ======================================================================
+// \title  MathRouter/test/ut/Tester.hpp
+// \brief  hpp file for MathRouter test harness implementation class
+// ======================================================================
+
+#ifndef TESTER_HPP
+#define TESTER_HPP
+
+#include "MathRouterGTestBase.hpp"
+#include "Components/MathRouter/MathRouter.hpp"
+
+namespace MathModule {
+
+  class MathRouterTester :
+    public MathRouterGTestBase
+  {
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+    public:
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const NATIVE_INT_TYPE MAX_HISTORY_SIZE = 10;
+      // Instance ID supplied to the component instance under test
+      static const NATIVE_INT_TYPE TEST_INSTANCE_ID = 0;
+
+      //! Construct object MathRouterTester
+      //!
+      MathRouterTester();
+
+      //! Destroy object MathRouterTester
+      //!
+      ~MathRouterTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      //! Route a request and return the worker it went to
+      NATIVE_INT_TYPE routeRequest(U32 requestId);
+
+      void testRoundRobin();
+
+      void testLeastQueueDepth();
+
+      void testUtilization();
+
+      void testCredits();
+
+      void testUncredited();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Handlers for typed from ports
+      // ----------------------------------------------------------------------
+
+      //! Handler for from_mathResultOut
+      //!
+      void from_mathResultOut_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< The identifier of the request*/
+          F32 result /*!< The result of the operation*/
+      );
+
+      //! Handler for from_creditOut
+      //!
+      void from_creditOut_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 credits /*!< The number of credits granted*/
+      );
+
+      //! Handler for from_workerOpOut
+      //!
+      void from_workerOpOut_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< Identifies the request in the matching result*/
+          F32 val1, /*!< The first operand*/
+          const MathModule::MathOp &op, /*!< The operation*/
+          F32 val2 /*!< The second operand*/
+      );
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper methods
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      //!
+      void connectPorts();
+
+      //! Initialize components
+      //!
+      void initComponents();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      //!
+      MathRouter component;
+
+      //! Worker port of each workerOpOut history entry
+      NATIVE_INT_TYPE m_routedWorkers[MAX_HISTORY_SIZE];
+
+  };
+
+} // end namespace MathModule
+
+#endif
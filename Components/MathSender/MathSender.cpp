@@ -10,6 +10,9 @@
 
 namespace MathModule {
 
+  static_assert(LatencyBuckets::SIZE == LatencyHistogram::NUM_BUCKETS,
+                "LatencyBuckets must hold every histogram bucket");
+
   // ----------------------------------------------------------------------
   // Construction, initialization, and destruction
   // ----------------------------------------------------------------------
@@ -17,9 +20,33 @@ namespace MathModule {
   MathSender ::
     MathSender(
         const char *const compName
-    ) : MathSenderComponentBase(compName)
+    ) : MathSenderComponentBase(compName),
+        m_inFlightCount(0),
+        m_nextRequestId(0),
+        m_latencyUpdated(false),
+        m_tlmVal1(0),
+        m_tlmOp(MathOp::ADD),
+        m_tlmVal2(0),
+        m_tlmRequestDirty(false),
+        m_tlmResult(0),
+        m_tlmResultDirty(false),
+        m_tlmResultF64(0),
+        m_tlmResultF64Dirty(false),
+        m_lastInFlight(0),
+        m_creditsEnabled(false),
+        m_credits(0),
+        m_creditStalls(0),
+        m_creditRejects(0),
+        m_tlmCreditsDirty(false),
+        m_streamCount(0),
+        m_streamSequence(0),
+        m_streamResults(0),
+        m_streamDrops(0),
+        m_tlmStreamDirty(false)
   {
-
+    for (U32 i = 0; i < MAX_IN_FLIGHT; i++) {
+        this->m_inFlight[i].active = false;
+    }
   }
 
   MathSender ::
@@ -35,11 +62,123 @@ namespace MathModule {
   void MathSender ::
     mathResultIn_handler(
         const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        F32 result
+    )
+  {
+      InFlightRequest* const request = this->matchResult(requestId, KIND_MATH);
+      if (request == nullptr) {
+          return;
+      }
+      this->finishMath(*request, result);
+  }
+
+  void MathSender ::
+    mathResultUrgentIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
         F32 result
     )
   {
-      this->tlmWrite_RESULT(result);
-      this->log_ACTIVITY_HI_RESULT(result);
+      InFlightRequest* const request = this->matchResult(requestId, KIND_MATH_URGENT);
+      if (request == nullptr) {
+          return;
+      }
+      this->finishMath(*request, result);
+  }
+
+  void MathSender ::
+    creditIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 credits
+    )
+  {
+      this->m_creditsEnabled = true;
+      this->m_credits += credits;
+      this->m_tlmCreditsDirty = true;
+      // Request IDs map to table slots in order, so a scan of the last
+      // MAX_IN_FLIGHT IDs releases held requests oldest first
+      for (U32 i = 0; (i < MAX_IN_FLIGHT) && (this->m_credits > 0); i++) {
+          const U32 requestId = this->m_nextRequestId - MAX_IN_FLIGHT + i;
+          InFlightRequest& request = this->m_inFlight[requestId % MAX_IN_FLIGHT];
+          if (request.active && request.held && (request.requestId == requestId)) {
+              this->sendMath(request);
+          }
+      }
+  }
+
+  void MathSender ::
+    mathResultF64In_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        F64 result
+    )
+  {
+      InFlightRequest* const request = this->matchResult(requestId, KIND_MATH_F64);
+      if (request == nullptr) {
+          return;
+      }
+      this->m_roundTripLatency[request->op].record(
+          LatencyHistogram::elapsedUs(request->sent, this->getTime())
+      );
+      this->m_latencyUpdated = true;
+      this->m_tlmResultF64 = result;
+      this->m_tlmResultF64Dirty = true;
+      // The result stream carries single precision results only
+      this->log_ACTIVITY_HI_RESULT_F64(result);
+      this->completeRequest(*request, Fw::CmdResponse::OK);
+  }
+
+  void MathSender ::
+    exprResultIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        const MathModule::ExprStatus &status,
+        F32 result
+    )
+  {
+      InFlightRequest* const request = this->matchResult(requestId, KIND_EXPR);
+      if (request == nullptr) {
+          return;
+      }
+      if (status.e != ExprStatus::OK) {
+          // MathReceiver reports why the expression was rejected
+          this->completeRequest(*request, Fw::CmdResponse::VALIDATION_ERROR);
+          return;
+      }
+      this->m_tlmResult = result;
+      this->m_tlmResultDirty = true;
+      if (this->getResultStream()) {
+          this->streamResult(requestId, result);
+      } else {
+          this->log_ACTIVITY_HI_RESULT(result);
+      }
+      this->completeRequest(*request, Fw::CmdResponse::OK);
+  }
+
+  void MathSender ::
+    schedIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        NATIVE_UINT_TYPE context
+    )
+  {
+      // Fail commands whose result has not arrived in time
+      const U32 timeout = this->getRequestTimeout();
+      for (U32 i = 0; i < MAX_IN_FLIGHT; i++) {
+          InFlightRequest& request = this->m_inFlight[i];
+          if (!request.active) {
+              continue;
+          }
+          request.age++;
+          if (request.age > timeout) {
+              this->log_WARNING_LO_REQUEST_TIMED_OUT(request.requestId);
+              this->completeRequest(request, Fw::CmdResponse::EXECUTION_ERROR);
+          }
+      }
+      // A partly filled stream buffer waits at most one tick
+      this->flushStream();
+      this->publishTelemetry();
+      this->publishLatency();
   }
 
   // ----------------------------------------------------------------------
@@ -55,12 +194,393 @@ namespace MathModule {
         F32 val2
     )
   {
-    this->tlmWrite_VAL1(val1);
-    this->tlmWrite_OP(op);
-    this->tlmWrite_VAL2(val2);
+    // Without a credit the receiver queue has no room for the request
+    const bool starved = this->m_creditsEnabled && (this->m_credits == 0);
+    if (starved && (this->getCreditPolicy().e == CreditPolicy::REJECT)) {
+        this->m_creditRejects++;
+        this->m_tlmCreditsDirty = true;
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::BUSY);
+        return;
+    }
+    InFlightRequest* const request = this->claimRequest(opCode, cmdSeq, KIND_MATH);
+    if (request == nullptr) {
+        return;
+    }
+    request->op = op.e;
+    request->val1 = val1;
+    request->val2 = val2;
+
+    this->m_tlmVal1 = val1;
+    this->m_tlmOp = op.e;
+    this->m_tlmVal2 = val2;
+    this->m_tlmRequestDirty = true;
+    this->log_ACTIVITY_LO_COMMAND_RECV(val1, op, val2);
+    if (starved) {
+        // Sent by creditIn once a credit arrives, or failed by the timeout
+        request->held = true;
+        this->m_creditStalls++;
+        this->m_tlmCreditsDirty = true;
+        return;
+    }
+    this->sendMath(*request);
+    // The command completes when the matching result arrives
+  }
+
+  void MathSender ::
+    DO_MATH_URGENT_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq,
+        F32 val1,
+        MathModule::MathOp op,
+        F32 val2
+    )
+  {
+    // The urgent lane bypasses the receiver queue, so it spends no credit
+    InFlightRequest* const request = this->claimRequest(opCode, cmdSeq, KIND_MATH_URGENT);
+    if (request == nullptr) {
+        return;
+    }
+    request->op = op.e;
+
+    this->m_tlmVal1 = val1;
+    this->m_tlmOp = op.e;
+    this->m_tlmVal2 = val2;
+    this->m_tlmRequestDirty = true;
     this->log_ACTIVITY_LO_COMMAND_RECV(val1, op, val2);
-    this->mathOpOut_out(0, val1, op, val2);
+    this->mathOpUrgentOut_out(0, request->requestId, val1, op, val2);
+    // The command completes when the matching result arrives
+  }
+
+  void MathSender ::
+    DO_MATH_F64_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq,
+        F64 val1,
+        MathModule::MathOp op,
+        F64 val2
+    )
+  {
+    InFlightRequest* const request = this->claimRequest(opCode, cmdSeq, KIND_MATH_F64);
+    if (request == nullptr) {
+        return;
+    }
+    request->op = op.e;
+
+    this->log_ACTIVITY_LO_COMMAND_F64_RECV(val1, op, val2);
+    this->mathOpF64Out_out(0, request->requestId, val1, op, val2);
+    // The command completes when the matching result arrives
+  }
+
+  void MathSender ::
+    DO_EXPR_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq,
+        const Fw::CmdStringArg& expr,
+        MathModule::ExprVars vars
+    )
+  {
+    InFlightRequest* const request = this->claimRequest(opCode, cmdSeq, KIND_EXPR);
+    if (request == nullptr) {
+        return;
+    }
+
+    this->log_ACTIVITY_LO_EXPR_RECV(expr);
+    this->exprOpOut_out(0, request->requestId, expr, vars);
+    // The command completes when the matching result arrives
+  }
+
+  void MathSender ::
+    DUMP_LATENCY_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq
+    )
+  {
+    // Publish what was gathered before the histograms are cleared
+    this->publishLatency();
+    for (U32 i = 0; i < MathOp::NUM_CONSTANTS; i++) {
+        LatencyHistogram& histogram = this->m_roundTripLatency[i];
+        if (histogram.getCount() > 0) {
+            const LatencySummary summary(
+                histogram.getCount(), histogram.percentile(50), histogram.percentile(99), histogram.getMax()
+            );
+            LatencyBuckets buckets;
+            for (U32 b = 0; b < LatencyBuckets::SIZE; b++) {
+                buckets[b] = histogram.getBucket(b);
+            }
+            this->log_ACTIVITY_LO_LATENCY_HISTOGRAM(
+                LatencyStage::ROUND_TRIP, static_cast<MathOp::T>(i), summary, buckets
+            );
+        }
+        histogram.reset();
+    }
+    this->m_latencyUpdated = true;
     this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
   }
 
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  U32 MathSender ::
+    getInFlightWindow()
+  {
+    Fw::ParamValid valid;
+    const U32 window = this->paramGet_IN_FLIGHT_WINDOW(valid);
+    FW_ASSERT(
+        valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT,
+        valid.e
+    );
+    return FW_MIN(window, static_cast<U32>(MAX_IN_FLIGHT));
+  }
+
+  U32 MathSender ::
+    getRequestTimeout()
+  {
+    Fw::ParamValid valid;
+    const U32 timeout = this->paramGet_REQUEST_TIMEOUT(valid);
+    FW_ASSERT(
+        valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT,
+        valid.e
+    );
+    return timeout;
+  }
+
+  MathSender::InFlightRequest* MathSender ::
+    claimRequest(
+        FwOpcodeType opCode,
+        U32 cmdSeq,
+        RequestKind kind
+    )
+  {
+    // Claim the in-flight entry for the next request ID
+    const U32 requestId = this->m_nextRequestId;
+    InFlightRequest& request = this->m_inFlight[requestId % MAX_IN_FLIGHT];
+    if ((this->m_inFlightCount >= this->getInFlightWindow()) || request.active) {
+        this->log_WARNING_LO_IN_FLIGHT_WINDOW_FULL(this->m_inFlightCount);
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::BUSY);
+        return nullptr;
+    }
+    this->m_nextRequestId++;
+    request.active = true;
+    request.requestId = requestId;
+    request.opCode = opCode;
+    request.cmdSeq = cmdSeq;
+    request.age = 0;
+    request.op = MathOp::ADD;
+    request.kind = kind;
+    request.held = false;
+    request.sent = this->getTime();
+    this->m_inFlightCount++;
+    return &request;
+  }
+
+  MathSender::InFlightRequest* MathSender ::
+    matchResult(
+        U32 requestId,
+        RequestKind kind
+    )
+  {
+    InFlightRequest& request = this->m_inFlight[requestId % MAX_IN_FLIGHT];
+    if (!request.active || (request.requestId != requestId) || (request.kind != kind)) {
+        // Timed out already, or never sent by this component
+        this->log_WARNING_LO_UNEXPECTED_RESULT(requestId);
+        return nullptr;
+    }
+    return &request;
+  }
+
+  void MathSender ::
+    completeRequest(
+        InFlightRequest& request,
+        Fw::CmdResponse response
+    )
+  {
+    FW_ASSERT(request.active);
+    FW_ASSERT(this->m_inFlightCount > 0);
+    request.active = false;
+    this->m_inFlightCount--;
+    this->cmdResponse_out(request.opCode, request.cmdSeq, response);
+  }
+
+  void MathSender ::
+    finishMath(
+        InFlightRequest& request,
+        F32 result
+    )
+  {
+    // NaN is how a receiver answers a request it dropped
+    if (result != result) {
+        this->log_WARNING_LO_NO_RESULT(request.requestId);
+        this->completeRequest(request, Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+    this->m_roundTripLatency[request.op].record(
+        LatencyHistogram::elapsedUs(request.sent, this->getTime())
+    );
+    this->m_latencyUpdated = true;
+    this->m_tlmResult = result;
+    this->m_tlmResultDirty = true;
+    if (this->getResultStream()) {
+        this->streamResult(request.requestId, result);
+    } else {
+        this->log_ACTIVITY_HI_RESULT(result);
+    }
+    this->completeRequest(request, Fw::CmdResponse::OK);
+  }
+
+  CreditPolicy MathSender ::
+    getCreditPolicy()
+  {
+    Fw::ParamValid valid;
+    const CreditPolicy policy = this->paramGet_CREDIT_POLICY(valid);
+    FW_ASSERT(
+        valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT,
+        valid.e
+    );
+    return policy;
+  }
+
+  void MathSender ::
+    sendMath(InFlightRequest& request)
+  {
+    FW_ASSERT(request.active);
+    FW_ASSERT(request.kind == KIND_MATH, request.kind);
+    if (this->m_creditsEnabled) {
+        FW_ASSERT(this->m_credits > 0);
+        this->m_credits--;
+        this->m_tlmCreditsDirty = true;
+    }
+    request.held = false;
+    this->mathOpOut_out(0, request.requestId, request.val1, request.op, request.val2);
+  }
+
+  void MathSender ::
+    publishLatency()
+  {
+    if (!this->m_latencyUpdated) {
+        return;
+    }
+    OpLatency roundTrip;
+    for (U32 i = 0; i < MathOp::NUM_CONSTANTS; i++) {
+        const LatencyHistogram& histogram = this->m_roundTripLatency[i];
+        roundTrip[i] = LatencySummary(
+            histogram.getCount(), histogram.percentile(50), histogram.percentile(99), histogram.getMax()
+        );
+    }
+    this->tlmWrite_ROUND_TRIP_LATENCY(roundTrip);
+    this->m_latencyUpdated = false;
+  }
+
+  bool MathSender ::
+    getResultStream()
+  {
+    Fw::ParamValid valid;
+    const bool enabled = this->paramGet_RESULT_STREAM(valid);
+    FW_ASSERT(
+        valid.e == Fw::ParamValid::VALID || valid.e == Fw::ParamValid::DEFAULT,
+        valid.e
+    );
+    return enabled;
+  }
+
+  void MathSender ::
+    streamResult(
+        U32 requestId,
+        F32 result
+    )
+  {
+    if (this->m_streamCount == 0) {
+        Fw::Buffer buffer = this->streamAllocate_out(0, STREAM_BUFFER_SIZE);
+        if ((buffer.getData() == nullptr) || (buffer.getSize() < STREAM_BUFFER_SIZE)) {
+            if (buffer.getData() != nullptr) {
+                this->streamDeallocate_out(0, buffer);
+            }
+            this->m_streamDrops++;
+            this->m_tlmStreamDirty = true;
+            this->log_WARNING_HI_STREAM_BUFFER_UNAVAILABLE(requestId);
+            return;
+        }
+        this->m_streamBuffer = buffer;
+        this->m_streamRecords.setExtBuffer(
+            buffer.getData() + STREAM_HEADER_SIZE, STREAM_RECORDS * STREAM_RECORD_SIZE
+        );
+    }
+
+    // Stamp the result with the time it arrived back here
+    const Fw::Time now = this->getTime();
+    Fw::SerializeStatus status = this->m_streamRecords.serialize(requestId);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = this->m_streamRecords.serialize(now.getSeconds());
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = this->m_streamRecords.serialize(now.getUSeconds());
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = this->m_streamRecords.serialize(result);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    this->m_streamCount++;
+    this->m_streamResults++;
+    this->m_tlmStreamDirty = true;
+
+    if (this->m_streamCount == STREAM_RECORDS) {
+        this->flushStream();
+    }
+  }
+
+  void MathSender ::
+    flushStream()
+  {
+    if (this->m_streamCount == 0) {
+        return;
+    }
+    U8* const data = this->m_streamBuffer.getData();
+    Fw::ExternalSerializeBuffer header(data, STREAM_HEADER_SIZE);
+    Fw::SerializeStatus status = header.serialize(static_cast<FwPacketDescriptorType>(STREAM_DESCRIPTOR));
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = header.serialize(this->m_streamSequence);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = header.serialize(static_cast<U16>(this->m_streamCount));
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+
+    this->m_streamBuffer.setSize(STREAM_HEADER_SIZE + this->m_streamCount * STREAM_RECORD_SIZE);
+    this->streamOut_out(0, this->m_streamBuffer);
+    this->m_streamSequence++;
+    this->m_streamCount = 0;
+    this->m_tlmStreamDirty = true;
+  }
+
+  void MathSender ::
+    publishTelemetry()
+  {
+    // Only the latest values survive a downlink cycle
+    if (this->m_tlmRequestDirty) {
+        this->tlmWrite_VAL1(this->m_tlmVal1);
+        this->tlmWrite_OP(this->m_tlmOp);
+        this->tlmWrite_VAL2(this->m_tlmVal2);
+        this->m_tlmRequestDirty = false;
+    }
+    if (this->m_tlmResultDirty) {
+        this->tlmWrite_RESULT(this->m_tlmResult);
+        this->m_tlmResultDirty = false;
+    }
+    if (this->m_tlmResultF64Dirty) {
+        this->tlmWrite_RESULT_F64(this->m_tlmResultF64);
+        this->m_tlmResultF64Dirty = false;
+    }
+    if (this->m_tlmCreditsDirty) {
+        this->tlmWrite_CREDITS(this->m_credits);
+        this->tlmWrite_CREDIT_STALLS(this->m_creditStalls);
+        this->tlmWrite_CREDIT_REJECTS(this->m_creditRejects);
+        this->m_tlmCreditsDirty = false;
+    }
+    if (this->m_tlmStreamDirty) {
+        this->tlmWrite_STREAM_RESULTS(this->m_streamResults);
+        this->tlmWrite_STREAM_BUFFERS(this->m_streamSequence);
+        this->tlmWrite_STREAM_DROPS(this->m_streamDrops);
+        this->m_tlmStreamDirty = false;
+    }
+    if (this->m_inFlightCount != this->m_lastInFlight) {
+        this->tlmWrite_IN_FLIGHT(this->m_inFlightCount);
+        this->m_lastInFlight = this->m_inFlightCount;
+    }
+  }
+
 } // end namespace MathModule
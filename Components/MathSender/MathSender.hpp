@@ -8,6 +8,9 @@
 #define MathSender_HPP
 
 #include "Components/MathSender/MathSenderComponentAc.hpp"
+#include <Components/MathUtils/LatencyHistogram.hpp>
+#include <Fw/Buffer/Buffer.hpp>
+#include <Fw/Types/Serializable.hpp>
 
 namespace MathModule {
 
@@ -31,6 +34,50 @@ namespace MathModule {
       //!
       ~MathSender();
 
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Constants and types
+      // ----------------------------------------------------------------------
+
+      enum {
+        //! Capacity of the in-flight table; bounds IN_FLIGHT_WINDOW
+        MAX_IN_FLIGHT = 32,
+        //! Packet descriptor of result stream packets, a user type clear of the framework's packet types
+        STREAM_DESCRIPTOR = 0x4D,
+        //! Bytes of the stream buffer header: packet descriptor, sequence U32, result count U16
+        STREAM_HEADER_SIZE = sizeof(FwPacketDescriptorType) + sizeof(U32) + sizeof(U16),
+        //! Bytes of one streamed result: request ID, seconds, microseconds and result
+        STREAM_RECORD_SIZE = 3 * sizeof(U32) + sizeof(F32),
+        //! Bytes requested for each stream buffer; each is framed as one com packet
+        STREAM_BUFFER_SIZE = FW_COM_BUFFER_MAX_SIZE,
+        //! Results per stream buffer
+        STREAM_RECORDS = (STREAM_BUFFER_SIZE - STREAM_HEADER_SIZE) / STREAM_RECORD_SIZE
+      };
+
+      //! The command a request was sent for
+      enum RequestKind {
+        KIND_MATH, //!< DO_MATH
+        KIND_MATH_URGENT, //!< DO_MATH_URGENT
+        KIND_MATH_F64, //!< DO_MATH_F64
+        KIND_EXPR //!< DO_EXPR
+      };
+
+      //! A DO_MATH, DO_MATH_F64 or DO_EXPR command awaiting its result
+      struct InFlightRequest {
+        bool active; //!< Whether the entry is in use
+        U32 requestId; //!< The identifier sent with the request
+        FwOpcodeType opCode; //!< The opcode of the command
+        U32 cmdSeq; //!< The sequence number of the command
+        U32 age; //!< Rate group ticks since the request was sent
+        MathOp::T op; //!< The requested operation, for DO_MATH and DO_MATH_F64
+        RequestKind kind; //!< The command
+        bool held; //!< Whether a DO_MATH request waits for a credit before it is sent
+        F32 val1; //!< The first operand of a held request
+        F32 val2; //!< The second operand of a held request
+        Fw::Time sent; //!< The time the request was sent
+      };
+
     PRIVATE:
 
       // ----------------------------------------------------------------------
@@ -41,11 +88,53 @@ namespace MathModule {
       //!
       void mathResultIn_handler(
           const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< The identifier of the request*/
           F32 result /*!< 
       the result of the operation
       */
       );
 
+      //! Handler implementation for mathResultUrgentIn
+      //!
+      void mathResultUrgentIn_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< The identifier of the request*/
+          F32 result /*!< The result of the operation*/
+      );
+
+      //! Handler implementation for creditIn
+      //! Sends held requests while the new credits last
+      void creditIn_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 credits /*!< The number of credits granted*/
+      );
+
+      //! Handler implementation for mathResultF64In
+      //!
+      void mathResultF64In_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< The identifier of the request*/
+          F64 result /*!< the result of the operation*/
+      );
+
+      //! Handler implementation for exprResultIn
+      //!
+      void exprResultIn_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< The identifier of the request*/
+          const MathModule::ExprStatus &status, /*!< Whether the expression compiled*/
+          F32 result /*!< The value of the expression*/
+      );
+
+      //! Handler implementation for schedIn
+      //!
+      void schedIn_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          NATIVE_UINT_TYPE context /*!< 
+      The call order
+      */
+      );
+
     PRIVATE:
 
       // ----------------------------------------------------------------------
@@ -68,6 +157,188 @@ namespace MathModule {
           */
       );
 
+      //! Implementation for DO_MATH_URGENT command handler
+      //! Do a math operation ahead of queued bulk requests
+      void DO_MATH_URGENT_cmdHandler(
+          const FwOpcodeType opCode, /*!< The opcode*/
+          const U32 cmdSeq, /*!< The command sequence number*/
+          F32 val1, /*!< The first operand*/
+          MathModule::MathOp op, /*!< The operation*/
+          F32 val2 /*!< The second operand*/
+      );
+
+      //! Implementation for DO_MATH_F64 command handler
+      //! Do a math operation in double precision
+      void DO_MATH_F64_cmdHandler(
+          const FwOpcodeType opCode, /*!< The opcode*/
+          const U32 cmdSeq, /*!< The command sequence number*/
+          F64 val1, /*!< The first operand*/
+          MathModule::MathOp op, /*!< The operation*/
+          F64 val2 /*!< The second operand*/
+      );
+
+      //! Implementation for DO_EXPR command handler
+      //! Evaluate an expression in one request
+      void DO_EXPR_cmdHandler(
+          const FwOpcodeType opCode, /*!< The opcode*/
+          const U32 cmdSeq, /*!< The command sequence number*/
+          const Fw::CmdStringArg& expr, /*!< The expression over a, b, c and d*/
+          MathModule::ExprVars vars /*!< The values of the variables*/
+      );
+
+      //! Implementation for DUMP_LATENCY command handler
+      //! Dump the round-trip latency histograms as events and reset them
+      void DUMP_LATENCY_cmdHandler(
+          const FwOpcodeType opCode, /*!< The opcode*/
+          const U32 cmdSeq /*!< The command sequence number*/
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Read the in-flight window, bounded by MAX_IN_FLIGHT
+      U32 getInFlightWindow();
+
+      //! Read the request timeout in rate group ticks
+      U32 getRequestTimeout();
+
+      //! Claim the in-flight entry for a new request
+      //!
+      //! \return the entry, or nullptr if the window is full and the command was answered BUSY
+      InFlightRequest* claimRequest(
+          FwOpcodeType opCode, /*!< The opcode of the command*/
+          U32 cmdSeq, /*!< The sequence number of the command*/
+          RequestKind kind /*!< The command*/
+      );
+
+      //! Find the in-flight entry a result answers
+      //!
+      //! \return the entry, or nullptr if the result matches no request in flight
+      InFlightRequest* matchResult(
+          U32 requestId, /*!< The identifier in the result*/
+          RequestKind kind /*!< The command the result port answers*/
+      );
+
+      //! Release an in-flight entry and complete its command
+      void completeRequest(
+          InFlightRequest& request, /*!< The entry to release*/
+          Fw::CmdResponse response /*!< The command response*/
+      );
+
+      //! Report the result of a DO_MATH or DO_MATH_URGENT request and complete its command
+      void finishMath(
+          InFlightRequest& request, /*!< The entry the result answers*/
+          F32 result /*!< The result*/
+      );
+
+      //! Read the CREDIT_POLICY parameter
+      CreditPolicy getCreditPolicy();
+
+      //! Send a DO_MATH request, spending a credit once credits are in use
+      void sendMath(
+          InFlightRequest& request /*!< The request, with its operands*/
+      );
+
+      //! Write the latency telemetry if new samples were recorded
+      void publishLatency();
+
+      //! Write the staged request telemetry if it changed since the last tick
+      void publishTelemetry();
+
+      //! Read the RESULT_STREAM parameter
+      bool getResultStream();
+
+      //! Pack a result into the stream buffer, sending the buffer once it is full
+      void streamResult(
+          U32 requestId, /*!< The identifier of the request*/
+          F32 result /*!< The result*/
+      );
+
+      //! Send the stream buffer if it holds any results
+      void flushStream();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! Requests awaiting a result, indexed by request ID modulo MAX_IN_FLIGHT
+      InFlightRequest m_inFlight[MAX_IN_FLIGHT];
+
+      //! Number of active entries in m_inFlight
+      U32 m_inFlightCount;
+
+      //! Identifier of the next request
+      U32 m_nextRequestId;
+
+      //! Round-trip latencies, one histogram per operation
+      LatencyHistogram m_roundTripLatency[MathOp::NUM_CONSTANTS];
+
+      //! Whether samples were recorded since the latency telemetry was written
+      bool m_latencyUpdated;
+
+      //! Operands and operation of the last request, staged for VAL1, OP and VAL2
+      F32 m_tlmVal1;
+      MathOp::T m_tlmOp;
+      F32 m_tlmVal2;
+
+      //! Whether VAL1, OP and VAL2 changed since the last tick
+      bool m_tlmRequestDirty;
+
+      //! Last result, staged for the RESULT channel
+      F32 m_tlmResult;
+
+      //! Whether RESULT changed since the last tick
+      bool m_tlmResultDirty;
+
+      //! Last double precision result, staged for the RESULT_F64 channel
+      F64 m_tlmResultF64;
+
+      //! Whether RESULT_F64 changed since the last tick
+      bool m_tlmResultF64Dirty;
+
+      //! In-flight count reported by the last IN_FLIGHT update
+      U32 m_lastInFlight;
+
+      //! Whether a credit has ever arrived; until then DO_MATH is sent without credits
+      bool m_creditsEnabled;
+
+      //! Credits not yet spent
+      U32 m_credits;
+
+      //! DO_MATH commands held for want of a credit
+      U32 m_creditStalls;
+
+      //! DO_MATH commands rejected for want of a credit
+      U32 m_creditRejects;
+
+      //! Whether the credit counters changed since the last tick
+      bool m_tlmCreditsDirty;
+
+      //! Stream buffer being filled; valid while m_streamCount is above zero
+      Fw::Buffer m_streamBuffer;
+
+      //! Writes results into the record area of m_streamBuffer
+      Fw::ExternalSerializeBuffer m_streamRecords;
+
+      //! Results in m_streamBuffer
+      U32 m_streamCount;
+
+      //! Sequence number of the next stream buffer, so the ground can spot a lost one
+      U32 m_streamSequence;
+
+      //! Results packed into the stream
+      U32 m_streamResults;
+
+      //! Results dropped for want of a stream buffer
+      U32 m_streamDrops;
+
+      //! Whether the stream counters changed since the last tick
+      bool m_tlmStreamDirty;
 
     };
 
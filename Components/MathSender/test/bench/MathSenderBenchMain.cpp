@@ -0,0 +1,99 @@
+// ----------------------------------------------------------------------
+// MathSenderBenchMain.cpp
+// ----------------------------------------------------------------------
+
+#include "Components/MathSender/test/ut/MathSenderTester.hpp"
+#include "Components/MathUtils/test/bench/MathBench.hpp"
+#include <cstdlib>
+
+namespace MathModule {
+
+  //! Drives the MathSender hot paths through the test harness
+  class MathSenderBench :
+    public MathSenderTester
+  {
+
+    public:
+
+      enum {
+        //! Histories hold every output of one round at the largest depth
+        BENCH_HISTORY_SIZE = 4 * MathSender::MAX_IN_FLIGHT
+      };
+
+      MathSenderBench() :
+        MathSenderTester(BENCH_HISTORY_SIZE)
+      {
+        // Let every benchmark depth be in flight at once
+        this->paramSet_IN_FLIGHT_WINDOW(MathSender::MAX_IN_FLIGHT, Fw::ParamValid::VALID);
+        this->paramSend_IN_FLIGHT_WINDOW(0, 0);
+        this->clearHistory();
+      }
+
+      //! Send depth commands per round, then return their results
+      void runRoundTrip(
+          const char* mix, /*!< The name of the operation mix*/
+          const MathOp::T* ops, /*!< The operations, used round robin*/
+          U32 numOps, /*!< The number of operations in the mix*/
+          U32 depth, /*!< The commands in flight per round*/
+          U32 totalOps /*!< The approximate number of commands to measure*/
+      ) {
+        FW_ASSERT((depth > 0) && (depth <= static_cast<U32>(MathSender::MAX_IN_FLIGHT)), depth);
+        const U32 rounds = FW_MAX(totalOps / depth, 1U);
+        MathBench::Stopwatch command;
+        MathBench::Stopwatch result;
+        U32 cmdSeq = 0;
+
+        // The first round is a warm-up and is not measured
+        for (U32 round = 0; round <= rounds; round++) {
+            const bool measured = (round > 0);
+            if (measured) {
+                command.start();
+            }
+            for (U32 i = 0; i < depth; i++) {
+                this->sendCmd_DO_MATH(0, cmdSeq++, static_cast<F32>(i + 1), ops[i % numOps], 2.0);
+                (void) this->component.doDispatch();
+            }
+            if (measured) {
+                command.stop();
+            }
+            FW_ASSERT(this->fromPortHistory_mathOpOut->size() == depth);
+
+            if (measured) {
+                result.start();
+            }
+            for (U32 i = 0; i < depth; i++) {
+                this->invoke_to_mathResultIn(0, this->fromPortHistory_mathOpOut->at(i).requestId, 1.0);
+                (void) this->component.doDispatch();
+            }
+            if (measured) {
+                result.stop();
+            }
+            FW_ASSERT(this->cmdResponseHistory->size() == depth);
+            this->clearHistory();
+        }
+
+        const U64 measuredOps = static_cast<U64>(rounds) * depth;
+        MathBench::report("MathSender", "DO_MATH", mix, depth, measuredOps, command);
+        MathBench::report("MathSender", "mathResultIn", mix, depth, measuredOps, result);
+      }
+
+  };
+
+}
+
+int main(int argc, char **argv) {
+    // The number of commands measured per configuration may be given on the command line
+    const U32 totalOps = (argc > 1) ? static_cast<U32>(std::strtoul(argv[1], nullptr, 10)) : 20000;
+
+    const MathModule::MathOp::T mixed[] = {
+        MathModule::MathOp::ADD, MathModule::MathOp::SUB,
+        MathModule::MathOp::MUL, MathModule::MathOp::DIV
+    };
+    const U32 depths[] = {1, 8, 32};
+
+    for (U32 d = 0; d < FW_NUM_ARRAY_ELEMENTS(depths); d++) {
+        MathModule::MathSenderBench bench;
+        bench.runRoundTrip("MIXED", mixed, FW_NUM_ARRAY_ELEMENTS(mixed), depths[d], totalOps);
+    }
+    return 0;
+}
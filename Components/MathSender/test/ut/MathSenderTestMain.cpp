@@ -22,6 +22,51 @@ TEST(Nominal, Result) {
     tester.testResult();
 }
 
+TEST(Nominal, WindowFull) {
+    MathModule::MathSenderTester tester;
+    tester.testWindowFull();
+}
+
+TEST(Nominal, Timeout) {
+    MathModule::MathSenderTester tester;
+    tester.testTimeout();
+}
+
+TEST(Nominal, NoResult) {
+    MathModule::MathSenderTester tester;
+    tester.testNoResult();
+}
+
+TEST(Nominal, Latency) {
+    MathModule::MathSenderTester tester;
+    tester.testLatency();
+}
+
+TEST(Nominal, Expr) {
+    MathModule::MathSenderTester tester;
+    tester.testExpr();
+}
+
+TEST(Nominal, DoMathF64) {
+    MathModule::MathSenderTester tester;
+    tester.testDoMathF64();
+}
+
+TEST(Nominal, DoMathUrgent) {
+    MathModule::MathSenderTester tester;
+    tester.testDoMathUrgent();
+}
+
+TEST(Nominal, Credits) {
+    MathModule::MathSenderTester tester;
+    tester.testCredits();
+}
+
+TEST(Nominal, ResultStream) {
+    MathModule::MathSenderTester tester;
+    tester.testResultStream();
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     STest::Random::seed();
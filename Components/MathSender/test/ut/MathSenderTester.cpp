@@ -6,6 +6,7 @@
 
 #include "MathSenderTester.hpp"
 #include "STest/Pick/Pick.hpp"
+#include <limits>
 
 namespace MathModule {
 
@@ -15,11 +16,20 @@ namespace MathModule {
 
   MathSenderTester ::
     MathSenderTester() :
-      MathSenderGTestBase("Tester", MathSenderTester::MAX_HISTORY_SIZE),
-      component("MathSender")
+      MathSenderTester(MathSenderTester::MAX_HISTORY_SIZE)
+  {
+
+  }
+
+  MathSenderTester ::
+    MathSenderTester(NATIVE_INT_TYPE maxHistorySize) :
+      MathSenderGTestBase("Tester", maxHistorySize),
+      component("MathSender"),
+      m_streamAvailable(true)
   {
     this->initComponents();
     this->connectPorts();
+    this->component.loadParameters();
   }
 
   MathSenderTester ::
@@ -52,20 +62,23 @@ namespace MathModule {
     // retrieve the message from the message queue and dispatch the command to the handler
     this->component.doDispatch();
     // Verify command receipt and response
-    // verify command response was sent
-    ASSERT_CMD_RESPONSE_SIZE(1);
-    // verify the command response was correct as expected
-    ASSERT_CMD_RESPONSE(0, MathSenderComponentBase::OPCODE_DO_MATH, cmdSeq, Fw::CmdResponse::OK);
+    // verify the command response waits for the result
+    ASSERT_CMD_RESPONSE_SIZE(0);
     // Verify operation request on mathOpOut
     // verify that one output port was invoked overall
     ASSERT_FROM_PORT_HISTORY_SIZE(1);
     // verify that the math operation port was invoked once
     ASSERT_from_mathOpOut_SIZE(1);
     // verify the arguments of the operation port
-    ASSERT_from_mathOpOut(0, val1, op, val2);
+    const U32 requestId = this->fromPortHistory_mathOpOut->at(0).requestId;
+    ASSERT_from_mathOpOut(0, requestId, val1, op, val2);
     // Verify telemetry
-    // verify that 3 channels were written
-    ASSERT_TLM_SIZE(3);
+    // verify that telemetry waits for the next tick
+    ASSERT_TLM_SIZE(0);
+    this->invoke_to_schedIn(0, 0);
+    this->component.doDispatch();
+    // verify that the 3 request channels and the in-flight count were written
+    ASSERT_TLM_SIZE(4);
     // verify that the desired telemetry values were sent once
     ASSERT_TLM_VAL1_SIZE(1);
     ASSERT_TLM_VAL2_SIZE(1);
@@ -81,6 +94,13 @@ namespace MathModule {
     ASSERT_EVENTS_COMMAND_RECV_SIZE(1);
     // verify the correct event arguments were sent
     ASSERT_EVENTS_COMMAND_RECV(0, val1, op, val2);
+    // Complete the request
+    this->clearHistory();
+    this->invoke_to_mathResultIn(0, requestId, 5.0);
+    this->component.doDispatch();
+    // verify the command completes once the result arrives
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, MathSenderComponentBase::OPCODE_DO_MATH, cmdSeq, Fw::CmdResponse::OK);
   }
 
   void MathSenderTester ::
@@ -94,14 +114,23 @@ namespace MathModule {
   {
     // Generate an expected result
     const F32 result = 10.0;
+    // send a request so the result has something to match
+    const U32 requestId = this->sendRequest(20);
+    // publish the request telemetry
+    this->invoke_to_schedIn(0, 0);
+    this->component.doDispatch();
     // reset all telemetry and port history
     this->clearHistory();
     // call result port with result
-    this->invoke_to_mathResultIn(0, result);
+    this->invoke_to_mathResultIn(0, requestId, result);
     // retrieve the message from the message queue and dispatch the command to the handler
     this->component.doDispatch();
-    // verify one telemetry value was written
-    ASSERT_TLM_SIZE(1);
+    // verify the result is written on the next tick
+    ASSERT_TLM_SIZE(0);
+    this->invoke_to_schedIn(0, 0);
+    this->component.doDispatch();
+    // verify the result and the in-flight count were written
+    ASSERT_TLM_SIZE(2);
     // verify the desired telemetry channel was sent once
     ASSERT_TLM_RESULT_SIZE(1);
     // verify the values of the telemetry channel
@@ -112,6 +141,404 @@ namespace MathModule {
     ASSERT_EVENTS_RESULT_SIZE(1);
     // verify the expect value of the event
     ASSERT_EVENTS_RESULT(0, result);
+    // verify the command completed
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, MathSenderComponentBase::OPCODE_DO_MATH, 20, Fw::CmdResponse::OK);
+
+    // a second result for the same request is unexpected
+    this->clearHistory();
+    this->invoke_to_mathResultIn(0, requestId, result);
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE_SIZE(0);
+    ASSERT_EVENTS_UNEXPECTED_RESULT_SIZE(1);
+    ASSERT_EVENTS_UNEXPECTED_RESULT(0, requestId);
+  }
+
+  U32 MathSenderTester ::
+    sendRequest(U32 cmdSeq)
+  {
+    this->clearHistory();
+    this->sendCmd_DO_MATH(0, cmdSeq, 1.0, MathOp::ADD, 2.0);
+    this->component.doDispatch();
+    EXPECT_EQ(this->fromPortHistory_mathOpOut->size(), 1U);
+    return this->fromPortHistory_mathOpOut->at(0).requestId;
+  }
+
+  void MathSenderTester ::
+    testWindowFull()
+  {
+    // Shrink the window to two requests
+    const U32 window = 2;
+    this->paramSet_IN_FLIGHT_WINDOW(window, Fw::ParamValid::VALID);
+    this->paramSend_IN_FLIGHT_WINDOW(0, 1);
+
+    const U32 first = this->sendRequest(1);
+    const U32 second = this->sendRequest(2);
+    ASSERT_NE(first, second);
+
+    // A third request is rejected while two are in flight
+    this->clearHistory();
+    this->sendCmd_DO_MATH(0, 3, 1.0, MathOp::ADD, 2.0);
+    this->component.doDispatch();
+    ASSERT_from_mathOpOut_SIZE(0);
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, MathSenderComponentBase::OPCODE_DO_MATH, 3, Fw::CmdResponse::BUSY);
+    ASSERT_EVENTS_IN_FLIGHT_WINDOW_FULL_SIZE(1);
+    ASSERT_EVENTS_IN_FLIGHT_WINDOW_FULL(0, window);
+
+    // Results complete the commands in any order
+    this->clearHistory();
+    this->invoke_to_mathResultIn(0, second, 1.0);
+    this->component.doDispatch();
+    this->invoke_to_mathResultIn(0, first, 2.0);
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE_SIZE(2);
+    ASSERT_CMD_RESPONSE(0, MathSenderComponentBase::OPCODE_DO_MATH, 2, Fw::CmdResponse::OK);
+    ASSERT_CMD_RESPONSE(1, MathSenderComponentBase::OPCODE_DO_MATH, 1, Fw::CmdResponse::OK);
+  }
+
+  void MathSenderTester ::
+    testTimeout()
+  {
+    const U32 requestId = this->sendRequest(7);
+
+    // The request survives REQUEST_TIMEOUT ticks
+    Fw::ParamValid valid;
+    const U32 timeout = this->component.paramGet_REQUEST_TIMEOUT(valid);
+    this->clearHistory();
+    for (U32 tick = 0; tick < timeout; tick++) {
+        this->invoke_to_schedIn(0, 0);
+        this->component.doDispatch();
+    }
+    ASSERT_CMD_RESPONSE_SIZE(0);
+    // the count is only written when it changes
+    ASSERT_TLM_IN_FLIGHT_SIZE(1);
+    ASSERT_TLM_IN_FLIGHT(0, 1);
+
+    // and fails on the next one
+    this->clearHistory();
+    this->invoke_to_schedIn(0, 0);
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, MathSenderComponentBase::OPCODE_DO_MATH, 7, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_REQUEST_TIMED_OUT_SIZE(1);
+    ASSERT_EVENTS_REQUEST_TIMED_OUT(0, requestId);
+    ASSERT_TLM_IN_FLIGHT(0, 0);
+  }
+
+  void MathSenderTester ::
+    testNoResult()
+  {
+    const U32 requestId = this->sendRequest(9);
+
+    // A NaN result fails the command at once, without a RESULT
+    this->clearHistory();
+    this->invoke_to_mathResultIn(0, requestId, std::numeric_limits<F32>::quiet_NaN());
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, MathSenderComponentBase::OPCODE_DO_MATH, 9, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_NO_RESULT_SIZE(1);
+    ASSERT_EVENTS_NO_RESULT(0, requestId);
+    ASSERT_EVENTS_RESULT_SIZE(0);
+  }
+
+  void MathSenderTester ::
+    testLatency()
+  {
+    // The result arrives 300 us after the command
+    this->setTestTime(Fw::Time(TB_NONE, 10, 0));
+    const U32 requestId = this->sendRequest(5);
+    this->setTestTime(Fw::Time(TB_NONE, 10, 300));
+    this->invoke_to_mathResultIn(0, requestId, 3.0);
+    this->component.doDispatch();
+
+    // The summary is published on the next tick
+    this->clearHistory();
+    this->invoke_to_schedIn(0, 0);
+    this->component.doDispatch();
+    OpLatency expected;
+    expected[MathOp::ADD] = LatencySummary(1, 300, 300, 300);
+    ASSERT_TLM_ROUND_TRIP_LATENCY_SIZE(1);
+    ASSERT_TLM_ROUND_TRIP_LATENCY(0, expected);
+
+    // The dump emits the histogram and resets it
+    this->clearHistory();
+    this->sendCmd_DUMP_LATENCY(0, 6);
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, MathSenderComponentBase::OPCODE_DUMP_LATENCY, 6, Fw::CmdResponse::OK);
+    LatencyBuckets buckets;
+    buckets[9] = 1;
+    ASSERT_EVENTS_LATENCY_HISTOGRAM_SIZE(1);
+    ASSERT_EVENTS_LATENCY_HISTOGRAM(0, LatencyStage::ROUND_TRIP, MathOp::ADD, expected[MathOp::ADD], buckets);
+
+    this->clearHistory();
+    this->invoke_to_schedIn(0, 0);
+    this->component.doDispatch();
+    ASSERT_TLM_ROUND_TRIP_LATENCY(0, OpLatency());
+  }
+
+  void MathSenderTester ::
+    testExpr()
+  {
+    ExprVars vars;
+    vars[0] = 2.0;
+    vars[1] = 3.0;
+    this->clearHistory();
+    this->sendCmd_DO_EXPR(0, 30, Fw::CmdStringArg("a * b + 1"), vars);
+    this->component.doDispatch();
+    // the expression goes out in one request
+    ASSERT_from_mathOpOut_SIZE(0);
+    ASSERT_from_exprOpOut_SIZE(1);
+    ASSERT_EQ(this->fromPortHistory_exprOpOut->at(0).vars, vars);
+    ASSERT_EVENTS_EXPR_RECV_SIZE(1);
+    ASSERT_CMD_RESPONSE_SIZE(0);
+    const U32 requestId = this->fromPortHistory_exprOpOut->at(0).requestId;
+
+    // a result on the single-operation port does not complete it
+    this->invoke_to_mathResultIn(0, requestId, 7.0);
+    this->component.doDispatch();
+    ASSERT_EVENTS_UNEXPECTED_RESULT_SIZE(1);
+    ASSERT_CMD_RESPONSE_SIZE(0);
+
+    // the value completes the command
+    this->clearHistory();
+    this->invoke_to_exprResultIn(0, requestId, ExprStatus::OK, 7.0);
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, MathSenderComponentBase::OPCODE_DO_EXPR, 30, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_RESULT_SIZE(1);
+    ASSERT_EVENTS_RESULT(0, 7.0);
+
+    // a rejected expression fails the command
+    this->clearHistory();
+    this->sendCmd_DO_EXPR(0, 31, Fw::CmdStringArg("a +"), vars);
+    this->component.doDispatch();
+    const U32 rejectedId = this->fromPortHistory_exprOpOut->at(0).requestId;
+    this->invoke_to_exprResultIn(0, rejectedId, ExprStatus::SYNTAX_ERROR, 0.0);
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, MathSenderComponentBase::OPCODE_DO_EXPR, 31, Fw::CmdResponse::VALIDATION_ERROR);
+  }
+
+  void MathSenderTester ::
+    testDoMathF64()
+  {
+    const F64 val1 = 1.0 / 3.0;
+    const F64 val2 = 1.0e-9;
+    this->clearHistory();
+    this->sendCmd_DO_MATH_F64(0, 50, val1, MathOp::ADD, val2);
+    this->component.doDispatch();
+    ASSERT_from_mathOpOut_SIZE(0);
+    ASSERT_from_mathOpF64Out_SIZE(1);
+    // the operands go out without rounding to single precision
+    ASSERT_EQ(this->fromPortHistory_mathOpF64Out->at(0).val1, val1);
+    ASSERT_EQ(this->fromPortHistory_mathOpF64Out->at(0).val2, val2);
+    ASSERT_EVENTS_COMMAND_F64_RECV_SIZE(1);
+    ASSERT_EVENTS_COMMAND_F64_RECV(0, val1, MathOp::ADD, val2);
+    ASSERT_CMD_RESPONSE_SIZE(0);
+    const U32 requestId = this->fromPortHistory_mathOpF64Out->at(0).requestId;
+
+    // a single precision result does not complete it
+    this->invoke_to_mathResultIn(0, requestId, 1.0);
+    this->component.doDispatch();
+    ASSERT_EVENTS_UNEXPECTED_RESULT_SIZE(1);
+    ASSERT_CMD_RESPONSE_SIZE(0);
+
+    // the double precision result does
+    this->clearHistory();
+    const F64 result = val1 + val2;
+    this->invoke_to_mathResultF64In(0, requestId, result);
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, MathSenderComponentBase::OPCODE_DO_MATH_F64, 50, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_RESULT_F64_SIZE(1);
+    ASSERT_EVENTS_RESULT_F64(0, result);
+    ASSERT_EVENTS_RESULT_SIZE(0);
+
+    // the telemetry goes out on the next tick
+    this->invoke_to_schedIn(0, 0);
+    this->component.doDispatch();
+    ASSERT_TLM_RESULT_F64_SIZE(1);
+    ASSERT_TLM_RESULT_F64(0, result);
+    ASSERT_TLM_RESULT_SIZE(0);
+  }
+
+  void MathSenderTester ::
+    testDoMathUrgent()
+  {
+    // an urgent command overtakes a queued DO_MATH and needs no credit
+    this->invoke_to_creditIn(0, 0);
+    this->component.doDispatch();
+    this->clearHistory();
+    this->sendCmd_DO_MATH(0, 80, 1.0, MathOp::ADD, 2.0);
+    this->sendCmd_DO_MATH_URGENT(0, 81, 3.0, MathOp::MUL, 4.0);
+    this->component.doDispatch();
+    ASSERT_from_mathOpOut_SIZE(0);
+    ASSERT_from_mathOpUrgentOut_SIZE(1);
+    const U32 requestId = this->fromPortHistory_mathOpUrgentOut->at(0).requestId;
+    ASSERT_from_mathOpUrgentOut(0, requestId, 3.0, MathOp::MUL, 4.0);
+    ASSERT_EVENTS_COMMAND_RECV_SIZE(1);
+    ASSERT_EVENTS_COMMAND_RECV(0, 3.0, MathOp::MUL, 4.0);
+
+    // a bulk result does not complete it
+    this->invoke_to_mathResultIn(0, requestId, 12.0);
+    this->component.doDispatch();
+    ASSERT_EVENTS_UNEXPECTED_RESULT_SIZE(1);
+    ASSERT_CMD_RESPONSE_SIZE(0);
+
+    // the urgent result does
+    this->clearHistory();
+    this->invoke_to_mathResultUrgentIn(0, requestId, 12.0);
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, MathSenderComponentBase::OPCODE_DO_MATH_URGENT, 81, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_RESULT_SIZE(1);
+    ASSERT_EVENTS_RESULT(0, 12.0);
+  }
+
+  void MathSenderTester ::
+    testCredits()
+  {
+    // Until the receivers grant credits, requests go straight out
+    this->sendRequest(60);
+
+    // One credit lets one request through
+    this->invoke_to_creditIn(0, 1);
+    this->component.doDispatch();
+    const U32 first = this->sendRequest(61);
+
+    // and the next one is held
+    this->clearHistory();
+    this->sendCmd_DO_MATH(0, 62, 4.0, MathOp::MUL, 5.0);
+    this->component.doDispatch();
+    ASSERT_from_mathOpOut_SIZE(0);
+    ASSERT_CMD_RESPONSE_SIZE(0);
+    this->invoke_to_schedIn(0, 0);
+    this->component.doDispatch();
+    ASSERT_TLM_CREDITS(0, 0);
+    ASSERT_TLM_CREDIT_STALLS(0, 1);
+
+    // until a credit arrives
+    this->clearHistory();
+    this->invoke_to_creditIn(0, 2);
+    this->component.doDispatch();
+    ASSERT_from_mathOpOut_SIZE(1);
+    ASSERT_from_mathOpOut(0, first + 1, 4.0, MathOp::MUL, 5.0);
+    this->invoke_to_mathResultIn(0, first + 1, 20.0);
+    this->component.doDispatch();
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, MathSenderComponentBase::OPCODE_DO_MATH, 62, Fw::CmdResponse::OK);
+
+    // With REJECT, a command that finds no credit is answered BUSY
+    this->paramSet_CREDIT_POLICY(CreditPolicy::REJECT, Fw::ParamValid::VALID);
+    this->paramSend_CREDIT_POLICY(0, 1);
+    this->sendRequest(63);
+    this->clearHistory();
+    this->sendCmd_DO_MATH(0, 64, 1.0, MathOp::ADD, 2.0);
+    this->component.doDispatch();
+    ASSERT_from_mathOpOut_SIZE(0);
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, MathSenderComponentBase::OPCODE_DO_MATH, 64, Fw::CmdResponse::BUSY);
+    this->invoke_to_schedIn(0, 0);
+    this->component.doDispatch();
+    ASSERT_TLM_CREDIT_REJECTS(0, 1);
+
+    // A held request that times out is not sent when credits come back
+    this->paramSet_CREDIT_POLICY(CreditPolicy::HOLD, Fw::ParamValid::VALID);
+    this->paramSend_CREDIT_POLICY(0, 1);
+    this->sendCmd_DO_MATH(0, 65, 1.0, MathOp::ADD, 2.0);
+    this->component.doDispatch();
+    Fw::ParamValid valid;
+    const U32 timeout = this->component.paramGet_REQUEST_TIMEOUT(valid);
+    this->clearHistory();
+    for (U32 tick = 0; tick <= timeout; tick++) {
+        this->invoke_to_schedIn(0, 0);
+        this->component.doDispatch();
+    }
+    // the earlier requests time out too; the held one was claimed last
+    ASSERT_CMD_RESPONSE(
+        this->cmdResponseHistory->size() - 1, MathSenderComponentBase::OPCODE_DO_MATH, 65,
+        Fw::CmdResponse::EXECUTION_ERROR
+    );
+    this->clearHistory();
+    this->invoke_to_creditIn(0, 1);
+    this->component.doDispatch();
+    ASSERT_from_mathOpOut_SIZE(0);
+  }
+
+  void MathSenderTester ::
+    testResultStream()
+  {
+    this->paramSet_RESULT_STREAM(true, Fw::ParamValid::VALID);
+    this->paramSend_RESULT_STREAM(0, 1);
+    const U32 first = this->sendRequest(40);
+    const U32 second = this->sendRequest(41);
+
+    // Results are packed instead of reported as events
+    const Fw::Time arrival(TB_NONE, 100, 250);
+    this->setTestTime(arrival);
+    this->clearHistory();
+    this->invoke_to_mathResultIn(0, first, 1.5);
+    this->component.doDispatch();
+    this->invoke_to_mathResultIn(0, second, -2.0);
+    this->component.doDispatch();
+    ASSERT_EVENTS_RESULT_SIZE(0);
+    ASSERT_CMD_RESPONSE_SIZE(2);
+    ASSERT_from_streamAllocate_SIZE(1);
+    ASSERT_from_streamOut_SIZE(0);
+
+    // and both go out in one buffer on the next tick
+    this->invoke_to_schedIn(0, 0);
+    this->component.doDispatch();
+    ASSERT_from_streamOut_SIZE(1);
+    Fw::Buffer buffer = this->fromPortHistory_streamOut->at(0).fwBuffer;
+    ASSERT_EQ(buffer.getSize(), static_cast<U32>(MathSender::STREAM_HEADER_SIZE + 2 * MathSender::STREAM_RECORD_SIZE));
+    Fw::ExternalSerializeBuffer reader(buffer.getData(), buffer.getSize());
+    ASSERT_EQ(reader.setBuffLen(buffer.getSize()), Fw::FW_SERIALIZE_OK);
+    FwPacketDescriptorType descriptor = 0;
+    U32 sequence = 1;
+    U16 count = 0;
+    ASSERT_EQ(reader.deserialize(descriptor), Fw::FW_SERIALIZE_OK);
+    ASSERT_EQ(reader.deserialize(sequence), Fw::FW_SERIALIZE_OK);
+    ASSERT_EQ(reader.deserialize(count), Fw::FW_SERIALIZE_OK);
+    ASSERT_EQ(descriptor, static_cast<FwPacketDescriptorType>(MathSender::STREAM_DESCRIPTOR));
+    ASSERT_EQ(sequence, 0U);
+    ASSERT_EQ(count, 2U);
+    const U32 ids[] = {first, second};
+    const F32 results[] = {1.5, -2.0};
+    for (U32 i = 0; i < 2; i++) {
+        U32 requestId = 0;
+        U32 seconds = 0;
+        U32 useconds = 0;
+        F32 result = 0;
+        ASSERT_EQ(reader.deserialize(requestId), Fw::FW_SERIALIZE_OK);
+        ASSERT_EQ(reader.deserialize(seconds), Fw::FW_SERIALIZE_OK);
+        ASSERT_EQ(reader.deserialize(useconds), Fw::FW_SERIALIZE_OK);
+        ASSERT_EQ(reader.deserialize(result), Fw::FW_SERIALIZE_OK);
+        ASSERT_EQ(requestId, ids[i]);
+        ASSERT_EQ(seconds, arrival.getSeconds());
+        ASSERT_EQ(useconds, arrival.getUSeconds());
+        ASSERT_EQ(result, results[i]);
+    }
+    ASSERT_TLM_STREAM_RESULTS(0, 2);
+    ASSERT_TLM_STREAM_BUFFERS(0, 1);
+
+    // A sent buffer is returned by the downlink, not by the sender
+    ASSERT_from_streamDeallocate_SIZE(0);
+
+    // Without a buffer the result is dropped and reported
+    this->m_streamAvailable = false;
+    const U32 third = this->sendRequest(42);
+    this->clearHistory();
+    this->invoke_to_mathResultIn(0, third, 3.0);
+    this->component.doDispatch();
+    ASSERT_EVENTS_STREAM_BUFFER_UNAVAILABLE_SIZE(1);
+    ASSERT_EVENTS_STREAM_BUFFER_UNAVAILABLE(0, third);
+    this->invoke_to_schedIn(0, 0);
+    this->component.doDispatch();
+    ASSERT_from_streamOut_SIZE(0);
+    ASSERT_TLM_STREAM_DROPS(0, 1);
   }
 
   // ----------------------------------------------------------------------
@@ -121,12 +548,79 @@ namespace MathModule {
   void MathSenderTester ::
     from_mathOpOut_handler(
         const NATIVE_INT_TYPE portNum,
+        U32 requestId,
         F32 val1,
         const MathModule::MathOp &op,
         F32 val2
     )
   {
-    this->pushFromPortEntry_mathOpOut(val1, op, val2);
+    this->pushFromPortEntry_mathOpOut(requestId, val1, op, val2);
+  }
+
+  void MathSenderTester ::
+    from_mathOpF64Out_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        F64 val1,
+        const MathModule::MathOp &op,
+        F64 val2
+    )
+  {
+    this->pushFromPortEntry_mathOpF64Out(requestId, val1, op, val2);
+  }
+
+  void MathSenderTester ::
+    from_mathOpUrgentOut_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        F32 val1,
+        const MathModule::MathOp &op,
+        F32 val2
+    )
+  {
+    this->pushFromPortEntry_mathOpUrgentOut(requestId, val1, op, val2);
+  }
+
+  void MathSenderTester ::
+    from_exprOpOut_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 requestId,
+        const Fw::StringBase &expr,
+        const MathModule::ExprVars &vars
+    )
+  {
+    this->pushFromPortEntry_exprOpOut(requestId, expr, vars);
+  }
+
+  Fw::Buffer MathSenderTester ::
+    from_streamAllocate_handler(
+        const NATIVE_INT_TYPE portNum,
+        U32 size
+    )
+  {
+    this->pushFromPortEntry_streamAllocate(size);
+    if (!this->m_streamAvailable || (size > sizeof(this->m_streamMemory))) {
+        return Fw::Buffer();
+    }
+    return Fw::Buffer(this->m_streamMemory, size);
+  }
+
+  void MathSenderTester ::
+    from_streamOut_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer& fwBuffer
+    )
+  {
+    this->pushFromPortEntry_streamOut(fwBuffer);
+  }
+
+  void MathSenderTester ::
+    from_streamDeallocate_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer& fwBuffer
+    )
+  {
+    this->pushFromPortEntry_streamDeallocate(fwBuffer);
   }
 
 
@@ -32,6 +32,12 @@ namespace MathModule {
       //!
       MathSenderTester();
 
+      //! Construct object MathSenderTester with room for longer histories
+      //!
+      explicit MathSenderTester(
+          NATIVE_INT_TYPE maxHistorySize /*!< The maximum size of each history*/
+      );
+
       //! Destroy object MathSenderTester
       //!
       ~MathSenderTester();
@@ -52,6 +58,27 @@ namespace MathModule {
 
       void testResult();
 
+      //! Send a DO_MATH command and return the request ID it was given
+      U32 sendRequest(U32 cmdSeq);
+
+      void testWindowFull();
+
+      void testTimeout();
+
+      void testNoResult();
+
+      void testLatency();
+
+      void testExpr();
+
+      void testDoMathF64();
+
+      void testDoMathUrgent();
+
+      void testCredits();
+
+      void testResultStream();
+
     private:
 
       // ----------------------------------------------------------------------
@@ -62,6 +89,7 @@ namespace MathModule {
       //!
       void from_mathOpOut_handler(
           const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< Identifies the request in the matching result*/
           F32 val1, /*!< 
       The first operand
       */
@@ -73,6 +101,56 @@ namespace MathModule {
       */
       );
 
+      //! Handler for from_mathOpF64Out
+      //!
+      void from_mathOpF64Out_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< Identifies the request in the matching result*/
+          F64 val1, /*!< The first operand*/
+          const MathModule::MathOp &op, /*!< The operation*/
+          F64 val2 /*!< The second operand*/
+      );
+
+      //! Handler for from_mathOpUrgentOut
+      //!
+      void from_mathOpUrgentOut_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< Identifies the request in the matching result*/
+          F32 val1, /*!< The first operand*/
+          const MathModule::MathOp &op, /*!< The operation*/
+          F32 val2 /*!< The second operand*/
+      );
+
+      //! Handler for from_exprOpOut
+      //!
+      void from_exprOpOut_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 requestId, /*!< Identifies the request in the matching result*/
+          const Fw::StringBase &expr, /*!< The expression over a, b, c and d*/
+          const MathModule::ExprVars &vars /*!< The values of the variables*/
+      );
+
+      //! Handler for from_streamAllocate
+      //! Hands out m_streamMemory while m_streamAvailable is set
+      Fw::Buffer from_streamAllocate_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          U32 size /*!< The requested size*/
+      );
+
+      //! Handler for from_streamOut
+      //!
+      void from_streamOut_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          Fw::Buffer& fwBuffer /*!< The buffer*/
+      );
+
+      //! Handler for from_streamDeallocate
+      //!
+      void from_streamDeallocate_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          Fw::Buffer& fwBuffer /*!< The buffer*/
+      );
+
     private:
 
       // ----------------------------------------------------------------------
@@ -87,7 +165,7 @@ namespace MathModule {
       //!
       void initComponents();
 
-    private:
+    protected:
 
       // ----------------------------------------------------------------------
       // Variables
@@ -97,6 +175,12 @@ namespace MathModule {
       //!
       MathSender component;
 
+      //! Memory of the one stream buffer the tester hands out
+      U8 m_streamMemory[MathSender::STREAM_BUFFER_SIZE];
+
+      //! Whether a stream buffer is available
+      bool m_streamAvailable;
+
   };
 
 } // end namespace MathModule
@@ -0,0 +1,83 @@
+// ======================================================================
+// \title  MathStartup.cpp
+// \brief  cpp file for MathStartup component implementation class
+// ======================================================================
+
+
+#include <Components/MathStartup/MathStartup.hpp>
+#include <FpConfig.hpp>
+
+namespace MathModule {
+
+  // ----------------------------------------------------------------------
+  // Construction, initialization, and destruction
+  // ----------------------------------------------------------------------
+
+  MathStartup ::
+    MathStartup(
+        const char *const compName
+    ) : MathStartupComponentBase(compName),
+        m_profile(nullptr)
+  {
+
+  }
+
+  MathStartup ::
+    ~MathStartup()
+  {
+
+  }
+
+  void MathStartup ::
+    publish(
+        const StartupProfile& profile,
+        const char* jsonPath
+    )
+  {
+    this->m_profile = &profile;
+    this->reportPhases();
+    if (jsonPath == nullptr) {
+        return;
+    }
+    const Fw::LogStringArg path(jsonPath);
+    if (profile.writeJson(jsonPath)) {
+        this->log_ACTIVITY_LO_STARTUP_PROFILE_WRITTEN(path);
+    } else {
+        this->log_WARNING_LO_STARTUP_PROFILE_WRITE_FAILED(path);
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Command handler implementations
+  // ----------------------------------------------------------------------
+
+  void MathStartup ::
+    STARTUP_REPORT_cmdHandler(
+        const FwOpcodeType opCode,
+        const U32 cmdSeq
+    )
+  {
+    if (this->m_profile == nullptr) {
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+    this->reportPhases();
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  void MathStartup ::
+    reportPhases()
+  {
+    FW_ASSERT(this->m_profile != nullptr);
+    for (U32 i = 0; i < this->m_profile->getCount(); i++) {
+        const StartupProfile::Phase& phase = this->m_profile->getPhase(i);
+        const Fw::LogStringArg name(phase.name);
+        this->log_ACTIVITY_HI_STARTUP_PHASE(name, phase.depth, phase.wallUs, phase.allocatedBytes);
+    }
+  }
+
+} // end namespace MathModule
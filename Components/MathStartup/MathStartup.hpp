@@ -0,0 +1,80 @@
+// ======================================================================
+// \title  MathStartup.hpp
+// \brief  hpp file for MathStartup component implementation class
+// ======================================================================
+
+#ifndef MathStartup_HPP
+#define MathStartup_HPP
+
+#include "Components/MathStartup/MathStartupComponentAc.hpp"
+#include <Components/MathUtils/StartupProfile.hpp>
+
+namespace MathModule {
+
+  class MathStartup :
+    public MathStartupComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction, initialization, and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object MathStartup
+      //!
+      MathStartup(
+          const char *const compName /*!< The component name*/
+      );
+
+      //! Destroy object MathStartup
+      //!
+      ~MathStartup();
+
+      //! Report each phase of a finished startup as an event
+      //!
+      //! Called once the topology is connected and the event logger is
+      //! running. The profile is kept for STARTUP_REPORT, so it must outlive
+      //! the component. When jsonPath is not null the profile is also written
+      //! there as JSON.
+      void publish(
+          const StartupProfile& profile, /*!< The startup phases*/
+          const char* jsonPath /*!< The JSON file to write, or null*/
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Command handler implementations
+      // ----------------------------------------------------------------------
+
+      //! Implementation for STARTUP_REPORT command handler
+      //! Report the startup phases again
+      void STARTUP_REPORT_cmdHandler(
+          const FwOpcodeType opCode, /*!< The opcode*/
+          const U32 cmdSeq /*!< The command sequence number*/
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Log an event for each phase of the profile
+      void reportPhases();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The published profile, or null before publish
+      const StartupProfile* m_profile;
+
+    };
+
+} // end namespace MathModule
+
+#endif
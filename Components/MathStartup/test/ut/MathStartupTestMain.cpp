@@ -0,0 +1,27 @@
+// ----------------------------------------------------------------------
+// TestMain.cpp
+// ----------------------------------------------------------------------
+
+#include "MathStartupTester.hpp"
+#include "STest/Random/Random.hpp"
+
+TEST(Nominal, Publish) {
+    MathModule::MathStartupTester tester;
+    tester.testPublish();
+}
+
+TEST(Nominal, Report) {
+    MathModule::MathStartupTester tester;
+    tester.testReport();
+}
+
+TEST(Nominal, WriteFailed) {
+    MathModule::MathStartupTester tester;
+    tester.testWriteFailed();
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    STest::Random::seed();
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,94 @@
+// ======================================================================
+// \title  MathStartup.hpp
+// \brief  cpp file for MathStartup test harness implementation class
+// ======================================================================
+
+#include "MathStartupTester.hpp"
+#include "STest/Pick/Pick.hpp"
+#include <cstdio>
+#include <cstring>
+
+namespace MathModule {
+  #define CMD_SEQ 42
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  MathStartupTester ::
+    MathStartupTester() :
+      MathStartupGTestBase("Tester", MathStartupTester::MAX_HISTORY_SIZE),
+      component("MathStartup")
+  {
+    this->initComponents();
+    this->connectPorts();
+    this->m_profile.begin("setup", 0);
+    this->m_profile.begin("configure", 100);
+    this->m_profile.end(1124);
+    this->m_profile.end(1124);
+  }
+
+  MathStartupTester ::
+    ~MathStartupTester()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void MathStartupTester ::
+    testPublish()
+  {
+    const char* const path = "MathStartupTest.json";
+    this->component.publish(this->m_profile, path);
+    ASSERT_EVENTS_STARTUP_PHASE_SIZE(2);
+    ASSERT_EVENTS_STARTUP_PHASE(0, "setup", 0, this->m_profile.getPhase(0).wallUs, 1124);
+    ASSERT_EVENTS_STARTUP_PHASE(1, "configure", 1, this->m_profile.getPhase(1).wallUs, 1024);
+    ASSERT_EVENTS_STARTUP_PROFILE_WRITTEN_SIZE(1);
+    ASSERT_EVENTS_STARTUP_PROFILE_WRITTEN(0, path);
+
+    FILE* const file = fopen(path, "rb");
+    ASSERT_NE(file, nullptr);
+    char json[StartupProfile::JSON_SIZE] = {};
+    ASSERT_GT(fread(json, 1, sizeof(json) - 1, file), 0U);
+    (void) fclose(file);
+    ASSERT_NE(strstr(json, "\"name\": \"configure\", \"depth\": 1"), nullptr);
+    (void) remove(path);
+  }
+
+  void MathStartupTester ::
+    testReport()
+  {
+    // Nothing to report before startup finishes
+    this->sendCmd_STARTUP_REPORT(TEST_INSTANCE_ID, CMD_SEQ);
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, MathStartupComponentBase::OPCODE_STARTUP_REPORT, CMD_SEQ,
+                        Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_SIZE(0);
+
+    // Without a path the profile is only reported
+    this->component.publish(this->m_profile, nullptr);
+    ASSERT_EVENTS_STARTUP_PHASE_SIZE(2);
+    ASSERT_EVENTS_STARTUP_PROFILE_WRITTEN_SIZE(0);
+
+    this->clearHistory();
+    this->sendCmd_STARTUP_REPORT(TEST_INSTANCE_ID, CMD_SEQ);
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, MathStartupComponentBase::OPCODE_STARTUP_REPORT, CMD_SEQ, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_STARTUP_PHASE_SIZE(2);
+    ASSERT_EVENTS_STARTUP_PHASE(1, "configure", 1, this->m_profile.getPhase(1).wallUs, 1024);
+  }
+
+  void MathStartupTester ::
+    testWriteFailed()
+  {
+    const char* const path = "no/such/directory/MathStartupTest.json";
+    this->component.publish(this->m_profile, path);
+    ASSERT_EVENTS_STARTUP_PHASE_SIZE(2);
+    ASSERT_EVENTS_STARTUP_PROFILE_WRITTEN_SIZE(0);
+    ASSERT_EVENTS_STARTUP_PROFILE_WRITE_FAILED_SIZE(1);
+    ASSERT_EVENTS_STARTUP_PROFILE_WRITE_FAILED(0, path);
+  }
+
+} // end namespace MathModule
@@ -0,0 +1,79 @@
+// ======================================================================
+// \title  MathStartup/test/ut/Tester.hpp
+// \brief  hpp file for MathStartup test harness implementation class
+// ======================================================================
+
+#ifndef TESTER_HPP
+#define TESTER_HPP
+
+#include "MathStartupGTestBase.hpp"
+#include "Components/MathStartup/MathStartup.hpp"
+
+namespace MathModule {
+
+  class MathStartupTester :
+    public MathStartupGTestBase
+  {
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+    public:
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const NATIVE_INT_TYPE MAX_HISTORY_SIZE = 10;
+      // Instance ID supplied to the component instance under test
+      static const NATIVE_INT_TYPE TEST_INSTANCE_ID = 0;
+
+      //! Construct object MathStartupTester
+      //!
+      MathStartupTester();
+
+      //! Destroy object MathStartupTester
+      //!
+      ~MathStartupTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      void testPublish();
+
+      void testReport();
+
+      void testWriteFailed();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper methods
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      //!
+      void connectPorts();
+
+      //! Initialize components
+      //!
+      void initComponents();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      //!
+      MathStartup component;
+
+      //! Two phases, the second inside the first
+      StartupProfile m_profile;
+
+  };
+
+} // end namespace MathModule
+
+#endif
@@ -0,0 +1,64 @@
+// ======================================================================
+// \title  MathStreamDownlink.cpp
+// \brief  cpp file for MathStreamDownlink component implementation class
+// ======================================================================
+
+
+#include <Components/MathStreamDownlink/MathStreamDownlink.hpp>
+#include <Fw/Com/ComBuffer.hpp>
+#include <FpConfig.hpp>
+
+namespace MathModule {
+
+  // ----------------------------------------------------------------------
+  // Construction, initialization, and destruction
+  // ----------------------------------------------------------------------
+
+  MathStreamDownlink ::
+    MathStreamDownlink(
+        const char *const compName
+    ) : MathStreamDownlinkComponentBase(compName),
+        m_streamManagerId(0),
+        m_setup(false)
+  {
+
+  }
+
+  MathStreamDownlink ::
+    ~MathStreamDownlink()
+  {
+
+  }
+
+  void MathStreamDownlink ::
+    setup(U16 streamManagerId)
+  {
+    this->m_streamManagerId = streamManagerId;
+    this->m_setup = true;
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for user-defined typed input ports
+  // ----------------------------------------------------------------------
+
+  void MathStreamDownlink ::
+    bufferIn_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer &fwBuffer
+    )
+  {
+    FW_ASSERT(this->m_setup);
+    // File downlink buffers keep the file packet type the framer gives the buffers it frames
+    if ((fwBuffer.getContext() >> MANAGER_ID_SHIFT) != this->m_streamManagerId) {
+        this->bufferOut_out(0, fwBuffer);
+        return;
+    }
+    // A stream buffer starts with its own packet descriptor, so it is framed as a com packet as it stands
+    Fw::ComBuffer packet;
+    const Fw::SerializeStatus status = packet.serialize(fwBuffer.getData(), fwBuffer.getSize(), true);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status, fwBuffer.getSize());
+    this->streamReturnOut_out(0, fwBuffer);
+    this->comOut_out(0, packet, 0);
+  }
+
+} // end namespace MathModule
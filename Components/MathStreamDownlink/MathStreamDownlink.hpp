@@ -0,0 +1,77 @@
+// ======================================================================
+// \title  MathStreamDownlink.hpp
+// \brief  hpp file for MathStreamDownlink component implementation class
+// ======================================================================
+
+#ifndef MathStreamDownlink_HPP
+#define MathStreamDownlink_HPP
+
+#include "Components/MathStreamDownlink/MathStreamDownlinkComponentAc.hpp"
+
+namespace MathModule {
+
+  class MathStreamDownlink :
+    public MathStreamDownlinkComponentBase
+  {
+
+    public:
+
+      enum {
+        //! Bits below the manager ID in the context of a buffer manager buffer
+        MANAGER_ID_SHIFT = 16
+      };
+
+      // ----------------------------------------------------------------------
+      // Construction, initialization, and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object MathStreamDownlink
+      //!
+      MathStreamDownlink(
+          const char *const compName /*!< The component name*/
+      );
+
+      //! Destroy object MathStreamDownlink
+      //!
+      ~MathStreamDownlink();
+
+      //! Name the buffer manager the result stream draws its buffers from
+      //!
+      //! The buffer manager keeps its ID in the upper half of the context of
+      //! every buffer it hands out, so the stream buffers are told apart by
+      //! where they came from rather than by what they hold. Must be called
+      //! before the first buffer arrives.
+      void setup(
+          U16 streamManagerId /*!< The ID the stream buffer manager was set up with*/
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for user-defined typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for bufferIn
+      //!
+      void bufferIn_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          Fw::Buffer &fwBuffer /*!< The buffer*/
+      );
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! ID of the buffer manager of the result stream
+      U16 m_streamManagerId;
+
+      //! Whether setup was called
+      bool m_setup;
+
+    };
+
+} // end namespace MathModule
+
+#endif
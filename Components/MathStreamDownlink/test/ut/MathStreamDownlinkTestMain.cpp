@@ -0,0 +1,22 @@
+// ----------------------------------------------------------------------
+// TestMain.cpp
+// ----------------------------------------------------------------------
+
+#include "MathStreamDownlinkTester.hpp"
+#include "STest/Random/Random.hpp"
+
+TEST(Nominal, StreamBuffer) {
+    MathModule::MathStreamDownlinkTester tester;
+    tester.testStreamBuffer();
+}
+
+TEST(Nominal, FileBuffer) {
+    MathModule::MathStreamDownlinkTester tester;
+    tester.testFileBuffer();
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    STest::Random::seed();
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,105 @@
+// ======================================================================
+// \title  MathStreamDownlink.hpp
+// \brief  cpp file for MathStreamDownlink test harness implementation class
+// ======================================================================
+
+#include "MathStreamDownlinkTester.hpp"
+#include <cstring>
+
+namespace MathModule {
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  MathStreamDownlinkTester ::
+    MathStreamDownlinkTester() :
+      MathStreamDownlinkGTestBase("Tester", MathStreamDownlinkTester::MAX_HISTORY_SIZE),
+      component("MathStreamDownlink")
+  {
+    this->initComponents();
+    this->connectPorts();
+    this->component.setup(STREAM_MANAGER_ID);
+  }
+
+  MathStreamDownlinkTester ::
+    ~MathStreamDownlinkTester()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void MathStreamDownlinkTester ::
+    testStreamBuffer()
+  {
+    U8 data[] = {0x00, 0x00, 0x00, 0x4D, 0x01, 0x02, 0x03};
+    const U32 context = (static_cast<U32>(STREAM_MANAGER_ID) << MathStreamDownlink::MANAGER_ID_SHIFT) | 3;
+    Fw::Buffer buffer(data, sizeof(data), context);
+    this->invoke_to_bufferIn(0, buffer);
+
+    // The packet goes to the framer as it stands, and the buffer goes back to its manager
+    ASSERT_from_comOut_SIZE(1);
+    Fw::ComBuffer& packet = this->fromPortHistory_comOut->at(0).data;
+    ASSERT_EQ(packet.getBuffLength(), sizeof(data));
+    ASSERT_EQ(memcmp(packet.getBuffAddr(), data, sizeof(data)), 0);
+    ASSERT_from_streamReturnOut_SIZE(1);
+    ASSERT_from_streamReturnOut(0, buffer);
+    ASSERT_from_bufferOut_SIZE(0);
+  }
+
+  void MathStreamDownlinkTester ::
+    testFileBuffer()
+  {
+    // A file packet is passed on untouched, whatever it starts with
+    U8 data[] = {0x00, 0x00, 0x00, 0x4D, 0x01};
+    Fw::Buffer buffer(data, sizeof(data));
+    this->invoke_to_bufferIn(0, buffer);
+    ASSERT_from_bufferOut_SIZE(1);
+    ASSERT_from_bufferOut(0, buffer);
+    ASSERT_from_comOut_SIZE(0);
+    ASSERT_from_streamReturnOut_SIZE(0);
+
+    // and so is a buffer from another manager
+    const U32 context = (static_cast<U32>(STREAM_MANAGER_ID + 1) << MathStreamDownlink::MANAGER_ID_SHIFT) | 3;
+    Fw::Buffer other(data, sizeof(data), context);
+    this->invoke_to_bufferIn(0, other);
+    ASSERT_from_bufferOut_SIZE(2);
+    ASSERT_from_streamReturnOut_SIZE(0);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  void MathStreamDownlinkTester ::
+    from_bufferOut_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer &fwBuffer
+    )
+  {
+    this->pushFromPortEntry_bufferOut(fwBuffer);
+  }
+
+  void MathStreamDownlinkTester ::
+    from_comOut_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::ComBuffer &data,
+        U32 context
+    )
+  {
+    this->pushFromPortEntry_comOut(data, context);
+  }
+
+  void MathStreamDownlinkTester ::
+    from_streamReturnOut_handler(
+        const NATIVE_INT_TYPE portNum,
+        Fw::Buffer &fwBuffer
+    )
+  {
+    this->pushFromPortEntry_streamReturnOut(fwBuffer);
+  }
+
+} // end namespace MathModule
@@ -0,0 +1,104 @@
+// ======================================================================
+// \title  MathStreamDownlink/test/ut/Tester.hpp
+// \brief  hpp file for MathStreamDownlink test harness implementation class
+// ======================================================================
+
+#ifndef TESTER_HPP
+#define TESTER_HPP
+
+#include "MathStreamDownlinkGTestBase.hpp"
+#include "Components/MathStreamDownlink/MathStreamDownlink.hpp"
+
+namespace MathModule {
+
+  class MathStreamDownlinkTester :
+    public MathStreamDownlinkGTestBase
+  {
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+    public:
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const NATIVE_INT_TYPE MAX_HISTORY_SIZE = 10;
+      // Instance ID supplied to the component instance under test
+      static const NATIVE_INT_TYPE TEST_INSTANCE_ID = 0;
+      // ID of the buffer manager the stream buffers come from
+      static const U16 STREAM_MANAGER_ID = 201;
+
+      //! Construct object MathStreamDownlinkTester
+      //!
+      MathStreamDownlinkTester();
+
+      //! Destroy object MathStreamDownlinkTester
+      //!
+      ~MathStreamDownlinkTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      void testStreamBuffer();
+
+      void testFileBuffer();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Handlers for typed from ports
+      // ----------------------------------------------------------------------
+
+      //! Handler for from_bufferOut
+      //!
+      void from_bufferOut_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          Fw::Buffer &fwBuffer /*!< The buffer*/
+      );
+
+      //! Handler for from_comOut
+      //!
+      void from_comOut_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          Fw::ComBuffer &data, /*!< Buffer containing packet data*/
+          U32 context /*!< Call context value; meaning chosen by user*/
+      );
+
+      //! Handler for from_streamReturnOut
+      //!
+      void from_streamReturnOut_handler(
+          const NATIVE_INT_TYPE portNum, /*!< The port number*/
+          Fw::Buffer &fwBuffer /*!< The buffer*/
+      );
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper methods
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      //!
+      void connectPorts();
+
+      //! Initialize components
+      //!
+      void initComponents();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      //!
+      MathStreamDownlink component;
+
+  };
+
+} // end namespace MathModule
+
+#endif
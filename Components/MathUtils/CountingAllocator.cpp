@@ -0,0 +1,56 @@
+// ======================================================================
+// \title  CountingAllocator.cpp
+// \brief  cpp file for the memory allocator that counts what it hands out
+// ======================================================================
+
+#include <Components/MathUtils/CountingAllocator.hpp>
+
+namespace MathModule {
+
+  CountingAllocator ::
+    CountingAllocator(Fw::MemAllocator& allocator) :
+      m_allocator(allocator),
+      m_allocatedBytes(0),
+      m_allocations(0)
+  {
+
+  }
+
+  void* CountingAllocator ::
+    allocate(
+        const NATIVE_UINT_TYPE identifier,
+        NATIVE_UINT_TYPE& size,
+        bool& recoverable
+    )
+  {
+    void* const memory = this->m_allocator.allocate(identifier, size, recoverable);
+    // A failed allocation reports a size of zero, so only successes are counted
+    if (memory != nullptr) {
+        this->m_allocatedBytes += size;
+        this->m_allocations++;
+    }
+    return memory;
+  }
+
+  void CountingAllocator ::
+    deallocate(
+        const NATIVE_UINT_TYPE identifier,
+        void* ptr
+    )
+  {
+    this->m_allocator.deallocate(identifier, ptr);
+  }
+
+  U64 CountingAllocator ::
+    getAllocatedBytes() const
+  {
+    return this->m_allocatedBytes;
+  }
+
+  U32 CountingAllocator ::
+    getAllocations() const
+  {
+    return this->m_allocations;
+  }
+
+} // end namespace MathModule
@@ -0,0 +1,63 @@
+// ======================================================================
+// \title  CountingAllocator.hpp
+// \brief  hpp file for the memory allocator that counts what it hands out
+// ======================================================================
+
+#ifndef CountingAllocator_HPP
+#define CountingAllocator_HPP
+
+#include <FpConfig.hpp>
+#include <Fw/Types/MemAllocator.hpp>
+
+namespace MathModule {
+
+  //! Memory allocator that passes requests on to another and counts the bytes it hands out
+  //!
+  //! The count only grows, so the difference between two readings is what was
+  //! allocated in between. Not thread safe.
+  class CountingAllocator :
+    public Fw::MemAllocator
+  {
+
+    public:
+
+      //! Construct an allocator that counts the allocations of another
+      CountingAllocator(
+          Fw::MemAllocator& allocator /*!< The allocator that supplies the memory*/
+      );
+
+      //! Allocate memory from the underlying allocator
+      void* allocate(
+          const NATIVE_UINT_TYPE identifier, /*!< The memory segment identifier*/
+          NATIVE_UINT_TYPE& size, /*!< The size to allocate; receives the size allocated*/
+          bool& recoverable /*!< Receives whether the memory is recoverable*/
+      );
+
+      //! Return memory to the underlying allocator
+      void deallocate(
+          const NATIVE_UINT_TYPE identifier, /*!< The memory segment identifier*/
+          void* ptr /*!< The memory to return*/
+      );
+
+      //! Bytes handed out since construction
+      U64 getAllocatedBytes() const;
+
+      //! Allocations made since construction
+      U32 getAllocations() const;
+
+    private:
+
+      //! The allocator that supplies the memory
+      Fw::MemAllocator& m_allocator;
+
+      //! Bytes handed out
+      U64 m_allocatedBytes;
+
+      //! Allocations made
+      U32 m_allocations;
+
+  };
+
+} // end namespace MathModule
+
+#endif
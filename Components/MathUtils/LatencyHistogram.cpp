@@ -0,0 +1,106 @@
+// ======================================================================
+// \title  LatencyHistogram.cpp
+// \brief  cpp file for a fixed-memory latency histogram
+// ======================================================================
+
+#include <Components/MathUtils/LatencyHistogram.hpp>
+#include <Fw/Types/Assert.hpp>
+
+namespace MathModule {
+
+  LatencyHistogram ::
+    LatencyHistogram()
+  {
+    this->reset();
+  }
+
+  void LatencyHistogram ::
+    record(U32 latencyUs)
+  {
+    this->m_buckets[bucketOf(latencyUs)]++;
+    this->m_count++;
+    if (latencyUs > this->m_max) {
+        this->m_max = latencyUs;
+    }
+  }
+
+  void LatencyHistogram ::
+    reset()
+  {
+    for (U32 i = 0; i < NUM_BUCKETS; i++) {
+        this->m_buckets[i] = 0;
+    }
+    this->m_count = 0;
+    this->m_max = 0;
+  }
+
+  U32 LatencyHistogram ::
+    percentile(U32 percent) const
+  {
+    FW_ASSERT(percent <= 100, percent);
+    if (this->m_count == 0) {
+        return 0;
+    }
+    // Rank of the requested sample, counting from one
+    U64 rank = (static_cast<U64>(this->m_count) * percent + 99) / 100;
+    if (rank == 0) {
+        rank = 1;
+    }
+    U64 seen = 0;
+    for (U32 i = 0; i < NUM_BUCKETS; i++) {
+        seen += this->m_buckets[i];
+        if (seen >= rank) {
+            // Upper bound of bucket i is 2^i - 1
+            const U32 upper = (i == 0) ? 0 : static_cast<U32>((static_cast<U64>(1) << i) - 1);
+            return (upper < this->m_max) ? upper : this->m_max;
+        }
+    }
+    return this->m_max;
+  }
+
+  U32 LatencyHistogram ::
+    getCount() const
+  {
+    return this->m_count;
+  }
+
+  U32 LatencyHistogram ::
+    getMax() const
+  {
+    return this->m_max;
+  }
+
+  U32 LatencyHistogram ::
+    getBucket(U32 bucket) const
+  {
+    FW_ASSERT(bucket < NUM_BUCKETS, bucket);
+    return this->m_buckets[bucket];
+  }
+
+  U32 LatencyHistogram ::
+    elapsedUs(
+        const Fw::Time& start,
+        const Fw::Time& end
+    )
+  {
+    if (end < start) {
+        return 0;
+    }
+    const Fw::Time diff = Fw::Time::sub(end, start);
+    const U64 us = static_cast<U64>(diff.getSeconds()) * 1000000 + diff.getUSeconds();
+    return (us > 0xFFFFFFFF) ? 0xFFFFFFFF : static_cast<U32>(us);
+  }
+
+  U32 LatencyHistogram ::
+    bucketOf(U32 latencyUs)
+  {
+    // Bit length of the value, capped at the last bucket
+    U32 bucket = 0;
+    while ((latencyUs != 0) && (bucket < NUM_BUCKETS - 1)) {
+        latencyUs >>= 1;
+        bucket++;
+    }
+    return bucket;
+  }
+
+} // end namespace MathModule
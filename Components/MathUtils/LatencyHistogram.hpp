@@ -0,0 +1,80 @@
+// ======================================================================
+// \title  LatencyHistogram.hpp
+// \brief  hpp file for a fixed-memory latency histogram
+// ======================================================================
+
+#ifndef LatencyHistogram_HPP
+#define LatencyHistogram_HPP
+
+#include <FpConfig.hpp>
+#include <Fw/Time/Time.hpp>
+
+namespace MathModule {
+
+  //! Histogram of latencies in microseconds with power-of-two buckets
+  //!
+  //! Bucket 0 counts zero, and bucket b > 0 counts values in [2^(b-1), 2^b).
+  //! The last bucket also absorbs everything above its range. Percentiles
+  //! are reported as the upper bound of the bucket holding the requested rank,
+  //! capped by the largest value seen.
+  class LatencyHistogram {
+
+    public:
+
+      enum {
+        //! Number of buckets; the last starts at 2^(NUM_BUCKETS - 2) us
+        NUM_BUCKETS = 24
+      };
+
+      //! Construct an empty histogram
+      LatencyHistogram();
+
+      //! Add one sample
+      void record(
+          U32 latencyUs /*!< The latency in microseconds*/
+      );
+
+      //! Remove all samples
+      void reset();
+
+      //! Latency at or below which the given percent of samples fall
+      U32 percentile(
+          U32 percent /*!< The percentile, 0 to 100*/
+      ) const;
+
+      //! Number of samples
+      U32 getCount() const;
+
+      //! Largest sample
+      U32 getMax() const;
+
+      //! Number of samples in a bucket
+      U32 getBucket(
+          U32 bucket /*!< The bucket index*/
+      ) const;
+
+      //! Microseconds elapsed between two times, saturating at the U32 range
+      static U32 elapsedUs(
+          const Fw::Time& start, /*!< The earlier time*/
+          const Fw::Time& end /*!< The later time*/
+      );
+
+    private:
+
+      //! Bucket holding a value
+      static U32 bucketOf(U32 latencyUs);
+
+      //! Samples per bucket
+      U32 m_buckets[NUM_BUCKETS];
+
+      //! Number of samples
+      U32 m_count;
+
+      //! Largest sample
+      U32 m_max;
+
+  };
+
+} // end namespace MathModule
+
+#endif
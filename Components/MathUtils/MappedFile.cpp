@@ -0,0 +1,86 @@
+// ======================================================================
+// \title  MappedFile.cpp
+// \brief  cpp file for a read-only memory-mapped file
+// ======================================================================
+
+#include <Components/MathUtils/MappedFile.hpp>
+#include <Fw/Types/Assert.hpp>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace MathModule {
+
+  MappedFile ::
+    MappedFile() :
+      m_data(nullptr),
+      m_size(0)
+  {
+
+  }
+
+  MappedFile ::
+    ~MappedFile()
+  {
+    this->close();
+  }
+
+  bool MappedFile ::
+    open(const char* path)
+  {
+    FW_ASSERT(path != nullptr);
+    FW_ASSERT(this->m_data == nullptr);
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if ((fstat(fd, &info) != 0) || (info.st_size <= 0)) {
+        (void) ::close(fd);
+        return false;
+    }
+    const FwSizeType size = static_cast<FwSizeType>(info.st_size);
+    void* const data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping holds its own reference to the file
+    (void) ::close(fd);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+    // The file is read once from front to back
+    (void) madvise(data, size, MADV_SEQUENTIAL);
+    this->m_data = static_cast<const U8*>(data);
+    this->m_size = size;
+    return true;
+  }
+
+  void MappedFile ::
+    close()
+  {
+    if (this->m_data == nullptr) {
+        return;
+    }
+    (void) munmap(const_cast<U8*>(this->m_data), this->m_size);
+    this->m_data = nullptr;
+    this->m_size = 0;
+  }
+
+  bool MappedFile ::
+    isOpen() const
+  {
+    return this->m_data != nullptr;
+  }
+
+  const U8* MappedFile ::
+    getData() const
+  {
+    return this->m_data;
+  }
+
+  FwSizeType MappedFile ::
+    getSize() const
+  {
+    return this->m_size;
+  }
+
+} // end namespace MathModule
@@ -0,0 +1,62 @@
+// ======================================================================
+// \title  MappedFile.hpp
+// \brief  hpp file for a read-only memory-mapped file
+// ======================================================================
+
+#ifndef MappedFile_HPP
+#define MappedFile_HPP
+
+#include <FpConfig.hpp>
+
+namespace MathModule {
+
+  //! A file mapped read-only into memory for sequential reading
+  //!
+  //! Pages are read in by the kernel as they are touched, so a large file
+  //! costs no buffer copies and no up-front read. POSIX only.
+  class MappedFile {
+
+    public:
+
+      //! Construct an unmapped file
+      MappedFile();
+
+      //! Unmap the file if it is mapped
+      ~MappedFile();
+
+      //! Map a file
+      //!
+      //! \return true if the file was opened and mapped; empty files cannot be mapped
+      bool open(
+          const char* path /*!< The path of the file*/
+      );
+
+      //! Unmap the file
+      void close();
+
+      //! Whether a file is mapped
+      bool isOpen() const;
+
+      //! The mapped bytes
+      const U8* getData() const;
+
+      //! The number of mapped bytes
+      FwSizeType getSize() const;
+
+    private:
+
+      //! Copying would unmap the file twice
+      MappedFile(const MappedFile&);
+      MappedFile& operator=(const MappedFile&);
+
+      //! The mapped bytes, or nullptr
+      const U8* m_data;
+
+      //! The number of mapped bytes
+      FwSizeType m_size;
+
+  };
+
+} // end namespace MathModule
+
+#endif
@@ -0,0 +1,193 @@
+// ======================================================================
+// \title  MemoCache.cpp
+// \brief  cpp file for a fixed-memory cache of math operation results
+// ======================================================================
+
+#include <Components/MathUtils/MemoCache.hpp>
+#include <Fw/Types/Assert.hpp>
+#include <cstring>
+
+namespace MathModule {
+
+  namespace {
+
+    //! Bit pattern of a float
+    U32 bitsOf(F32 value) {
+        U32 bits;
+        static_assert(sizeof(bits) == sizeof(value), "F32 must be 32 bits");
+        (void) memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+  }
+
+  MemoCache ::
+    MemoCache() :
+      m_entries(nullptr),
+      m_capacity(0),
+      m_accesses(0),
+      m_hits(0),
+      m_misses(0),
+      m_evictions(0)
+  {
+
+  }
+
+  void MemoCache ::
+    setup(
+        Entry* entries,
+        U32 capacity
+    )
+  {
+    FW_ASSERT((entries != nullptr) || (capacity == 0), capacity);
+    // Round down to a power of two so the home slot is a mask
+    U32 used = 0;
+    if (capacity > 0) {
+        used = 1;
+        while (used <= (capacity / 2)) {
+            used *= 2;
+        }
+    }
+    this->m_entries = entries;
+    this->m_capacity = used;
+    this->clear();
+  }
+
+  bool MemoCache ::
+    isEnabled() const
+  {
+    return this->m_capacity > 0;
+  }
+
+  bool MemoCache ::
+    lookup(
+        F32 val1,
+        U8 op,
+        F32 val2,
+        F32 factor,
+        F32& result
+    )
+  {
+    if (this->m_capacity == 0) {
+        return false;
+    }
+    const U32 bits1 = bitsOf(val1);
+    const U32 bits2 = bitsOf(val2);
+    const U32 bitsFactor = bitsOf(factor);
+    const U32 start = this->home(bits1, op, bits2, bitsFactor);
+    this->m_accesses++;
+    for (U32 i = 0; i < PROBE_LIMIT; i++) {
+        Entry& entry = this->m_entries[(start + i) & (this->m_capacity - 1)];
+        // Entries are only removed all at once, so a free slot ends the search
+        if (!entry.valid) {
+            break;
+        }
+        if ((entry.val1 == bits1) && (entry.val2 == bits2) &&
+            (entry.factor == bitsFactor) && (entry.op == op)) {
+            entry.lastUsed = this->m_accesses;
+            this->m_hits++;
+            result = entry.result;
+            return true;
+        }
+    }
+    this->m_misses++;
+    return false;
+  }
+
+  void MemoCache ::
+    insert(
+        F32 val1,
+        U8 op,
+        F32 val2,
+        F32 factor,
+        F32 result
+    )
+  {
+    if (this->m_capacity == 0) {
+        return;
+    }
+    const U32 bits1 = bitsOf(val1);
+    const U32 bits2 = bitsOf(val2);
+    const U32 bitsFactor = bitsOf(factor);
+    const U32 start = this->home(bits1, op, bits2, bitsFactor);
+    this->m_accesses++;
+    Entry* victim = nullptr;
+    for (U32 i = 0; i < PROBE_LIMIT; i++) {
+        Entry& entry = this->m_entries[(start + i) & (this->m_capacity - 1)];
+        if (!entry.valid ||
+            ((entry.val1 == bits1) && (entry.val2 == bits2) &&
+             (entry.factor == bitsFactor) && (entry.op == op))) {
+            victim = &entry;
+            break;
+        }
+        if ((victim == nullptr) || (entry.lastUsed < victim->lastUsed)) {
+            victim = &entry;
+        }
+    }
+    FW_ASSERT(victim != nullptr);
+    if (victim->valid &&
+        ((victim->val1 != bits1) || (victim->val2 != bits2) ||
+         (victim->factor != bitsFactor) || (victim->op != op))) {
+        this->m_evictions++;
+    }
+    victim->val1 = bits1;
+    victim->val2 = bits2;
+    victim->factor = bitsFactor;
+    victim->op = op;
+    victim->result = result;
+    victim->lastUsed = this->m_accesses;
+    victim->valid = true;
+  }
+
+  void MemoCache ::
+    clear()
+  {
+    for (U32 i = 0; i < this->m_capacity; i++) {
+        this->m_entries[i].valid = false;
+    }
+  }
+
+  U32 MemoCache ::
+    getCapacity() const
+  {
+    return this->m_capacity;
+  }
+
+  U32 MemoCache ::
+    getHits() const
+  {
+    return this->m_hits;
+  }
+
+  U32 MemoCache ::
+    getMisses() const
+  {
+    return this->m_misses;
+  }
+
+  U32 MemoCache ::
+    getEvictions() const
+  {
+    return this->m_evictions;
+  }
+
+  U32 MemoCache ::
+    home(
+        U32 val1,
+        U8 op,
+        U32 val2,
+        U32 factor
+    ) const
+  {
+    // Mix the key words; the finalizer spreads nearby operands across the table
+    U32 hash = val1 * 0x9E3779B1U;
+    hash = (hash ^ val2) * 0x85EBCA77U;
+    hash = (hash ^ factor) * 0xC2B2AE3DU;
+    hash ^= op;
+    hash ^= hash >> 16;
+    hash *= 0x7FEB352DU;
+    hash ^= hash >> 15;
+    return hash & (this->m_capacity - 1);
+  }
+
+} // end namespace MathModule
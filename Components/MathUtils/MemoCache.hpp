@@ -0,0 +1,116 @@
+// ======================================================================
+// \title  MemoCache.hpp
+// \brief  hpp file for a fixed-memory cache of math operation results
+// ======================================================================
+
+#ifndef MemoCache_HPP
+#define MemoCache_HPP
+
+#include <FpConfig.hpp>
+
+namespace MathModule {
+
+  //! Open-addressed cache of results keyed by operands, operation and factor
+  //!
+  //! Keys compare by bit pattern, so -0 and +0 are different keys and NaN
+  //! operands hit like any other value. A key lives within PROBE_LIMIT slots
+  //! of its home slot; when those slots are full, an insert replaces the least
+  //! recently used of them, which approximates LRU over the whole table. The
+  //! cache runs in memory handed to setup and never allocates.
+  class MemoCache {
+
+    public:
+
+      enum {
+        //! Slots searched from the home slot of a key
+        PROBE_LIMIT = 4
+      };
+
+      //! One cached result
+      struct Entry {
+        U32 val1; //!< Bits of the first operand
+        U32 val2; //!< Bits of the second operand
+        U32 factor; //!< Bits of the factor
+        U32 lastUsed; //!< Access count when the entry was last used
+        F32 result; //!< The result
+        U8 op; //!< The operation
+        bool valid; //!< Whether the slot holds a result
+      };
+
+      //! Construct a cache with no memory; lookups miss until setup is called
+      MemoCache();
+
+      //! Give the cache its memory and empty it
+      //!
+      //! Only the largest power of two of entries not above capacity is used.
+      void setup(
+          Entry* entries, /*!< The memory, or nullptr to disable the cache*/
+          U32 capacity /*!< The number of entries in the memory*/
+      );
+
+      //! Whether the cache has memory
+      bool isEnabled() const;
+
+      //! Find a cached result
+      //!
+      //! \return true and set result on a hit
+      bool lookup(
+          F32 val1, /*!< The first operand*/
+          U8 op, /*!< The operation*/
+          F32 val2, /*!< The second operand*/
+          F32 factor, /*!< The factor*/
+          F32& result /*!< Receives the result*/
+      );
+
+      //! Add a result, replacing the least recently used nearby entry if needed
+      void insert(
+          F32 val1, /*!< The first operand*/
+          U8 op, /*!< The operation*/
+          F32 val2, /*!< The second operand*/
+          F32 factor, /*!< The factor*/
+          F32 result /*!< The result*/
+      );
+
+      //! Remove every entry
+      void clear();
+
+      //! Number of entries used
+      U32 getCapacity() const;
+
+      //! Lookups that found a result
+      U32 getHits() const;
+
+      //! Lookups that found no result
+      U32 getMisses() const;
+
+      //! Inserts that replaced another result
+      U32 getEvictions() const;
+
+    private:
+
+      //! Home slot of a key
+      U32 home(U32 val1, U8 op, U32 val2, U32 factor) const;
+
+      //! The entries
+      Entry* m_entries;
+
+      //! Number of entries used; zero or a power of two
+      U32 m_capacity;
+
+      //! Number of lookups and inserts, used to age the entries
+      U32 m_accesses;
+
+      //! Lookups that found a result
+      U32 m_hits;
+
+      //! Lookups that found no result
+      U32 m_misses;
+
+      //! Inserts that replaced another result
+      U32 m_evictions;
+
+  };
+
+} // end namespace MathModule
+
+#endif
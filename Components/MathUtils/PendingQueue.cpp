@@ -0,0 +1,265 @@
+// ======================================================================
+// \title  PendingQueue.cpp
+// \brief  cpp file for the FIFO of math requests waiting in a component queue
+// ======================================================================
+
+#include <Components/MathUtils/PendingQueue.hpp>
+#include <Fw/Types/Assert.hpp>
+#include <cstring>
+
+namespace MathModule {
+
+  static_assert(PendingQueue::CAPACITY < PendingQueue::NO_LINK, "Links must fit in U16");
+  static_assert((PendingQueue::NUM_BUCKETS & (PendingQueue::NUM_BUCKETS - 1)) == 0,
+                "NUM_BUCKETS must be a power of two");
+
+  namespace {
+
+    //! Bit pattern of a float
+    U32 bitsOf(F32 value) {
+        U32 bits;
+        static_assert(sizeof(bits) == sizeof(value), "F32 must be 32 bits");
+        (void) memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+  }
+
+  PendingQueue ::
+    PendingQueue() :
+      m_freeFollowers(0),
+      m_releasing(NO_LINK),
+      m_head(0),
+      m_count(0)
+  {
+    for (U32 i = 0; i < NUM_BUCKETS; i++) {
+        this->m_chains[i] = NO_LINK;
+    }
+    for (U32 i = 0; i + 1 < CAPACITY; i++) {
+        this->m_followers[i].next = static_cast<U16>(i + 1);
+    }
+    this->m_followers[CAPACITY - 1].next = NO_LINK;
+  }
+
+  U32 PendingQueue ::
+    size() const
+  {
+    return this->m_count;
+  }
+
+  bool PendingQueue ::
+    push(const Request& request)
+  {
+    if (this->m_count == CAPACITY) {
+        return false;
+    }
+    const U16 slot = static_cast<U16>((this->m_head + this->m_count) % CAPACITY);
+    Slot& entry = this->m_slots[slot];
+    entry.request = request;
+    entry.key = keyOf(request);
+    entry.followers = NO_LINK;
+    this->link(slot);
+    this->m_count++;
+    return true;
+  }
+
+  bool PendingQueue ::
+    pop(Request& request)
+  {
+    FW_ASSERT(this->m_releasing == NO_LINK);
+    if (this->m_count == 0) {
+        return false;
+    }
+    const U16 slot = static_cast<U16>(this->m_head);
+    Slot& entry = this->m_slots[slot];
+    request = entry.request;
+    this->m_releasing = entry.followers;
+    this->unlinkOldest(slot);
+    this->m_head = (this->m_head + 1) % CAPACITY;
+    this->m_count--;
+    return true;
+  }
+
+  bool PendingQueue ::
+    popFollower(U32& requestId)
+  {
+    const U16 follower = this->m_releasing;
+    if (follower == NO_LINK) {
+        return false;
+    }
+    requestId = this->m_followers[follower].requestId;
+    this->m_releasing = this->m_followers[follower].next;
+    this->m_followers[follower].next = this->m_freeFollowers;
+    this->m_freeFollowers = follower;
+    return true;
+  }
+
+  bool PendingQueue ::
+    dropOldest(Request& request)
+  {
+    // The front leaves the same way whether it is served or dropped
+    return this->pop(request);
+  }
+
+  bool PendingQueue ::
+    dropNewest(Request& request)
+  {
+    FW_ASSERT(this->m_releasing == NO_LINK);
+    if (this->m_count == 0) {
+        return false;
+    }
+    const U16 slot = static_cast<U16>((this->m_head + this->m_count - 1) % CAPACITY);
+    const Slot& entry = this->m_slots[slot];
+    request = entry.request;
+    this->m_releasing = entry.followers;
+    this->unlinkNewest(slot, NO_LINK);
+    this->m_count--;
+    return true;
+  }
+
+  bool PendingQueue ::
+    mergeNewest()
+  {
+    if ((this->m_count == 0) || (this->m_freeFollowers == NO_LINK)) {
+        return false;
+    }
+    const U16 newest = static_cast<U16>((this->m_head + this->m_count - 1) % CAPACITY);
+    const Slot& entry = this->m_slots[newest];
+    // Only a request with an older duplicate has one to merge into
+    if (entry.groupPrev == NO_LINK) {
+        return false;
+    }
+    const U16 target = this->findOldest(entry);
+    FW_ASSERT(target != NO_LINK, newest);
+    // Requests only merge into the oldest of their group, so the newest has none merged into it
+    FW_ASSERT(entry.followers == NO_LINK);
+    const U16 follower = this->m_freeFollowers;
+    this->m_freeFollowers = this->m_followers[follower].next;
+    this->m_followers[follower].requestId = entry.request.requestId;
+    this->m_followers[follower].next = this->m_slots[target].followers;
+    this->m_slots[target].followers = follower;
+    this->unlinkNewest(newest, target);
+    this->m_count--;
+    return true;
+  }
+
+  U32 PendingQueue ::
+    keyOf(const Request& request)
+  {
+    // The same mix as MemoCache; the low bits pick the chain
+    U32 hash = bitsOf(request.val1) * 0x9E3779B1U;
+    hash = (hash ^ bitsOf(request.val2)) * 0x85EBCA77U;
+    hash ^= request.op;
+    hash ^= hash >> 16;
+    hash *= 0x7FEB352DU;
+    hash ^= hash >> 15;
+    return hash;
+  }
+
+  bool PendingQueue ::
+    sameOperands(
+        const Request& a,
+        const Request& b
+    )
+  {
+    return (bitsOf(a.val1) == bitsOf(b.val1)) &&
+           (bitsOf(a.val2) == bitsOf(b.val2)) &&
+           (a.op == b.op);
+  }
+
+  U16 PendingQueue ::
+    findOldest(const Slot& entry) const
+  {
+    for (U16 slot = this->m_chains[entry.key & (NUM_BUCKETS - 1)]; slot != NO_LINK;
+         slot = this->m_slots[slot].chainNext) {
+        if ((this->m_slots[slot].key == entry.key) && sameOperands(this->m_slots[slot].request, entry.request)) {
+            return slot;
+        }
+    }
+    return NO_LINK;
+  }
+
+  void PendingQueue ::
+    link(U16 slot)
+  {
+    Slot& entry = this->m_slots[slot];
+    const U16 oldest = this->findOldest(entry);
+    entry.groupNext = NO_LINK;
+    if (oldest != NO_LINK) {
+        // A duplicate joins the back of its group and stays out of the index
+        const U16 tail = this->m_slots[oldest].groupTail;
+        this->m_slots[tail].groupNext = slot;
+        entry.groupPrev = tail;
+        this->m_slots[oldest].groupTail = slot;
+        return;
+    }
+    entry.groupPrev = NO_LINK;
+    entry.groupTail = slot;
+    U16& chain = this->m_chains[entry.key & (NUM_BUCKETS - 1)];
+    entry.chainPrev = NO_LINK;
+    entry.chainNext = chain;
+    if (chain != NO_LINK) {
+        this->m_slots[chain].chainPrev = slot;
+    }
+    chain = slot;
+  }
+
+  void PendingQueue ::
+    unlinkOldest(U16 slot)
+  {
+    const Slot& entry = this->m_slots[slot];
+    const U16 next = entry.groupNext;
+    // The next of the group, if any, becomes the oldest and takes the index entry
+    if (next != NO_LINK) {
+        this->m_slots[next].groupPrev = NO_LINK;
+        this->m_slots[next].groupTail = entry.groupTail;
+    }
+    this->replaceInChain(slot, next);
+  }
+
+  void PendingQueue ::
+    unlinkNewest(
+        U16 slot,
+        U16 oldest
+    )
+  {
+    const Slot& entry = this->m_slots[slot];
+    if (entry.groupPrev == NO_LINK) {
+        // Alone in its group
+        this->replaceInChain(slot, NO_LINK);
+        return;
+    }
+    if (oldest == NO_LINK) {
+        oldest = this->findOldest(entry);
+    }
+    FW_ASSERT(oldest != NO_LINK, slot);
+    this->m_slots[entry.groupPrev].groupNext = NO_LINK;
+    this->m_slots[oldest].groupTail = entry.groupPrev;
+  }
+
+  void PendingQueue ::
+    replaceInChain(
+        U16 slot,
+        U16 replacement
+    )
+  {
+    const Slot& entry = this->m_slots[slot];
+    const U16 prev = entry.chainPrev;
+    const U16 next = entry.chainNext;
+    U16 link = next;
+    if (replacement != NO_LINK) {
+        this->m_slots[replacement].chainPrev = prev;
+        this->m_slots[replacement].chainNext = next;
+        link = replacement;
+    }
+    if (prev != NO_LINK) {
+        this->m_slots[prev].chainNext = link;
+    } else {
+        this->m_chains[entry.key & (NUM_BUCKETS - 1)] = link;
+    }
+    if (next != NO_LINK) {
+        this->m_slots[next].chainPrev = (replacement != NO_LINK) ? replacement : prev;
+    }
+  }
+
+} // end namespace MathModule
@@ -0,0 +1,186 @@
+// ======================================================================
+// \title  PendingQueue.hpp
+// \brief  hpp file for the FIFO of math requests waiting in a component queue
+// ======================================================================
+
+#ifndef PendingQueue_HPP
+#define PendingQueue_HPP
+
+#include <FpConfig.hpp>
+
+namespace MathModule {
+
+  //! Bounded FIFO of math requests with an index of their operands
+  //!
+  //! Requests leave from the front, and either end can be dropped. The newest
+  //! request can also be merged into the oldest queued request with the same
+  //! operands and operation; it then follows that request out and gets the
+  //! same result. Keys compare by bit pattern, as in MemoCache.
+  //!
+  //! Queued requests with the same operands form a group, oldest first, and
+  //! the index holds only the oldest request of each group, so a lookup walks
+  //! one chain of distinct requests, one entry on average however many
+  //! duplicates are queued. Every operation takes constant expected time, and
+  //! the requests merged into a popped or dropped one are handed out by
+  //! popFollower one per call. Not thread safe.
+  class PendingQueue {
+
+    public:
+
+      enum {
+        //! Number of requests the queue holds, and of merged requests besides
+        CAPACITY = 72,
+        //! Chains in the operand index; a power of two
+        NUM_BUCKETS = 128,
+        //! Marks the end of a chain or list
+        NO_LINK = 0xFFFF
+      };
+
+      //! One math request
+      struct Request {
+        U32 requestId; //!< The identifier of the request
+        F32 val1; //!< The first operand
+        F32 val2; //!< The second operand
+        U8 op; //!< The operation
+      };
+
+      //! Construct an empty queue
+      PendingQueue();
+
+      //! Number of requests in the queue, not counting merged ones
+      U32 size() const;
+
+      //! Add a request at the back
+      //!
+      //! \return false if the queue is full
+      bool push(
+          const Request& request /*!< The request*/
+      );
+
+      //! Remove the request at the front
+      //!
+      //! Requests merged into it are then returned by popFollower, which must
+      //! be called until it returns false before the next pop.
+      //!
+      //! \return false if the queue is empty
+      bool pop(
+          Request& request /*!< Receives the request*/
+      );
+
+      //! Take the next request merged into the one last popped
+      //!
+      //! \return false once none is left
+      bool popFollower(
+          U32& requestId /*!< Receives the identifier of the merged request*/
+      );
+
+      //! Remove the request at the front
+      //!
+      //! Requests merged into it are then returned by popFollower, as for pop.
+      //!
+      //! \return false if the queue is empty
+      bool dropOldest(
+          Request& request /*!< Receives the removed request*/
+      );
+
+      //! Remove the request at the back
+      //!
+      //! Requests merged into it are then returned by popFollower, as for pop.
+      //!
+      //! \return false if the queue is empty
+      bool dropNewest(
+          Request& request /*!< Receives the removed request*/
+      );
+
+      //! Merge the request at the back into the oldest queued request with the same operands
+      //!
+      //! \return true if the request was merged; false if no queued request
+      //! matches or no room is left for merged requests
+      bool mergeNewest();
+
+    private:
+
+      //! A queued request and its links
+      struct Slot {
+        Request request; //!< The request
+        U32 key; //!< Hash of the operands and operation
+        U16 groupPrev; //!< Older slot with the same operands
+        U16 groupNext; //!< Newer slot with the same operands
+        U16 groupTail; //!< Newest slot with the same operands; kept by the oldest only
+        U16 chainPrev; //!< Previous oldest slot in the same index chain; kept by the oldest only
+        U16 chainNext; //!< Next oldest slot in the same index chain; kept by the oldest only
+        U16 followers; //!< First request merged into this one
+      };
+
+      //! A request merged into a queued one
+      struct Follower {
+        U32 requestId; //!< The identifier of the request
+        U16 next; //!< Next request merged into the same one
+      };
+
+      //! Hash of the operands and operation of a request
+      static U32 keyOf(
+          const Request& request /*!< The request*/
+      );
+
+      //! Whether two requests have the same operands and operation
+      static bool sameOperands(
+          const Request& a, /*!< The first request*/
+          const Request& b /*!< The second request*/
+      );
+
+      //! Find the oldest queued slot with the same operands as a request
+      //!
+      //! \return the slot, or NO_LINK if none is in the index
+      U16 findOldest(
+          const Slot& entry /*!< A slot holding the request*/
+      ) const;
+
+      //! Add a slot at the back of its group, indexing it if the group is new
+      void link(
+          U16 slot /*!< The slot*/
+      );
+
+      //! Remove the front slot, the oldest of its group
+      void unlinkOldest(
+          U16 slot /*!< The slot*/
+      );
+
+      //! Remove the back slot, the newest of its group
+      void unlinkNewest(
+          U16 slot, /*!< The slot*/
+          U16 oldest /*!< The oldest slot of its group, or NO_LINK if not yet looked up*/
+      );
+
+      //! Replace a slot in its index chain, or remove it with NO_LINK
+      void replaceInChain(
+          U16 slot, /*!< The indexed slot*/
+          U16 replacement /*!< The slot taking its place, or NO_LINK*/
+      );
+
+      //! Requests in queue order, starting at m_head
+      Slot m_slots[CAPACITY];
+
+      //! Newest slot of each index chain
+      U16 m_chains[NUM_BUCKETS];
+
+      //! Storage for merged requests
+      Follower m_followers[CAPACITY];
+
+      //! First unused entry of m_followers
+      U16 m_freeFollowers;
+
+      //! Merged requests of the last popped request not yet taken
+      U16 m_releasing;
+
+      //! Slot of the front request
+      U32 m_head;
+
+      //! Number of queued requests
+      U32 m_count;
+
+  };
+
+} // end namespace MathModule
+
+#endif
@@ -0,0 +1,93 @@
+// ======================================================================
+// \title  RequestLog.cpp
+// \brief  cpp file for the binary log format of recorded math requests
+// ======================================================================
+
+#include <Components/MathUtils/RequestLog.hpp>
+#include <Fw/Types/Assert.hpp>
+#include <Fw/Types/Serializable.hpp>
+
+namespace MathModule {
+
+  void RequestLog ::
+    writeHeader(
+        U8* buffer,
+        U32 count
+    )
+  {
+    FW_ASSERT(buffer != nullptr);
+    Fw::ExternalSerializeBuffer header(buffer, HEADER_SIZE);
+    Fw::SerializeStatus status = header.serialize(static_cast<U32>(MAGIC));
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = header.serialize(static_cast<U32>(VERSION));
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = header.serialize(count);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = header.serialize(static_cast<U32>(RECORD_SIZE));
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+  }
+
+  bool RequestLog ::
+    readHeader(
+        const U8* buffer,
+        U32& count
+    )
+  {
+    FW_ASSERT(buffer != nullptr);
+    // The serialize buffer only reads, so the cast does not write through
+    Fw::ExternalSerializeBuffer header(const_cast<U8*>(buffer), HEADER_SIZE);
+    Fw::SerializeStatus status = header.setBuffLen(HEADER_SIZE);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    U32 magic = 0;
+    U32 version = 0;
+    U32 recordSize = 0;
+    (void) header.deserialize(magic);
+    (void) header.deserialize(version);
+    (void) header.deserialize(count);
+    status = header.deserialize(recordSize);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    return (magic == MAGIC) && (version == VERSION) && (recordSize == RECORD_SIZE);
+  }
+
+  void RequestLog ::
+    writeRecord(
+        U8* buffer,
+        const Record& record
+    )
+  {
+    FW_ASSERT(buffer != nullptr);
+    Fw::ExternalSerializeBuffer out(buffer, RECORD_SIZE);
+    Fw::SerializeStatus status = out.serialize(record.seconds);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = out.serialize(record.useconds);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = out.serialize(record.requestId);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = out.serialize(record.val1);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = out.serialize(record.val2);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = out.serialize(record.op);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+  }
+
+  void RequestLog ::
+    readRecord(
+        const U8* buffer,
+        Record& record
+    )
+  {
+    FW_ASSERT(buffer != nullptr);
+    Fw::ExternalSerializeBuffer in(const_cast<U8*>(buffer), RECORD_SIZE);
+    Fw::SerializeStatus status = in.setBuffLen(RECORD_SIZE);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    (void) in.deserialize(record.seconds);
+    (void) in.deserialize(record.useconds);
+    (void) in.deserialize(record.requestId);
+    (void) in.deserialize(record.val1);
+    (void) in.deserialize(record.val2);
+    status = in.deserialize(record.op);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+  }
+
+} // end namespace MathModule
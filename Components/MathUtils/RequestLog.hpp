@@ -0,0 +1,74 @@
+// ======================================================================
+// \title  RequestLog.hpp
+// \brief  hpp file for the binary log format of recorded math requests
+// ======================================================================
+
+#ifndef RequestLog_HPP
+#define RequestLog_HPP
+
+#include <FpConfig.hpp>
+
+namespace MathModule {
+
+  //! Layout of a log of math requests, written by RequestRecorder and read by MathReplay
+  //!
+  //! A header of HEADER_SIZE bytes (magic, version, record count, record size)
+  //! is followed by fixed-size records, all big-endian. The recorder reserves
+  //! the whole file up front, so only the first count records are valid; the
+  //! count is filled in when recording stops.
+  class RequestLog {
+
+    public:
+
+      enum {
+        //! First word of every log, "MRLG"
+        MAGIC = 0x4D524C47,
+        //! Version of the layout below
+        VERSION = 1,
+        //! Bytes of the header
+        HEADER_SIZE = 16,
+        //! Bytes of one record
+        RECORD_SIZE = 21
+      };
+
+      //! One recorded request
+      struct Record {
+        U32 seconds; //!< Arrival time, seconds
+        U32 useconds; //!< Arrival time, microseconds
+        U32 requestId; //!< The identifier of the request
+        F32 val1; //!< The first operand
+        F32 val2; //!< The second operand
+        U8 op; //!< The operation
+      };
+
+      //! Write a header into HEADER_SIZE bytes
+      static void writeHeader(
+          U8* buffer, /*!< Receives the header*/
+          U32 count /*!< The number of valid records*/
+      );
+
+      //! Read a header from HEADER_SIZE bytes
+      //!
+      //! \return false if the buffer does not hold a header of this version
+      static bool readHeader(
+          const U8* buffer, /*!< The header*/
+          U32& count /*!< Receives the number of valid records*/
+      );
+
+      //! Write a record into RECORD_SIZE bytes
+      static void writeRecord(
+          U8* buffer, /*!< Receives the record*/
+          const Record& record /*!< The record*/
+      );
+
+      //! Read a record from RECORD_SIZE bytes
+      static void readRecord(
+          const U8* buffer, /*!< The record*/
+          Record& record /*!< Receives the record*/
+      );
+
+  };
+
+} // end namespace MathModule
+
+#endif
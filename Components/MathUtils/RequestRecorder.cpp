@@ -0,0 +1,190 @@
+// ======================================================================
+// \title  RequestRecorder.cpp
+// \brief  cpp file for the background writer of request logs
+// ======================================================================
+
+#include <Components/MathUtils/RequestRecorder.hpp>
+#include <Fw/Types/Assert.hpp>
+
+namespace MathModule {
+
+  RequestRecorder ::
+    RequestRecorder() :
+      m_maxRecords(0),
+      m_written(0),
+      m_recording(false),
+      m_running(false),
+      m_failed(false),
+      m_recorded(0),
+      m_dropped(0)
+  {
+
+  }
+
+  RequestRecorder ::
+    ~RequestRecorder()
+  {
+    (void) this->stop();
+  }
+
+  bool RequestRecorder ::
+    start(
+        const char* path,
+        U32 maxRecords
+    )
+  {
+    FW_ASSERT(path != nullptr);
+    FW_ASSERT(!this->m_running.load());
+    if (this->m_file.open(path, Os::File::OPEN_CREATE, Os::File::OVERWRITE) != Os::File::OP_OK) {
+        return false;
+    }
+    // Reserve the whole log now so the task never waits on the file system to grow it
+    const FwSignedSizeType size = RequestLog::HEADER_SIZE +
+        static_cast<FwSignedSizeType>(maxRecords) * RequestLog::RECORD_SIZE;
+    const Os::File::Status sized = this->m_file.preallocate(0, size);
+    U8 header[RequestLog::HEADER_SIZE];
+    RequestLog::writeHeader(header, 0);
+    FwSignedSizeType written = sizeof(header);
+    if (((sized != Os::File::OP_OK) && (sized != Os::File::NOT_SUPPORTED)) ||
+        (this->m_file.write(header, written, Os::File::WAIT) != Os::File::OP_OK) ||
+        (written != static_cast<FwSignedSizeType>(sizeof(header)))) {
+        this->m_file.close();
+        return false;
+    }
+
+    // Discard anything a failed earlier log left in the ring
+    RequestLog::Record discard;
+    while (this->m_ring.pop(&discard, 1) > 0) {
+    }
+    this->m_maxRecords = maxRecords;
+    this->m_written = 0;
+    this->m_failed = false;
+    this->m_recorded = 0;
+    this->m_dropped = 0;
+    this->m_running = true;
+
+    Os::TaskString taskName("MathRecorder");
+    Os::Task::Arguments arguments(taskName, RequestRecorder::writerTaskRoutine, this);
+    const Os::Task::Status taskStatus = this->m_task.start(arguments);
+    FW_ASSERT(taskStatus == Os::Task::OP_OK, taskStatus);
+    return true;
+  }
+
+  void RequestRecorder ::
+    enable()
+  {
+    FW_ASSERT(this->m_running.load());
+    this->m_recording.store(true, std::memory_order_release);
+  }
+
+  void RequestRecorder ::
+    disable()
+  {
+    this->m_recording.store(false, std::memory_order_release);
+  }
+
+  void RequestRecorder ::
+    record(const RequestLog::Record& record)
+  {
+    if (!this->m_recording.load(std::memory_order_acquire)) {
+        return;
+    }
+    const U32 recorded = this->m_recorded.load(std::memory_order_relaxed);
+    if ((recorded < this->m_maxRecords) && this->m_ring.push(record)) {
+        this->m_recorded.store(recorded + 1, std::memory_order_relaxed);
+    } else {
+        this->m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  bool RequestRecorder ::
+    stop()
+  {
+    if (!this->m_running.load()) {
+        return true;
+    }
+    // The task writes out what is left in the ring before it exits
+    this->m_recording = false;
+    this->m_running = false;
+    (void) this->m_task.join();
+
+    bool ok = !this->m_failed.load();
+    U8 header[RequestLog::HEADER_SIZE];
+    RequestLog::writeHeader(header, this->m_written);
+    FwSignedSizeType written = sizeof(header);
+    if ((this->m_file.seek(0, Os::File::SeekType::ABSOLUTE) != Os::File::OP_OK) ||
+        (this->m_file.write(header, written, Os::File::WAIT) != Os::File::OP_OK) ||
+        (written != static_cast<FwSignedSizeType>(sizeof(header)))) {
+        ok = false;
+    }
+    this->m_file.close();
+    return ok;
+  }
+
+  bool RequestRecorder ::
+    isRecording() const
+  {
+    return this->m_recording.load();
+  }
+
+  bool RequestRecorder ::
+    isOpen() const
+  {
+    return this->m_running.load();
+  }
+
+  U32 RequestRecorder ::
+    getRecorded() const
+  {
+    return this->m_recorded.load();
+  }
+
+  U32 RequestRecorder ::
+    getDropped() const
+  {
+    return this->m_dropped.load();
+  }
+
+  void RequestRecorder ::
+    writerTaskRoutine(void* arg)
+  {
+    FW_ASSERT(arg != nullptr);
+    RequestRecorder* const recorder = static_cast<RequestRecorder*>(arg);
+    while (true) {
+        // Read the flag first so the ring is drained after the last record
+        const bool running = recorder->m_running.load();
+        if (recorder->writeChunk() > 0) {
+            continue;
+        }
+        if (!running) {
+            break;
+        }
+        (void) Os::Task::delay(Fw::TimeInterval(0, IDLE_DELAY_MS * 1000));
+    }
+  }
+
+  U32 RequestRecorder ::
+    writeChunk()
+  {
+    RequestLog::Record records[WRITE_CHUNK];
+    const U32 count = this->m_ring.pop(records, WRITE_CHUNK);
+    if ((count == 0) || this->m_failed.load()) {
+        return count;
+    }
+    for (U32 i = 0; i < count; i++) {
+        RequestLog::writeRecord(&this->m_chunk[i * RequestLog::RECORD_SIZE], records[i]);
+    }
+    const FwSignedSizeType bytes = static_cast<FwSignedSizeType>(count) * RequestLog::RECORD_SIZE;
+    FwSignedSizeType written = bytes;
+    if ((this->m_file.write(this->m_chunk, written, Os::File::WAIT) != Os::File::OP_OK) ||
+        (written != bytes)) {
+        // Later requests are discarded; the header counts only whole records
+        this->m_failed = true;
+        this->m_written += static_cast<U32>(written / RequestLog::RECORD_SIZE);
+        return count;
+    }
+    this->m_written += count;
+    return count;
+  }
+
+} // end namespace MathModule
@@ -0,0 +1,137 @@
+// ======================================================================
+// \title  RequestRecorder.hpp
+// \brief  hpp file for the background writer of request logs
+// ======================================================================
+
+#ifndef RequestRecorder_HPP
+#define RequestRecorder_HPP
+
+#include <Components/MathUtils/RequestLog.hpp>
+#include <Components/MathUtils/SpscRing.hpp>
+#include <Os/File.hpp>
+#include <Os/Task.hpp>
+#include <atomic>
+
+namespace MathModule {
+
+  //! Records math requests to a RequestLog file from a task of its own
+  //!
+  //! record only copies the request into a ring, so the caller never waits
+  //! on the disk; the task writes the ring out in chunks. The file is sized
+  //! for maxRecords when recording starts, and requests beyond that or
+  //! arriving while the ring is full are counted as dropped. One thread may
+  //! call record at a time. start and stop do the file work and wait for the
+  //! task, so they run with recording disabled and may overlap record; enable
+  //! and disable only flip a flag, and are serialized with record by the
+  //! caller, so no request is being recorded once disable returns.
+  class RequestRecorder {
+
+    public:
+
+      enum {
+        //! Requests the ring holds between writes
+        RING_CAPACITY = 1024,
+        //! Most requests written at once
+        WRITE_CHUNK = 256,
+        //! Milliseconds the task sleeps when the ring is empty
+        IDLE_DELAY_MS = 10
+      };
+
+      //! Construct a stopped recorder
+      RequestRecorder();
+
+      //! Stop recording if it is running
+      ~RequestRecorder();
+
+      //! Create a log and start the task writing into it
+      //!
+      //! Requests are recorded once enable is called.
+      //!
+      //! \return false if the file could not be created or sized
+      bool start(
+          const char* path, /*!< The path of the log*/
+          U32 maxRecords /*!< The most requests to record*/
+      );
+
+      //! Accept requests into the started log
+      void enable();
+
+      //! Stop accepting requests, ahead of stop
+      void disable();
+
+      //! Record a request; never blocks
+      void record(
+          const RequestLog::Record& record /*!< The request*/
+      );
+
+      //! Write out the recorded requests, fill in the header, and close the log
+      //!
+      //! \return false if any write failed; the log is then incomplete
+      bool stop();
+
+      //! Whether requests are being accepted
+      bool isRecording() const;
+
+      //! Whether a log is open
+      bool isOpen() const;
+
+      //! Number of requests recorded since start
+      U32 getRecorded() const;
+
+      //! Number of requests dropped since start
+      U32 getDropped() const;
+
+    private:
+
+      //! Copying would share the file and the task
+      RequestRecorder(const RequestRecorder&);
+      RequestRecorder& operator=(const RequestRecorder&);
+
+      //! Entry point of the writer task
+      static void writerTaskRoutine(
+          void* arg /*!< The RequestRecorder instance*/
+      );
+
+      //! Write out whatever the ring holds
+      //!
+      //! \return the number of requests taken from the ring
+      U32 writeChunk();
+
+      //! Requests waiting to be written
+      SpscRing<RequestLog::Record, RING_CAPACITY> m_ring;
+
+      //! The log
+      Os::File m_file;
+
+      //! The writer task
+      Os::Task m_task;
+
+      //! A chunk of requests in log layout
+      U8 m_chunk[WRITE_CHUNK * RequestLog::RECORD_SIZE];
+
+      //! Requests the log has room for
+      U32 m_maxRecords;
+
+      //! Requests written to the log; written by the task only
+      U32 m_written;
+
+      //! Whether record accepts requests
+      std::atomic<bool> m_recording;
+
+      //! Whether the task keeps running
+      std::atomic<bool> m_running;
+
+      //! Whether a write has failed
+      std::atomic<bool> m_failed;
+
+      //! Requests accepted by record
+      std::atomic<U32> m_recorded;
+
+      //! Requests dropped by record
+      std::atomic<U32> m_dropped;
+
+  };
+
+} // end namespace MathModule
+
+#endif
@@ -0,0 +1,134 @@
+// ======================================================================
+// \title  RequestTracker.cpp
+// \brief  cpp file for the table of math requests awaiting results
+// ======================================================================
+
+#include <Components/MathUtils/RequestTracker.hpp>
+#include <Components/MathUtils/LatencyHistogram.hpp>
+#include <Fw/Types/Assert.hpp>
+
+namespace MathModule {
+
+  RequestTracker ::
+    RequestTracker(
+        U32 tag,
+        U32 tagMask
+    ) :
+      m_tag(tag),
+      m_tagMask(tagMask)
+  {
+    FW_ASSERT((tag & ~tagMask) == 0, tag, tagMask);
+    // Sequence numbers must wrap onto the same slots
+    FW_ASSERT(((~tagMask + 1) % CAPACITY) == 0, tagMask);
+    this->reset();
+  }
+
+  void RequestTracker ::
+    reset()
+  {
+    for (U32 i = 0; i < CAPACITY; i++) {
+        this->m_slots[i].requestId = 0;
+        this->m_slots[i].active = false;
+    }
+    this->m_nextSeq = 0;
+    this->m_oldestSeq = 0;
+    this->m_outstanding = 0;
+  }
+
+  bool RequestTracker ::
+    owns(U32 requestId) const
+  {
+    return (requestId & this->m_tagMask) == this->m_tag;
+  }
+
+  bool RequestTracker ::
+    isFull() const
+  {
+    return this->m_slots[this->m_nextSeq % CAPACITY].active;
+  }
+
+  U32 RequestTracker ::
+    getOutstanding() const
+  {
+    return this->m_outstanding;
+  }
+
+  U32 RequestTracker ::
+    claim(const Fw::Time& now)
+  {
+    Slot& slot = this->m_slots[this->m_nextSeq % CAPACITY];
+    FW_ASSERT(!slot.active, this->m_nextSeq);
+    // The slot may be the oldest one, answered but not yet passed by expire
+    if (((this->m_nextSeq - this->m_oldestSeq) & ~this->m_tagMask) == CAPACITY) {
+        this->m_oldestSeq = this->nextSeq(this->m_oldestSeq);
+    }
+    slot.requestId = this->m_tag | this->m_nextSeq;
+    slot.sent = now;
+    slot.active = true;
+    this->m_nextSeq = this->nextSeq(this->m_nextSeq);
+    this->m_outstanding++;
+    return slot.requestId;
+  }
+
+  bool RequestTracker ::
+    complete(
+        U32 requestId,
+        const Fw::Time& now,
+        U32& latencyUs
+    )
+  {
+    if (!this->owns(requestId)) {
+        return false;
+    }
+    Slot& slot = this->m_slots[requestId % CAPACITY];
+    if (!slot.active || (slot.requestId != requestId)) {
+        return false;
+    }
+    slot.active = false;
+    this->m_outstanding--;
+    latencyUs = LatencyHistogram::elapsedUs(slot.sent, now);
+    return true;
+  }
+
+  U32 RequestTracker ::
+    expire(
+        const Fw::Time& now,
+        U32 timeoutUs
+    )
+  {
+    // Requests are answered roughly in order, so only the oldest need checking
+    U32 expired = 0;
+    while (this->m_oldestSeq != this->m_nextSeq) {
+        Slot& slot = this->m_slots[this->m_oldestSeq % CAPACITY];
+        if (slot.active) {
+            if (LatencyHistogram::elapsedUs(slot.sent, now) < timeoutUs) {
+                break;
+            }
+            slot.active = false;
+            this->m_outstanding--;
+            expired++;
+        }
+        this->m_oldestSeq = this->nextSeq(this->m_oldestSeq);
+    }
+    return expired;
+  }
+
+  U32 RequestTracker ::
+    abandon()
+  {
+    const U32 abandoned = this->m_outstanding;
+    for (U32 i = 0; i < CAPACITY; i++) {
+        this->m_slots[i].active = false;
+    }
+    this->m_oldestSeq = this->m_nextSeq;
+    this->m_outstanding = 0;
+    return abandoned;
+  }
+
+  U32 RequestTracker ::
+    nextSeq(U32 seq) const
+  {
+    return (seq + 1) & ~this->m_tagMask;
+  }
+
+} // end namespace MathModule
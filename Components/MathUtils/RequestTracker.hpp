@@ -0,0 +1,113 @@
+// ======================================================================
+// \title  RequestTracker.hpp
+// \brief  hpp file for the table of math requests awaiting results
+// ======================================================================
+
+#ifndef RequestTracker_HPP
+#define RequestTracker_HPP
+
+#include <FpConfig.hpp>
+#include <Fw/Time/Time.hpp>
+
+namespace MathModule {
+
+  //! Table of requests a component has sent and is waiting on, keyed by identifier
+  //!
+  //! Identifiers are a fixed tag in the bits of tagMask and a sequence number
+  //! in the rest, so a component that shares a result path with others can
+  //! tell its own results apart. Each sequence number maps to one slot, and
+  //! requests are expired oldest first, so every operation but expire takes
+  //! constant time. Not thread safe.
+  class RequestTracker {
+
+    public:
+
+      enum {
+        //! Most requests waiting at once
+        CAPACITY = 1024
+      };
+
+      //! Construct an empty table
+      RequestTracker(
+          U32 tag, /*!< The bits set in every identifier*/
+          U32 tagMask /*!< The high bits that hold the tag*/
+      );
+
+      //! Forget every request and start the sequence again
+      void reset();
+
+      //! Whether an identifier carries the tag
+      bool owns(
+          U32 requestId /*!< The identifier*/
+      ) const;
+
+      //! Whether the slot of the next request is still taken
+      bool isFull() const;
+
+      //! Number of requests waiting
+      U32 getOutstanding() const;
+
+      //! Record a request as sent; the table must not be full
+      //!
+      //! \return the identifier to send with it
+      U32 claim(
+          const Fw::Time& now /*!< When the request is sent*/
+      );
+
+      //! Match a result to its request
+      //!
+      //! \return false if no request with the identifier is waiting
+      bool complete(
+          U32 requestId, /*!< The identifier in the result*/
+          const Fw::Time& now, /*!< When the result arrived*/
+          U32& latencyUs /*!< Receives the round-trip time, in microseconds*/
+      );
+
+      //! Give up on the oldest requests that have waited too long
+      //!
+      //! \return the number of requests given up on
+      U32 expire(
+          const Fw::Time& now, /*!< The current time*/
+          U32 timeoutUs /*!< The longest wait, in microseconds*/
+      );
+
+      //! Give up on every waiting request
+      //!
+      //! \return the number of requests given up on
+      U32 abandon();
+
+    private:
+
+      //! A request waiting for its result
+      struct Slot {
+        U32 requestId; //!< The identifier sent with the request
+        Fw::Time sent; //!< When the request was sent
+        bool active; //!< Whether the result is still due
+      };
+
+      //! Next sequence number after seq
+      U32 nextSeq(U32 seq) const;
+
+      //! The bits set in every identifier
+      const U32 m_tag;
+
+      //! The high bits that hold the tag
+      const U32 m_tagMask;
+
+      //! Requests indexed by sequence number
+      Slot m_slots[CAPACITY];
+
+      //! Sequence number of the next request
+      U32 m_nextSeq;
+
+      //! Sequence number of the oldest request that may still be waiting
+      U32 m_oldestSeq;
+
+      //! Requests waiting
+      U32 m_outstanding;
+
+  };
+
+} // end namespace MathModule
+
+#endif
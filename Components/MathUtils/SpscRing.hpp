@@ -0,0 +1,103 @@
+// ======================================================================
+// \title  SpscRing.hpp
+// \brief  hpp file for a lock-free single-producer, single-consumer ring
+// ======================================================================
+
+#ifndef SpscRing_HPP
+#define SpscRing_HPP
+
+#include <FpConfig.hpp>
+#include <atomic>
+
+namespace MathModule {
+
+  //! Fixed-capacity ring passing records from one producer thread to one consumer thread
+  //!
+  //! push is wait-free and pop takes as many records as are available up to a limit.
+  //! Each record sits in its own cache line, and the producer and consumer indices sit
+  //! in separate cache lines, so the two threads do not contend for the same lines.
+  //! Only one thread may push and only one thread may pop at a time.
+  template <typename T, U32 CAPACITY>
+  class SpscRing {
+
+      static_assert((CAPACITY > 0) && ((CAPACITY & (CAPACITY - 1)) == 0),
+                    "SpscRing capacity must be a power of two");
+
+    public:
+
+      enum {
+        //! Assumed size of a cache line, in bytes
+        CACHE_LINE_SIZE = 64
+      };
+
+      //! Construct an empty ring
+      SpscRing() :
+        m_head(0),
+        m_tail(0)
+      {
+
+      }
+
+      //! Add a record; called by the producer only
+      //!
+      //! \return true if the record was added, false if the ring was full
+      bool push(
+          const T& record /*!< The record*/
+      ) {
+        const U32 tail = this->m_tail.load(std::memory_order_relaxed);
+        const U32 head = this->m_head.load(std::memory_order_acquire);
+        if ((tail - head) == CAPACITY) {
+            return false;
+        }
+        this->m_slots[tail & (CAPACITY - 1)].record = record;
+        // Publish the record to the consumer
+        this->m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+      }
+
+      //! Remove up to maxRecords records in order; called by the consumer only
+      //!
+      //! \return the number of records removed
+      U32 pop(
+          T* records, /*!< Receives the records*/
+          U32 maxRecords /*!< The maximum number of records to remove*/
+      ) {
+        const U32 head = this->m_head.load(std::memory_order_relaxed);
+        const U32 tail = this->m_tail.load(std::memory_order_acquire);
+        const U32 available = tail - head;
+        const U32 count = (available < maxRecords) ? available : maxRecords;
+        for (U32 i = 0; i < count; i++) {
+            records[i] = this->m_slots[(head + i) & (CAPACITY - 1)].record;
+        }
+        // Hand the slots back to the producer
+        this->m_head.store(head + count, std::memory_order_release);
+        return count;
+      }
+
+      //! Number of records in the ring; exact only when neither side is active
+      U32 size() const {
+        return this->m_tail.load(std::memory_order_acquire) -
+               this->m_head.load(std::memory_order_acquire);
+      }
+
+    private:
+
+      //! One record, padded to a cache line
+      struct alignas(CACHE_LINE_SIZE) Slot {
+        T record;
+      };
+
+      //! Index of the next record to pop, written by the consumer
+      alignas(CACHE_LINE_SIZE) std::atomic<U32> m_head;
+
+      //! Index of the next record to push, written by the producer
+      alignas(CACHE_LINE_SIZE) std::atomic<U32> m_tail;
+
+      //! The records
+      Slot m_slots[CAPACITY];
+
+  };
+
+} // end namespace MathModule
+
+#endif
@@ -0,0 +1,137 @@
+// ======================================================================
+// \title  StartupProfile.cpp
+// \brief  cpp file for the record of how long each startup phase took
+// ======================================================================
+
+#include <Components/MathUtils/StartupProfile.hpp>
+#include <Fw/Types/Assert.hpp>
+#include <Os/File.hpp>
+#include <cstdarg>
+#include <cstdio>
+
+namespace MathModule {
+
+  namespace {
+
+    //! Format onto the end of a buffer, advancing length
+    //!
+    //! \return false if the text did not fit
+    bool append(char* buffer, FwSizeType size, FwSizeType& length, const char* format, ...) {
+        va_list args;
+        va_start(args, format);
+        // vsnprintf reports the length it wanted, so text that was cut short shows as too long
+        const int written = vsnprintf(buffer + length, size - length, format, args);
+        va_end(args);
+        if ((written < 0) || (static_cast<FwSizeType>(written) >= (size - length))) {
+            return false;
+        }
+        length += static_cast<FwSizeType>(written);
+        return true;
+    }
+
+  }
+
+  StartupProfile ::
+    StartupProfile() :
+      m_count(0),
+      m_depth(0)
+  {
+
+  }
+
+  void StartupProfile ::
+    begin(
+        const char* name,
+        U64 allocatedBytes
+    )
+  {
+    FW_ASSERT(name != nullptr);
+    FW_ASSERT(this->m_count < MAX_PHASES, this->m_count);
+    FW_ASSERT(this->m_depth < MAX_DEPTH, this->m_depth);
+    Phase& phase = this->m_phases[this->m_count];
+    phase.name = name;
+    phase.depth = this->m_depth;
+    phase.wallUs = 0;
+    phase.allocatedBytes = 0;
+    this->m_open[this->m_depth] = this->m_count;
+    this->m_beganBytes[this->m_depth] = allocatedBytes;
+    (void) this->m_began[this->m_depth].now();
+    this->m_count++;
+    this->m_depth++;
+  }
+
+  void StartupProfile ::
+    end(U64 allocatedBytes)
+  {
+    FW_ASSERT(this->m_depth > 0);
+    Os::RawTime now;
+    (void) now.now();
+    this->m_depth--;
+    Phase& phase = this->m_phases[this->m_open[this->m_depth]];
+    U32 wallUs = 0;
+    if (now.getDiffUsec(this->m_began[this->m_depth], wallUs) == Os::RawTime::OP_OK) {
+        phase.wallUs = wallUs;
+    }
+    const U64 began = this->m_beganBytes[this->m_depth];
+    phase.allocatedBytes = (allocatedBytes > began) ? (allocatedBytes - began) : 0;
+  }
+
+  U32 StartupProfile ::
+    getCount() const
+  {
+    return this->m_count;
+  }
+
+  const StartupProfile::Phase& StartupProfile ::
+    getPhase(U32 index) const
+  {
+    FW_ASSERT(index < this->m_count, index, this->m_count);
+    return this->m_phases[index];
+  }
+
+  FwSizeType StartupProfile ::
+    formatJson(
+        char* buffer,
+        FwSizeType size
+    ) const
+  {
+    FW_ASSERT(buffer != nullptr);
+    FW_ASSERT(size > 0);
+    FwSizeType length = 0;
+    bool fits = append(buffer, size, length, "{\"phases\": [");
+    for (U32 i = 0; fits && (i < this->m_count); i++) {
+        const Phase& phase = this->m_phases[i];
+        fits = append(buffer, size, length,
+                      "%s\n  {\"name\": \"%s\", \"depth\": %u, \"wall_us\": %u, \"allocated_bytes\": %llu}",
+                      (i == 0) ? "" : ",", phase.name, static_cast<unsigned int>(phase.depth),
+                      static_cast<unsigned int>(phase.wallUs), static_cast<unsigned long long>(phase.allocatedBytes));
+    }
+    fits = fits && append(buffer, size, length, "\n]}\n");
+    if (!fits) {
+        buffer[0] = '\0';
+        return 0;
+    }
+    return length;
+  }
+
+  bool StartupProfile ::
+    writeJson(const char* path) const
+  {
+    FW_ASSERT(path != nullptr);
+    char json[JSON_SIZE];
+    const FwSizeType length = this->formatJson(json, sizeof(json));
+    if (length == 0) {
+        return false;
+    }
+    Os::File file;
+    if (file.open(path, Os::File::OPEN_CREATE, Os::File::OVERWRITE) != Os::File::OP_OK) {
+        return false;
+    }
+    FwSignedSizeType written = static_cast<FwSignedSizeType>(length);
+    const bool ok = (file.write(reinterpret_cast<const U8*>(json), written, Os::File::WAIT) == Os::File::OP_OK) &&
+                    (written == static_cast<FwSignedSizeType>(length));
+    file.close();
+    return ok;
+  }
+
+} // end namespace MathModule
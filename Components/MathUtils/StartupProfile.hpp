@@ -0,0 +1,102 @@
+// ======================================================================
+// \title  StartupProfile.hpp
+// \brief  hpp file for the record of how long each startup phase took
+// ======================================================================
+
+#ifndef StartupProfile_HPP
+#define StartupProfile_HPP
+
+#include <FpConfig.hpp>
+#include <Os/RawTime.hpp>
+
+namespace MathModule {
+
+  //! Wall time and allocated bytes of each phase of a startup
+  //!
+  //! Phases are timed with the raw monotonic clock, since startup runs before
+  //! the time component is connected. They nest: a phase begun inside another
+  //! is recorded after it with a depth one greater, and its time and bytes are
+  //! also counted in its parent. Not thread safe.
+  class StartupProfile {
+
+    public:
+
+      enum {
+        //! Most phases recorded
+        MAX_PHASES = 16,
+        //! Most phases open at once
+        MAX_DEPTH = 4,
+        //! Size of the JSON written by writeJson
+        JSON_SIZE = MAX_PHASES * 128 + 32
+      };
+
+      //! A timed phase
+      struct Phase {
+        const char* name; //!< What the phase did; must outlive the profile
+        U32 depth; //!< Phases open around this one
+        U32 wallUs; //!< Microseconds from begin to end
+        U64 allocatedBytes; //!< Bytes allocated from begin to end
+      };
+
+      //! Construct an empty profile
+      StartupProfile();
+
+      //! Start timing a phase inside those already open
+      void begin(
+          const char* name, /*!< What the phase does; must outlive the profile*/
+          U64 allocatedBytes /*!< Bytes allocated so far*/
+      );
+
+      //! Stop timing the innermost open phase
+      void end(
+          U64 allocatedBytes /*!< Bytes allocated so far*/
+      );
+
+      //! Number of phases recorded
+      U32 getCount() const;
+
+      //! A phase, in the order it began
+      const Phase& getPhase(
+          U32 index /*!< The phase index, less than getCount*/
+      ) const;
+
+      //! Write the phases as a JSON object to a buffer, null terminated
+      //!
+      //! \return the length written, or 0 if the buffer is too small
+      FwSizeType formatJson(
+          char* buffer, /*!< The buffer*/
+          FwSizeType size /*!< The buffer size, in bytes*/
+      ) const;
+
+      //! Write the phases as a JSON file
+      //!
+      //! \return false if the file could not be written
+      bool writeJson(
+          const char* path /*!< The file to create or replace*/
+      ) const;
+
+    private:
+
+      //! Phases in the order they began
+      Phase m_phases[MAX_PHASES];
+
+      //! Phases recorded
+      U32 m_count;
+
+      //! Indices of the open phases, outermost first
+      U32 m_open[MAX_DEPTH];
+
+      //! When each open phase began
+      Os::RawTime m_began[MAX_DEPTH];
+
+      //! Bytes allocated when each open phase began
+      U64 m_beganBytes[MAX_DEPTH];
+
+      //! Phases open
+      U32 m_depth;
+
+  };
+
+} // end namespace MathModule
+
+#endif
@@ -0,0 +1,104 @@
+// ======================================================================
+// \title  MathBench.cpp
+// \brief  cpp file for helpers shared by the math benchmarks
+// ======================================================================
+
+#include <Components/MathUtils/test/bench/MathBench.hpp>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+  std::atomic<U64> s_allocations(0);
+
+  void* countedAlloc(std::size_t size) {
+      s_allocations.fetch_add(1, std::memory_order_relaxed);
+      void* const ptr = std::malloc((size == 0) ? 1 : size);
+      if (ptr == nullptr) {
+          throw std::bad_alloc();
+      }
+      return ptr;
+  }
+
+}
+
+// Replace the global allocation functions so the benchmarks can count them
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace MathModule {
+
+  namespace MathBench {
+
+    U64 allocationCount() {
+        return s_allocations.load(std::memory_order_relaxed);
+    }
+
+    Stopwatch ::
+      Stopwatch() :
+        m_startAllocations(0),
+        m_ns(0),
+        m_allocations(0)
+    {
+
+    }
+
+    void Stopwatch ::
+      start()
+    {
+        this->m_startAllocations = allocationCount();
+        this->m_start = std::chrono::steady_clock::now();
+    }
+
+    void Stopwatch ::
+      stop()
+    {
+        const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        this->m_allocations += allocationCount() - this->m_startAllocations;
+        this->m_ns += static_cast<U64>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - this->m_start).count()
+        );
+    }
+
+    U64 Stopwatch ::
+      getNs() const
+    {
+        return this->m_ns;
+    }
+
+    U64 Stopwatch ::
+      getAllocations() const
+    {
+        return this->m_allocations;
+    }
+
+    void report(
+        const char* component,
+        const char* benchmark,
+        const char* mix,
+        U32 depth,
+        U64 ops,
+        const Stopwatch& stopwatch
+    ) {
+        const F64 ns = static_cast<F64>(stopwatch.getNs());
+        const F64 count = static_cast<F64>((ops == 0) ? 1 : ops);
+        const F64 opsPerSec = (ns > 0) ? (count * 1e9 / ns) : 0;
+        (void) std::printf(
+            "{\"component\":\"%s\",\"benchmark\":\"%s\",\"mix\":\"%s\",\"depth\":%u,"
+            "\"ops\":%llu,\"ops_per_sec\":%.1f,\"ns_per_op\":%.1f,\"allocs_per_op\":%.3f}\n",
+            component, benchmark, mix, depth,
+            static_cast<unsigned long long>(ops), opsPerSec, ns / count,
+            static_cast<F64>(stopwatch.getAllocations()) / count
+        );
+        (void) std::fflush(stdout);
+    }
+
+  }
+
+} // end namespace MathModule
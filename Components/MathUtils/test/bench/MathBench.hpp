@@ -0,0 +1,61 @@
+// ======================================================================
+// \title  MathBench.hpp
+// \brief  hpp file for helpers shared by the math benchmarks
+// ======================================================================
+
+#ifndef MathBench_HPP
+#define MathBench_HPP
+
+#include <FpConfig.hpp>
+#include <chrono>
+
+namespace MathModule {
+
+  namespace MathBench {
+
+    //! Number of heap allocations made by the process so far
+    U64 allocationCount();
+
+    //! Accumulates the time and allocations of measured sections
+    class Stopwatch {
+
+      public:
+
+        Stopwatch();
+
+        //! Begin a measured section
+        void start();
+
+        //! End a measured section
+        void stop();
+
+        //! Total nanoseconds across measured sections
+        U64 getNs() const;
+
+        //! Total allocations across measured sections
+        U64 getAllocations() const;
+
+      private:
+
+        std::chrono::steady_clock::time_point m_start;
+        U64 m_startAllocations;
+        U64 m_ns;
+        U64 m_allocations;
+
+    };
+
+    //! Print one result as a JSON line on standard output
+    void report(
+        const char* component, /*!< The component benchmarked*/
+        const char* benchmark, /*!< The measured path*/
+        const char* mix, /*!< The operation mix*/
+        U32 depth, /*!< Requests per round*/
+        U64 ops, /*!< Number of measured operations*/
+        const Stopwatch& stopwatch /*!< The measurements*/
+    );
+
+  }
+
+} // end namespace MathModule
+
+#endif
@@ -0,0 +1,574 @@
+// ----------------------------------------------------------------------
+// TestMain.cpp
+// ----------------------------------------------------------------------
+
+#include <Components/MathUtils/CountingAllocator.hpp>
+#include <Components/MathUtils/LatencyHistogram.hpp>
+#include <Components/MathUtils/MappedFile.hpp>
+#include <Components/MathUtils/MemoCache.hpp>
+#include <Components/MathUtils/PendingQueue.hpp>
+#include <Components/MathUtils/RequestLog.hpp>
+#include <Components/MathUtils/RequestRecorder.hpp>
+#include <Components/MathUtils/RequestTracker.hpp>
+#include <Components/MathUtils/SpscRing.hpp>
+#include <Components/MathUtils/StartupProfile.hpp>
+#include <Fw/Types/MallocAllocator.hpp>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <thread>
+#include <vector>
+
+TEST(LatencyHistogram, Empty) {
+    MathModule::LatencyHistogram histogram;
+    ASSERT_EQ(histogram.getCount(), 0U);
+    ASSERT_EQ(histogram.getMax(), 0U);
+    ASSERT_EQ(histogram.percentile(50), 0U);
+}
+
+TEST(LatencyHistogram, Buckets) {
+    MathModule::LatencyHistogram histogram;
+    histogram.record(0);
+    histogram.record(1);
+    histogram.record(2);
+    histogram.record(3);
+    histogram.record(1000);
+    ASSERT_EQ(histogram.getBucket(0), 1U);
+    ASSERT_EQ(histogram.getBucket(1), 1U);
+    ASSERT_EQ(histogram.getBucket(2), 2U);
+    // 1000 has a bit length of 10
+    ASSERT_EQ(histogram.getBucket(10), 1U);
+    ASSERT_EQ(histogram.getCount(), 5U);
+    ASSERT_EQ(histogram.getMax(), 1000U);
+
+    // Values beyond the range land in the last bucket
+    histogram.record(0xFFFFFFFF);
+    ASSERT_EQ(histogram.getBucket(MathModule::LatencyHistogram::NUM_BUCKETS - 1), 1U);
+
+    histogram.reset();
+    ASSERT_EQ(histogram.getCount(), 0U);
+    ASSERT_EQ(histogram.getBucket(2), 0U);
+}
+
+TEST(LatencyHistogram, Percentiles) {
+    MathModule::LatencyHistogram histogram;
+    // 98 fast samples and 2 slow ones
+    for (U32 i = 0; i < 98; i++) {
+        histogram.record(5);
+    }
+    histogram.record(500);
+    histogram.record(600);
+    // 5 falls in [4, 8)
+    ASSERT_EQ(histogram.percentile(50), 7U);
+    // the 99th sample is 500, which falls in [256, 512)
+    ASSERT_EQ(histogram.percentile(99), 511U);
+    // the bucket bound is capped by the maximum
+    ASSERT_EQ(histogram.percentile(100), 600U);
+}
+
+TEST(LatencyHistogram, Elapsed) {
+    const Fw::Time start(TB_NONE, 10, 999999);
+    const Fw::Time end(TB_NONE, 12, 1);
+    ASSERT_EQ(MathModule::LatencyHistogram::elapsedUs(start, end), 1000002U);
+    // time going backwards reports zero
+    ASSERT_EQ(MathModule::LatencyHistogram::elapsedUs(end, start), 0U);
+}
+
+TEST(SpscRing, FullAndEmpty) {
+    MathModule::SpscRing<U32, 4> ring;
+    U32 out[8];
+    ASSERT_EQ(ring.pop(out, 8), 0U);
+    for (U32 i = 0; i < 4; i++) {
+        ASSERT_TRUE(ring.push(i));
+    }
+    // a full ring rejects the record
+    ASSERT_FALSE(ring.push(4));
+    ASSERT_EQ(ring.size(), 4U);
+
+    // pop takes no more than asked for, in order
+    ASSERT_EQ(ring.pop(out, 3), 3U);
+    ASSERT_EQ(out[0], 0U);
+    ASSERT_EQ(out[2], 2U);
+    ASSERT_EQ(ring.size(), 1U);
+}
+
+TEST(SpscRing, WrapAround) {
+    MathModule::SpscRing<U32, 4> ring;
+    U32 out[4];
+    U32 next = 0;
+    for (U32 round = 0; round < 10; round++) {
+        ASSERT_TRUE(ring.push(next));
+        ASSERT_TRUE(ring.push(next + 1));
+        ASSERT_TRUE(ring.push(next + 2));
+        ASSERT_EQ(ring.pop(out, 4), 3U);
+        for (U32 i = 0; i < 3; i++) {
+            ASSERT_EQ(out[i], next + i);
+        }
+        next += 3;
+    }
+}
+
+TEST(SpscRing, Threads) {
+    static MathModule::SpscRing<U32, 64> ring;
+    const U32 total = 100000;
+    std::thread producer([]() {
+        for (U32 i = 0; i < total; i++) {
+            while (!ring.push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    // The consumer sees every record exactly once, in order
+    U32 out[16];
+    U32 expected = 0;
+    while (expected < total) {
+        const U32 count = ring.pop(out, 16);
+        for (U32 i = 0; i < count; i++) {
+            ASSERT_EQ(out[i], expected);
+            expected++;
+        }
+        if (count == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    ASSERT_EQ(ring.size(), 0U);
+}
+
+TEST(MemoCache, Disabled) {
+    MathModule::MemoCache cache;
+    F32 result = 0;
+    ASSERT_FALSE(cache.isEnabled());
+    cache.insert(1.0f, 0, 2.0f, 1.0f, 3.0f);
+    ASSERT_FALSE(cache.lookup(1.0f, 0, 2.0f, 1.0f, result));
+    ASSERT_EQ(cache.getMisses(), 0U);
+}
+
+TEST(MemoCache, HitAndMiss) {
+    MathModule::MemoCache::Entry entries[20];
+    MathModule::MemoCache cache;
+    cache.setup(entries, 20);
+    // capacity rounds down to a power of two
+    ASSERT_EQ(cache.getCapacity(), 16U);
+
+    F32 result = 0;
+    ASSERT_FALSE(cache.lookup(1.0f, 0, 2.0f, 1.0f, result));
+    cache.insert(1.0f, 0, 2.0f, 1.0f, 3.0f);
+    ASSERT_TRUE(cache.lookup(1.0f, 0, 2.0f, 1.0f, result));
+    ASSERT_EQ(result, 3.0f);
+
+    // every part of the key counts, down to the sign of zero
+    ASSERT_FALSE(cache.lookup(1.0f, 1, 2.0f, 1.0f, result));
+    ASSERT_FALSE(cache.lookup(1.0f, 0, 2.0f, 2.0f, result));
+    ASSERT_FALSE(cache.lookup(-0.0f, 0, 0.0f, 1.0f, result));
+    ASSERT_EQ(cache.getHits(), 1U);
+    ASSERT_EQ(cache.getMisses(), 4U);
+
+    cache.clear();
+    ASSERT_FALSE(cache.lookup(1.0f, 0, 2.0f, 1.0f, result));
+}
+
+TEST(MemoCache, Eviction) {
+    MathModule::MemoCache::Entry entries[4];
+    MathModule::MemoCache cache;
+    cache.setup(entries, 4);
+    // A table no larger than the probe window holds every key it can
+    for (U32 i = 0; i < 4; i++) {
+        cache.insert(static_cast<F32>(i), 0, 0.0f, 1.0f, static_cast<F32>(i));
+    }
+    ASSERT_EQ(cache.getEvictions(), 0U);
+
+    // Using key 0 leaves key 1 as the least recently used
+    F32 result = 0;
+    ASSERT_TRUE(cache.lookup(0.0f, 0, 0.0f, 1.0f, result));
+    cache.insert(4.0f, 0, 0.0f, 1.0f, 4.0f);
+    ASSERT_EQ(cache.getEvictions(), 1U);
+    ASSERT_FALSE(cache.lookup(1.0f, 0, 0.0f, 1.0f, result));
+    ASSERT_TRUE(cache.lookup(0.0f, 0, 0.0f, 1.0f, result));
+    ASSERT_TRUE(cache.lookup(4.0f, 0, 0.0f, 1.0f, result));
+    ASSERT_EQ(result, 4.0f);
+
+    // Updating a key in place is not an eviction
+    cache.insert(4.0f, 0, 0.0f, 1.0f, 5.0f);
+    ASSERT_EQ(cache.getEvictions(), 1U);
+}
+
+TEST(PendingQueue, Fifo) {
+    MathModule::PendingQueue queue;
+    MathModule::PendingQueue::Request request = {0, 0.0f, 0.0f, 0};
+    ASSERT_FALSE(queue.pop(request));
+    // Several laps exercise the wrap around
+    for (U32 i = 0; i < 3 * MathModule::PendingQueue::CAPACITY; i++) {
+        request.requestId = i;
+        request.val1 = static_cast<F32>(i % 5);
+        ASSERT_TRUE(queue.push(request));
+        if (queue.size() == MathModule::PendingQueue::CAPACITY / 2) {
+            MathModule::PendingQueue::Request out;
+            ASSERT_TRUE(queue.pop(out));
+            ASSERT_EQ(out.requestId, i + 1 - MathModule::PendingQueue::CAPACITY / 2);
+            U32 follower = 0;
+            ASSERT_FALSE(queue.popFollower(follower));
+        }
+    }
+    while (queue.size() < MathModule::PendingQueue::CAPACITY) {
+        ASSERT_TRUE(queue.push(request));
+    }
+    ASSERT_FALSE(queue.push(request));
+}
+
+TEST(PendingQueue, Drop) {
+    MathModule::PendingQueue queue;
+    MathModule::PendingQueue::Request out;
+    ASSERT_FALSE(queue.dropOldest(out));
+    ASSERT_FALSE(queue.dropNewest(out));
+    for (U32 i = 0; i < 4; i++) {
+        const MathModule::PendingQueue::Request request = {i, static_cast<F32>(i), 1.0f, 0};
+        ASSERT_TRUE(queue.push(request));
+    }
+    ASSERT_TRUE(queue.dropOldest(out));
+    ASSERT_EQ(out.requestId, 0U);
+    ASSERT_TRUE(queue.dropNewest(out));
+    ASSERT_EQ(out.requestId, 3U);
+    ASSERT_TRUE(queue.pop(out));
+    ASSERT_EQ(out.requestId, 1U);
+    ASSERT_TRUE(queue.pop(out));
+    ASSERT_EQ(out.requestId, 2U);
+    ASSERT_EQ(queue.size(), 0U);
+}
+
+TEST(PendingQueue, Merge) {
+    MathModule::PendingQueue queue;
+    const MathModule::PendingQueue::Request a = {1, 2.0f, 3.0f, 0};
+    MathModule::PendingQueue::Request b = {2, 2.0f, 3.0f, 1};
+    ASSERT_TRUE(queue.push(a));
+    ASSERT_TRUE(queue.push(b));
+    // The operation is part of the key
+    ASSERT_FALSE(queue.mergeNewest());
+
+    // Duplicates of a merge into it, not into the newer b
+    MathModule::PendingQueue::Request c = a;
+    c.requestId = 3;
+    ASSERT_TRUE(queue.push(c));
+    ASSERT_TRUE(queue.mergeNewest());
+    c.requestId = 4;
+    ASSERT_TRUE(queue.push(c));
+    ASSERT_TRUE(queue.mergeNewest());
+    ASSERT_EQ(queue.size(), 2U);
+
+    MathModule::PendingQueue::Request out;
+    U32 follower = 0;
+    ASSERT_TRUE(queue.pop(out));
+    ASSERT_EQ(out.requestId, 1U);
+    U32 sum = 0;
+    while (queue.popFollower(follower)) {
+        sum += follower;
+    }
+    ASSERT_EQ(sum, 7U);
+
+    // Dropping a request hands out what was merged into it
+    b.requestId = 5;
+    ASSERT_TRUE(queue.push(b));
+    ASSERT_TRUE(queue.mergeNewest());
+    ASSERT_TRUE(queue.dropNewest(out));
+    ASSERT_EQ(out.requestId, 2U);
+    ASSERT_TRUE(queue.popFollower(follower));
+    ASSERT_EQ(follower, 5U);
+    ASSERT_FALSE(queue.popFollower(follower));
+    ASSERT_EQ(queue.size(), 0U);
+
+    // Merging stops when no room is left for merged requests
+    ASSERT_TRUE(queue.push(a));
+    for (U32 i = 0; i < MathModule::PendingQueue::CAPACITY; i++) {
+        ASSERT_TRUE(queue.push(a));
+        ASSERT_TRUE(queue.mergeNewest());
+    }
+    ASSERT_TRUE(queue.push(a));
+    ASSERT_FALSE(queue.mergeNewest());
+    ASSERT_TRUE(queue.dropOldest(out));
+    U32 followers = 0;
+    while (queue.popFollower(follower)) {
+        followers++;
+    }
+    ASSERT_EQ(followers, static_cast<U32>(MathModule::PendingQueue::CAPACITY));
+    ASSERT_TRUE(queue.push(a));
+    ASSERT_TRUE(queue.mergeNewest());
+}
+
+TEST(PendingQueue, Groups) {
+    // Random traffic over a few distinct requests, checked against a plain list
+    MathModule::PendingQueue queue;
+    std::deque<MathModule::PendingQueue::Request> model;
+    std::deque<std::vector<U32> > merged;
+    U32 freeFollowers = MathModule::PendingQueue::CAPACITY;
+    U32 seed = 1;
+    for (U32 i = 0; i < 20000; i++) {
+        seed = seed * 1103515245U + 12345U;
+        const U32 action = (seed >> 16) % 8;
+        MathModule::PendingQueue::Request out;
+        U32 follower = 0;
+        std::vector<U32> followers;
+        if (action < 4) {
+            const MathModule::PendingQueue::Request request = {i, static_cast<F32>((seed >> 8) % 3), 1.0f, 0};
+            const bool room = model.size() < MathModule::PendingQueue::CAPACITY;
+            ASSERT_EQ(queue.push(request), room);
+            if (room) {
+                model.push_back(request);
+                merged.push_back(followers);
+            }
+        } else if (action == 4) {
+            bool match = false;
+            for (U32 j = 0; !model.empty() && (j + 1 < model.size()) && !match; j++) {
+                if (model[j].val1 == model.back().val1) {
+                    match = (freeFollowers > 0);
+                    if (match) {
+                        merged[j].push_back(model.back().requestId);
+                    }
+                }
+            }
+            ASSERT_EQ(queue.mergeNewest(), match);
+            if (match) {
+                model.pop_back();
+                merged.pop_back();
+                freeFollowers--;
+            }
+        } else {
+            const bool front = (action != 7);
+            const bool removed = front ? queue.pop(out) : queue.dropNewest(out);
+            ASSERT_EQ(removed, !model.empty());
+            while (queue.popFollower(follower)) {
+                followers.push_back(follower);
+            }
+            if (!removed) {
+                continue;
+            }
+            const U32 expected = front ? model.front().requestId : model.back().requestId;
+            std::vector<U32> expectedFollowers = front ? merged.front() : merged.back();
+            ASSERT_EQ(out.requestId, expected);
+            std::sort(followers.begin(), followers.end());
+            std::sort(expectedFollowers.begin(), expectedFollowers.end());
+            ASSERT_EQ(followers, expectedFollowers);
+            freeFollowers += static_cast<U32>(followers.size());
+            if (front) {
+                model.pop_front();
+                merged.pop_front();
+            } else {
+                model.pop_back();
+                merged.pop_back();
+            }
+        }
+        ASSERT_EQ(queue.size(), model.size());
+    }
+}
+
+TEST(MappedFile, Read) {
+    const char* const path = "MappedFileTest.bin";
+    const U8 bytes[5] = {1, 2, 3, 4, 5};
+    FILE* const file = fopen(path, "wb");
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(fwrite(bytes, 1, sizeof(bytes), file), sizeof(bytes));
+    (void) fclose(file);
+
+    MathModule::MappedFile mapped;
+    ASSERT_TRUE(mapped.open(path));
+    ASSERT_TRUE(mapped.isOpen());
+    ASSERT_EQ(mapped.getSize(), sizeof(bytes));
+    ASSERT_EQ(mapped.getData()[4], 5);
+    mapped.close();
+    ASSERT_FALSE(mapped.isOpen());
+    (void) remove(path);
+
+    // missing and empty files are not mapped
+    ASSERT_FALSE(mapped.open(path));
+    fclose(fopen(path, "wb"));
+    ASSERT_FALSE(mapped.open(path));
+    (void) remove(path);
+}
+
+TEST(RequestLog, RoundTrip) {
+    U8 header[MathModule::RequestLog::HEADER_SIZE];
+    MathModule::RequestLog::writeHeader(header, 7);
+    U32 count = 0;
+    ASSERT_TRUE(MathModule::RequestLog::readHeader(header, count));
+    ASSERT_EQ(count, 7U);
+    // the magic is written big-endian
+    ASSERT_EQ(header[0], 0x4D);
+    header[0] = 0;
+    ASSERT_FALSE(MathModule::RequestLog::readHeader(header, count));
+
+    const MathModule::RequestLog::Record in = {12, 345678, 9, 1.5f, -2.25f, 3};
+    U8 bytes[MathModule::RequestLog::RECORD_SIZE];
+    MathModule::RequestLog::writeRecord(bytes, in);
+    MathModule::RequestLog::Record out;
+    MathModule::RequestLog::readRecord(bytes, out);
+    ASSERT_EQ(out.seconds, 12U);
+    ASSERT_EQ(out.useconds, 345678U);
+    ASSERT_EQ(out.requestId, 9U);
+    ASSERT_EQ(out.val1, 1.5f);
+    ASSERT_EQ(out.val2, -2.25f);
+    ASSERT_EQ(out.op, 3);
+}
+
+TEST(RequestRecorder, Record) {
+    const char* const path = "RequestRecorderTest.bin";
+    MathModule::RequestRecorder recorder;
+    ASSERT_FALSE(recorder.isRecording());
+    ASSERT_TRUE(recorder.start(path, 3));
+    ASSERT_TRUE(recorder.isOpen());
+    ASSERT_FALSE(recorder.isRecording());
+    recorder.enable();
+    ASSERT_TRUE(recorder.isRecording());
+    for (U32 i = 0; i < 4; i++) {
+        const MathModule::RequestLog::Record record = {i, 0, i, 1.0f, 2.0f, 0};
+        recorder.record(record);
+    }
+    recorder.disable();
+    ASSERT_TRUE(recorder.stop());
+    ASSERT_FALSE(recorder.isRecording());
+    ASSERT_FALSE(recorder.isOpen());
+    // the log has room for three, so the fourth is dropped
+    ASSERT_EQ(recorder.getRecorded(), 3U);
+    ASSERT_EQ(recorder.getDropped(), 1U);
+
+    MathModule::MappedFile mapped;
+    ASSERT_TRUE(mapped.open(path));
+    ASSERT_GE(mapped.getSize(), static_cast<FwSizeType>(MathModule::RequestLog::HEADER_SIZE +
+                                                       3 * MathModule::RequestLog::RECORD_SIZE));
+    U32 count = 0;
+    ASSERT_TRUE(MathModule::RequestLog::readHeader(mapped.getData(), count));
+    ASSERT_EQ(count, 3U);
+    MathModule::RequestLog::Record record;
+    MathModule::RequestLog::readRecord(
+        mapped.getData() + MathModule::RequestLog::HEADER_SIZE + 2 * MathModule::RequestLog::RECORD_SIZE,
+        record
+    );
+    ASSERT_EQ(record.requestId, 2U);
+    mapped.close();
+    (void) remove(path);
+}
+
+TEST(RequestTracker, ClaimAndComplete) {
+    MathModule::RequestTracker tracker(0x40000000, 0xC0000000);
+    const Fw::Time sent(TB_NONE, 10, 0);
+    const U32 first = tracker.claim(sent);
+    const U32 second = tracker.claim(sent);
+    ASSERT_EQ(first, 0x40000000U);
+    ASSERT_EQ(second, 0x40000001U);
+    ASSERT_TRUE(tracker.owns(first));
+    ASSERT_FALSE(tracker.owns(0x80000000));
+    ASSERT_FALSE(tracker.owns(1));
+    ASSERT_EQ(tracker.getOutstanding(), 2U);
+
+    U32 latencyUs = 0;
+    ASSERT_TRUE(tracker.complete(second, Fw::Time(TB_NONE, 10, 250), latencyUs));
+    ASSERT_EQ(latencyUs, 250U);
+    // a second result, or one never sent, is not matched
+    ASSERT_FALSE(tracker.complete(second, Fw::Time(TB_NONE, 10, 300), latencyUs));
+    ASSERT_FALSE(tracker.complete(0x40000002, Fw::Time(TB_NONE, 10, 300), latencyUs));
+    ASSERT_EQ(tracker.getOutstanding(), 1U);
+}
+
+TEST(RequestTracker, ExpireAndWrap) {
+    MathModule::RequestTracker tracker(0x80000000, 0x80000000);
+    for (U32 i = 0; i < MathModule::RequestTracker::CAPACITY; i++) {
+        (void) tracker.claim(Fw::Time(TB_NONE, 0, i));
+    }
+    ASSERT_TRUE(tracker.isFull());
+
+    // only requests older than the timeout go
+    ASSERT_EQ(tracker.expire(Fw::Time(TB_NONE, 0, 1009), 1000), 10U);
+    ASSERT_FALSE(tracker.isFull());
+    ASSERT_EQ(tracker.getOutstanding(), MathModule::RequestTracker::CAPACITY - 10U);
+
+    // the freed slots take the next sequence numbers
+    const U32 id = tracker.claim(Fw::Time(TB_NONE, 1, 0));
+    ASSERT_EQ(id, 0x80000000U | MathModule::RequestTracker::CAPACITY);
+    U32 latencyUs = 0;
+    ASSERT_FALSE(tracker.complete(0x80000000, Fw::Time(TB_NONE, 1, 0), latencyUs));
+    ASSERT_TRUE(tracker.complete(id, Fw::Time(TB_NONE, 1, 5), latencyUs));
+    ASSERT_EQ(latencyUs, 5U);
+
+    ASSERT_EQ(tracker.abandon(), MathModule::RequestTracker::CAPACITY - 10U);
+    ASSERT_EQ(tracker.getOutstanding(), 0U);
+    ASSERT_EQ(tracker.expire(Fw::Time(TB_NONE, 100, 0), 1000), 0U);
+}
+
+TEST(CountingAllocator, Count) {
+    Fw::MallocAllocator heap;
+    MathModule::CountingAllocator allocator(heap);
+    NATIVE_UINT_TYPE size = 100;
+    bool recoverable = false;
+    void* const first = allocator.allocate(0, size, recoverable);
+    ASSERT_NE(first, nullptr);
+    size = 28;
+    void* const second = allocator.allocate(1, size, recoverable);
+    ASSERT_NE(second, nullptr);
+    ASSERT_EQ(allocator.getAllocatedBytes(), 128U);
+    ASSERT_EQ(allocator.getAllocations(), 2U);
+    // returning memory does not lower the count
+    allocator.deallocate(0, first);
+    allocator.deallocate(1, second);
+    ASSERT_EQ(allocator.getAllocatedBytes(), 128U);
+}
+
+TEST(StartupProfile, Nesting) {
+    MathModule::StartupProfile profile;
+    profile.begin("setup", 0);
+    profile.begin("init", 0);
+    profile.end(10);
+    profile.begin("configure", 10);
+    profile.begin("buffers", 15);
+    profile.end(115);
+    profile.end(120);
+    profile.end(120);
+
+    // phases keep the order they began in, and parents include their children
+    ASSERT_EQ(profile.getCount(), 4U);
+    ASSERT_STREQ(profile.getPhase(0).name, "setup");
+    ASSERT_EQ(profile.getPhase(0).depth, 0U);
+    ASSERT_EQ(profile.getPhase(0).allocatedBytes, 120U);
+    ASSERT_EQ(profile.getPhase(1).depth, 1U);
+    ASSERT_EQ(profile.getPhase(1).allocatedBytes, 10U);
+    ASSERT_STREQ(profile.getPhase(2).name, "configure");
+    ASSERT_EQ(profile.getPhase(2).allocatedBytes, 110U);
+    ASSERT_EQ(profile.getPhase(3).depth, 2U);
+    ASSERT_EQ(profile.getPhase(3).allocatedBytes, 100U);
+    ASSERT_GE(profile.getPhase(0).wallUs, profile.getPhase(2).wallUs);
+}
+
+TEST(StartupProfile, Json) {
+    MathModule::StartupProfile profile;
+    char json[MathModule::StartupProfile::JSON_SIZE];
+    ASSERT_EQ(profile.formatJson(json, sizeof(json)), strlen("{\"phases\": [\n]}\n"));
+    ASSERT_STREQ(json, "{\"phases\": [\n]}\n");
+
+    profile.begin("init", 0);
+    profile.end(64);
+    profile.begin("start", 64);
+    profile.end(64);
+    const FwSizeType length = profile.formatJson(json, sizeof(json));
+    ASSERT_EQ(length, strlen(json));
+    ASSERT_NE(strstr(json, "{\"name\": \"init\", \"depth\": 0, \"wall_us\": "), nullptr);
+    ASSERT_NE(strstr(json, "\"allocated_bytes\": 64},\n"), nullptr);
+    ASSERT_NE(strstr(json, "\"allocated_bytes\": 0}\n]}\n"), nullptr);
+    // a buffer too small for the whole object gets nothing
+    ASSERT_EQ(profile.formatJson(json, length), 0U);
+    ASSERT_STREQ(json, "");
+
+    const char* const path = "StartupProfileTest.json";
+    ASSERT_TRUE(profile.writeJson(path));
+    FILE* const file = fopen(path, "rb");
+    ASSERT_NE(file, nullptr);
+    char read[MathModule::StartupProfile::JSON_SIZE] = {};
+    ASSERT_EQ(fread(read, 1, sizeof(read) - 1, file), static_cast<size_t>(length));
+    (void) fclose(file);
+    ASSERT_NE(strstr(read, "\"name\": \"start\""), nullptr);
+    (void) remove(path);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
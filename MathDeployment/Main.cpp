@@ -22,7 +22,9 @@
  * @param app: name of application
  */
 void print_usage(const char* app) {
-    (void)printf("Usage: ./%s [options]\n-a\thostname/IP address\n-p\tport_number\n", app);
+    (void)printf("Usage: ./%s [options]\n-a\thostname/IP address\n-p\tport_number\n"
+                 "-c\tcycle period in microseconds, dividing 1000000 (default 1000000)\n"
+                 "-j\tfile to write the startup profile to as JSON\n", app);
 }
 
 /**
@@ -49,11 +51,13 @@ static void signalHandler(int signum) {
  */
 int main(int argc, char* argv[]) {
     U32 port_number = 0;
+    U32 cycle_us = 1000000;
     I32 option = 0;
     char* hostname = nullptr;
+    char* profile_path = nullptr;
     Os::Console::init();
     // Loop while reading the getopt supplied options
-    while ((option = getopt(argc, argv, "hp:a:")) != -1) {
+    while ((option = getopt(argc, argv, "hp:a:c:j:")) != -1) {
         switch (option) {
             // Handle the -a argument for address/hostname
             case 'a':
@@ -63,6 +67,19 @@ int main(int argc, char* argv[]) {
             case 'p':
                 port_number = static_cast<U32>(atoi(optarg));
                 break;
+            // Handle the -c cycle period argument
+            case 'c':
+                cycle_us = static_cast<U32>(strtoul(optarg, nullptr, 0));
+                // The rate group driver keeps its 1Hz cycle only if whole ticks make up a second
+                if ((cycle_us == 0) || ((1000000 % cycle_us) != 0)) {
+                    print_usage(argv[0]);
+                    return 1;
+                }
+                break;
+            // Handle the -j startup profile argument
+            case 'j':
+                profile_path = optarg;
+                break;
             // Cascade intended: help output
             case 'h':
             // Cascade intended: help output
@@ -77,6 +94,7 @@ int main(int argc, char* argv[]) {
     MathDeployment::TopologyState inputs;
     inputs.hostname = hostname;
     inputs.port = port_number;
+    inputs.startupProfilePath = profile_path;
 
     // Setup program shutdown via Ctrl-C
     signal(SIGINT, signalHandler);
@@ -85,7 +103,7 @@ int main(int argc, char* argv[]) {
 
     // Setup, cycle, and teardown topology
     MathDeployment::setupTopology(inputs);
-    MathDeployment::startSimulatedCycle(1000);  // Program loop cycling rate groups at 1Hz
+    MathDeployment::startSimulatedCycle(cycle_us);  // Program loop cycling the math rate group every cycle_us
     MathDeployment::teardownTopology(inputs);
     (void)printf("Exiting...\n");
     return 0;
@@ -0,0 +1,190 @@
+// ======================================================================
+// \title  HeapCounter.cpp
+// \brief  cpp file for the count of bytes allocated with the global operator new
+// ======================================================================
+
+#include <MathDeployment/Top/HeapCounter.hpp>
+#include <Fw/Types/Assert.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+  // Constant initialized, so they are ready for allocations made before main
+  std::atomic<U32> enables(0);
+  std::atomic<U64> allocatedBytes(0);
+
+  //! Count an allocation while enabled
+  void count(std::size_t size) {
+    if (enables.load(std::memory_order_relaxed) > 0) {
+        allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+  }
+
+  //! Allocate from the C heap, or return nullptr
+  void* allocate(std::size_t size) {
+    // A zero-byte request must still return a unique pointer
+    void* const ptr = std::malloc((size > 0) ? size : 1);
+    if (ptr != nullptr) {
+        count(size);
+    }
+    return ptr;
+  }
+
+  //! Allocate as the throwing operator new does: retry through the new handler, then throw
+  void* allocateOrThrow(std::size_t size) {
+    for (;;) {
+        void* const ptr = allocate(size);
+        if (ptr != nullptr) {
+            return ptr;
+        }
+        const std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+  }
+
+#if defined(__cpp_aligned_new)
+  //! Allocate from the C heap with an alignment, or return nullptr
+  void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    // aligned_alloc takes a multiple of the alignment
+    const std::size_t rounded = (((size > 0) ? size : 1) + align - 1) / align * align;
+    void* const ptr = std::aligned_alloc(align, rounded);
+    if (ptr != nullptr) {
+        count(size);
+    }
+    return ptr;
+  }
+
+  //! Allocate with an alignment as the throwing operator new does
+  void* allocateAlignedOrThrow(std::size_t size, std::align_val_t alignment) {
+    for (;;) {
+        void* const ptr = allocateAligned(size, alignment);
+        if (ptr != nullptr) {
+            return ptr;
+        }
+        const std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+  }
+#endif
+
+}
+
+namespace MathDeployment {
+
+  void HeapCounter ::
+    enable()
+  {
+    enables.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void HeapCounter ::
+    disable()
+  {
+    const U32 previous = enables.fetch_sub(1, std::memory_order_relaxed);
+    FW_ASSERT(previous > 0);
+  }
+
+  U64 HeapCounter ::
+    getAllocatedBytes()
+  {
+    return allocatedBytes.load(std::memory_order_relaxed);
+  }
+
+} // end namespace MathDeployment
+
+// ----------------------------------------------------------------------
+// Replacements of the global operator new and delete
+// ----------------------------------------------------------------------
+
+void* operator new(std::size_t size) {
+    return allocateOrThrow(size);
+}
+
+void* operator new[](std::size_t size) {
+    return allocateOrThrow(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+#if defined(__cpp_sized_deallocation)
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+#endif
+
+#if defined(__cpp_aligned_new)
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return allocateAlignedOrThrow(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocateAlignedOrThrow(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+#endif
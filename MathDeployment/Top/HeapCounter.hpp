@@ -0,0 +1,40 @@
+// ======================================================================
+// \title  HeapCounter.hpp
+// \brief  hpp file for the count of bytes allocated with the global operator new
+// ======================================================================
+
+#ifndef MATHDEPLOYMENT_HEAPCOUNTER_HPP
+#define MATHDEPLOYMENT_HEAPCOUNTER_HPP
+
+#include <FpConfig.hpp>
+
+namespace MathDeployment {
+
+  //! Count of the bytes allocated with the global operator new while enabled
+  //!
+  //! HeapCounter.cpp replaces the global operator new and delete of the
+  //! deployment, so memory the framework allocates for itself during startup,
+  //! such as component queues, is counted too. It is built into the deployment
+  //! only. Counting costs an atomic add per allocation, and only while enabled.
+  //! Thread safe.
+  class HeapCounter {
+
+    public:
+
+      //! Start counting; calls nest, and counting goes on until each is matched by disable
+      static void enable();
+
+      //! Stop counting once every enable has been matched
+      static void disable();
+
+      //! Bytes allocated with operator new while counting
+      //!
+      //! The count only grows, so the difference between two readings is what was
+      //! allocated in between.
+      static U64 getAllocatedBytes();
+
+  };
+
+} // end namespace MathDeployment
+
+#endif
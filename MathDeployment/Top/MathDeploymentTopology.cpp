@@ -8,18 +8,22 @@
 #include <MathDeployment/Top/MathDeploymentPacketsAc.hpp>
 
 // Necessary project-specified types
+#include <Components/MathUtils/CountingAllocator.hpp>
+#include <Components/MathUtils/StartupProfile.hpp>
+#include <MathDeployment/Top/HeapCounter.hpp>
 #include <Fw/Types/MallocAllocator.hpp>
 #include <Svc/FramingProtocol/FprimeProtocol.hpp>
 
-// Used for 1Hz synthetic cycling
-#include <Os/Mutex.hpp>
-
 // Allows easy reference to objects in FPP/autocoder required namespaces
 using namespace MathDeployment;
 
 // The reference topology uses a malloc-based allocator for components that need to allocate memory during the
-// initialization phase.
-Fw::MallocAllocator mallocator;
+// initialization phase. Its allocations are counted so the startup profile can report them.
+Fw::MallocAllocator heapAllocator;
+MathModule::CountingAllocator mallocator(heapAllocator);
+
+// Wall time and allocated bytes of each setupTopology phase, reported by mathStartup once startup is done
+MathModule::StartupProfile startupProfile;
 
 // The reference topology uses the F´ packet protocol when communicating with the ground and therefore uses the F´
 // framing and deframing implementations.
@@ -31,11 +35,16 @@ Svc::ComQueue::QueueConfigurationTable configurationTable;
 // The reference topology divides the incoming clock signal (1Hz) into sub-signals: 1Hz, 1/2Hz, and 1/4Hz
 Svc::RateGroupDriver::DividerSet rateGroupDivisors = {{{1, 0}, {2, 0}, {4, 0}}};
 
+// MathReceiver instances behind the math router. Each drains its queue from its own dispatch task, as configureTopology
+// makes EVENT_DRIVEN their default DISPATCH_MODE, which spreads the math load across cores.
+MathModule::MathReceiver* const mathWorkers[] = {&mathReceiver, &mathReceiver1, &mathReceiver2, &mathReceiver3};
+
 // Rate groups may supply a context token to each of the attached children whose purpose is set by the project. The
 // reference topology sets each token to zero as these contexts are unused in this project.
 NATIVE_INT_TYPE rateGroup1Context[Svc::ActiveRateGroup::CONNECTION_COUNT_MAX] = {};
 NATIVE_INT_TYPE rateGroup2Context[Svc::ActiveRateGroup::CONNECTION_COUNT_MAX] = {};
 NATIVE_INT_TYPE rateGroup3Context[Svc::ActiveRateGroup::CONNECTION_COUNT_MAX] = {};
+NATIVE_INT_TYPE rateGroupMathContext[Svc::ActiveRateGroup::CONNECTION_COUNT_MAX] = {};
 
 // A number of constants are needed for construction of the topology. These are specified here.
 enum TopologyConstants {
@@ -46,6 +55,8 @@ enum TopologyConstants {
     FILE_DOWNLINK_FILE_QUEUE_DEPTH = 10,
     HEALTH_WATCHDOG_CODE = 0x123,
     COMM_PRIORITY = 100,
+    MATH_DISPATCH_PRIORITY = 110,
+    MATH_MEMO_ENTRIES = 256,
     // bufferManager constants
     FRAMER_BUFFER_SIZE = FW_MAX(FW_COM_BUFFER_MAX_SIZE, FW_FILE_BUFFER_MAX_SIZE + sizeof(U32)) + HASH_DIGEST_LENGTH + Svc::FpFrameHeader::SIZE,
     FRAMER_BUFFER_COUNT = 30,
@@ -53,7 +64,10 @@ enum TopologyConstants {
     DEFRAMER_BUFFER_COUNT = 30,
     COM_DRIVER_BUFFER_SIZE = 3000,
     COM_DRIVER_BUFFER_COUNT = 30,
-    BUFFER_MANAGER_ID = 200
+    RESULT_STREAM_BUFFER_SIZE = MathModule::MathSender::STREAM_BUFFER_SIZE,
+    RESULT_STREAM_BUFFER_COUNT = 20,
+    BUFFER_MANAGER_ID = 200,
+    STREAM_BUFFER_MANAGER_ID = 201
 };
 
 // Ping entries are autocoded, however; this code is not properly exported. Thus, it is copied here.
@@ -70,8 +84,26 @@ Svc::Health::PingEntry pingEntries[] = {
     {PingEntries::MathDeployment_rateGroup1::WARN, PingEntries::MathDeployment_rateGroup1::FATAL, "rateGroup1"},
     {PingEntries::MathDeployment_rateGroup2::WARN, PingEntries::MathDeployment_rateGroup2::FATAL, "rateGroup2"},
     {PingEntries::MathDeployment_rateGroup3::WARN, PingEntries::MathDeployment_rateGroup3::FATAL, "rateGroup3"},
+    {PingEntries::MathDeployment_rateGroupMath::WARN, PingEntries::MathDeployment_rateGroupMath::FATAL, "rateGroupMath"},
 };
 
+//! Bytes allocated so far by the topology allocator, and with operator new while a phase is open
+U64 allocatedBytes() {
+    return mallocator.getAllocatedBytes() + HeapCounter::getAllocatedBytes();
+}
+
+//! Start timing a startup phase, counting what the framework allocates for itself until it ends
+void beginPhase(const char* name) {
+    HeapCounter::enable();
+    startupProfile.begin(name, allocatedBytes());
+}
+
+//! Stop timing the innermost startup phase
+void endPhase() {
+    startupProfile.end(allocatedBytes());
+    HeapCounter::disable();
+}
+
 /**
  * \brief configure/setup components in project-specific way
  *
@@ -90,6 +122,7 @@ void configureTopology() {
     rateGroup1.configure(rateGroup1Context, FW_NUM_ARRAY_ELEMENTS(rateGroup1Context));
     rateGroup2.configure(rateGroup2Context, FW_NUM_ARRAY_ELEMENTS(rateGroup2Context));
     rateGroup3.configure(rateGroup3Context, FW_NUM_ARRAY_ELEMENTS(rateGroup3Context));
+    rateGroupMath.configure(rateGroupMathContext, FW_NUM_ARRAY_ELEMENTS(rateGroupMathContext));
 
     // File downlink requires some project-derived properties.
     fileDownlink.configure(FILE_DOWNLINK_TIMEOUT, FILE_DOWNLINK_COOLDOWN, FILE_DOWNLINK_CYCLE_TIME,
@@ -97,7 +130,9 @@ void configureTopology() {
 
     // Parameter database is configured with a database file name, and that file must be initially read.
     prmDb.configure("PrmDb.dat");
+    beginPhase("prmDb.readParamFile");
     prmDb.readParamFile();
+    endPhase();
 
     // Health is supplied a set of ping entires.
     health.setPingEntries(pingEntries, FW_NUM_ARRAY_ELEMENTS(pingEntries), HEALTH_WATCHDOG_CODE);
@@ -111,7 +146,18 @@ void configureTopology() {
     upBuffMgrBins.bins[1].numBuffers = DEFRAMER_BUFFER_COUNT;
     upBuffMgrBins.bins[2].bufferSize = COM_DRIVER_BUFFER_SIZE;
     upBuffMgrBins.bins[2].numBuffers = COM_DRIVER_BUFFER_COUNT;
+    beginPhase("bufferManager.setup");
     bufferManager.setup(BUFFER_MANAGER_ID, 0, mallocator, upBuffMgrBins);
+    endPhase();
+
+    // The result stream draws from a manager of its own, so it can never take a framer or deframer buffer, and the
+    // stream downlink knows its buffers by that manager's ID
+    Svc::BufferManager::BufferBins streamBuffMgrBins;
+    memset(&streamBuffMgrBins, 0, sizeof(streamBuffMgrBins));
+    streamBuffMgrBins.bins[0].bufferSize = RESULT_STREAM_BUFFER_SIZE;
+    streamBuffMgrBins.bins[0].numBuffers = RESULT_STREAM_BUFFER_COUNT;
+    streamBufferManager.setup(STREAM_BUFFER_MANAGER_ID, 0, mallocator, streamBuffMgrBins);
+    mathStreamDownlink.setup(STREAM_BUFFER_MANAGER_ID);
 
     // Framer and Deframer components need to be passed a protocol handler
     framer.setup(framing);
@@ -126,63 +172,87 @@ void configureTopology() {
     configurationTable.entries[1] = {.depth = 500, .priority = 2};
     // File Downlink
     configurationTable.entries[2] = {.depth = 100, .priority = 1};
+    // mathSender result stream, below telemetry so a busy stream cannot hold it back
+    configurationTable.entries[3] = {.depth = 20, .priority = 3};
     // Allocation identifier is 0 as the MallocAllocator discards it
     comQueue.configure(configurationTable, 0, mallocator);
+
+    // MathReceiver workers answer repeated requests from a memo cache allocated here, never at runtime. They run
+    // event-driven unless the parameter database says otherwise, so the router spreads requests across threads.
+    for (FwSizeType i = 0; i < FW_NUM_ARRAY_ELEMENTS(mathWorkers); i++) {
+        mathWorkers[i]->allocateMemo(0, mallocator, MATH_MEMO_ENTRIES);
+        mathWorkers[i]->setDefaultDispatchMode(MathModule::DispatchMode::EVENT_DRIVEN);
+    }
 }
 
 // Public functions for use in main program are namespaced with deployment name MathDeployment
 namespace MathDeployment {
 void setupTopology(const TopologyState& state) {
+    // Each phase is timed so mathStartup can report where startup time goes
+    beginPhase("setupTopology");
     // Autocoded initialization. Function provided by autocoder.
+    beginPhase("initComponents");
     initComponents(state);
+    endPhase();
     // Autocoded id setup. Function provided by autocoder.
+    beginPhase("setBaseIds");
     setBaseIds();
+    endPhase();
     // Autocoded connection wiring. Function provided by autocoder.
+    beginPhase("connectComponents");
     connectComponents();
+    endPhase();
     // Autocoded command registration. Function provided by autocoder.
+    beginPhase("regCommands");
     regCommands();
+    endPhase();
     // Project-specific component configuration. Function provided above. May be inlined, if desired.
+    beginPhase("configureTopology");
     configureTopology();
+    endPhase();
     // Autocoded parameter loading. Function provided by autocoder.
+    beginPhase("loadParameters");
     loadParameters();
+    endPhase();
     // Autocoded task kick-off (active components). Function provided by autocoder.
+    beginPhase("startTasks");
     startTasks(state);
+    endPhase();
+    // MathReceiver workers drain their queues from these tasks unless DISPATCH_MODE is set to RATE_GROUP
+    beginPhase("startDispatchTasks");
+    for (FwSizeType i = 0; i < FW_NUM_ARRAY_ELEMENTS(mathWorkers); i++) {
+        mathWorkers[i]->startDispatchTask(MATH_DISPATCH_PRIORITY, Default::STACK_SIZE);
+    }
+    endPhase();
     // Initialize socket client communication if and only if there is a valid specification
     if (state.hostname != nullptr && state.port != 0) {
+        beginPhase("comDriver.start");
         Os::TaskString name("ReceiveTask");
         // Uplink is configured for receive so a socket task is started
         comDriver.configure(state.hostname, state.port);
         comDriver.start(name, true, COMM_PRIORITY, Default::STACK_SIZE);
+        endPhase();
     }
+    endPhase();
+    // The event logger is running now, so the phases can be reported
+    mathStartup.publish(startupProfile, state.startupProfilePath);
 }
 
-// Variables used for cycle simulation
-Os::Mutex cycleLock;
-volatile bool cycleFlag = true;
-
-void startSimulatedCycle(U32 milliseconds) {
-    cycleLock.lock();
-    bool cycling = cycleFlag;
-    cycleLock.unLock();
-
-    // Main loop
-    while (cycling) {
-        MathDeployment::blockDrv.callIsr();
-        Os::Task::delay(Fw::TimeInterval(milliseconds/1000, milliseconds % 1000));
-
-        cycleLock.lock();
-        cycling = cycleFlag;
-        cycleLock.unLock();
-    }
+void startSimulatedCycle(U32 periodUs) {
+    // Main loop, until stopSimulatedCycle
+    mathCycle.run(periodUs);
 }
 
 void stopSimulatedCycle() {
-    cycleLock.lock();
-    cycleFlag = false;
-    cycleLock.unLock();
+    mathCycle.stop();
 }
 
 void teardownTopology(const TopologyState& state) {
+    // The dispatch tasks drain once more as they stop, so they go while the result consumers still run
+    for (FwSizeType i = 0; i < FW_NUM_ARRAY_ELEMENTS(mathWorkers); i++) {
+        mathWorkers[i]->stopDispatchTask();
+    }
+
     // Autocoded (active component) task clean-up. Functions provided by topology autocoder.
     stopTasks(state);
     freeThreads(state);
@@ -194,5 +264,9 @@ void teardownTopology(const TopologyState& state) {
     // Resource deallocation
     cmdSeq.deallocateBuffer(mallocator);
     bufferManager.cleanup();
+    streamBufferManager.cleanup();
+    for (FwSizeType i = 0; i < FW_NUM_ARRAY_ELEMENTS(mathWorkers); i++) {
+        mathWorkers[i]->deallocateMemo(mallocator);
+    }
 }
 };  // namespace MathDeployment
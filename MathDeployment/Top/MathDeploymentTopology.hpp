@@ -31,10 +31,13 @@ namespace MathDeployment {
  * inserted between step 3 and 5. Step 7 may come before or after the active component initializations. Since these
  * custom tasks often start radio communication it is convenient to start them last.
  *
+ * Each step is timed, along with the bytes it allocates, and the mathStartup component reports the timings as events
+ * once the tasks are running. When the state names a startup profile file the timings are also written there as JSON.
+ *
  * The state argument carries command line inputs used to setup the topology. For an explanation of the required type
  * MathDeployment::TopologyState see: MathDeploymentTopologyDefs.hpp.
  *
- * \param state: object shuttling CLI arguments (hostname, port) needed to construct the topology
+ * \param state: object shuttling CLI arguments (hostname, port, startup profile file) needed to construct the topology
  */
 void setupTopology(const TopologyState& state);
 
@@ -60,20 +63,20 @@ void setupTopology(const TopologyState& state);
 void teardownTopology(const TopologyState& state);
 
 /**
- * \brief cycle the rate group driver at a crude rate
+ * \brief cycle the rate groups from the calling thread
  *
  * The reference topology does not have a true 1Hz input clock for the rate group driver because it is designed to
  * operate across various computing endpoints (e.g. laptops) where a clear 1Hz source may not be easily and generically
- * achieved. This function mimics the cycling via a Task::delay(milliseconds) loop that manually invokes the ISR call
- * to the example block driver.
- *
- * This loop is stopped via a startSimulatedCycle call.
+ * achieved. This function runs the mathCycle driver on the calling thread instead. It ticks against absolute deadlines
+ * of the monotonic clock, so no error builds up from cycle to cycle. Every tick cycles the math rate group, and every
+ * 1000000 / periodUs ticks cycle the rate group driver, which keeps its 1Hz cycle. The period must therefore divide
+ * 1000000.
  *
- * Note: projects should replace this with a component that produces an output port call at the appropriate frequency.
+ * This loop is stopped via a stopSimulatedCycle call.
  *
- * \param milliseconds: milliseconds to delay for each cycle. Default: 1000 or 1Hz.
+ * \param periodUs: microseconds between ticks. Default: 1000000 or 1Hz.
  */
-void startSimulatedCycle(U32 milliseconds = 1000);
+void startSimulatedCycle(U32 periodUs = 1000000);
 
 /**
  * \brief stop the simulated cycle started by startSimulatedCycle
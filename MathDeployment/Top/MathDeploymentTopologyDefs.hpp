@@ -21,11 +21,12 @@ namespace MathDeployment {
  * The topology autocoder requires an object that carries state with the name `MathDeployment::TopologyState`. Only the type
  * definition is required by the autocoder and the contents of this object are otherwise opaque to the autocoder. The
  * contents are entirely up to the definition of the project. This reference application specifies hostname and port
- * fields, which are derived by command line inputs.
+ * fields, which are derived by command line inputs, and the file the startup profile is written to as JSON, or null.
  */
 struct TopologyState {
     const char* hostname;
     U32 port;
+    const char* startupProfilePath;
 };
 
 /**
@@ -84,6 +85,9 @@ enum { WARN = 3, FATAL = 5 };
 namespace MathDeployment_rateGroup3 {
 enum { WARN = 3, FATAL = 5 };
 }
+namespace MathDeployment_rateGroupMath {
+enum { WARN = 3, FATAL = 5 };
+}
 }  // namespace PingEntries
 }  // namespace MathDeployment
 #endif